@@ -0,0 +1,58 @@
+#include "BNO055.h"
+#include "BNO055FastRead.h"
+
+#define READY_PIN 2
+
+BNO055 bnoSensor;
+BNO055FastRead quaternionRead(bnoSensor, QUA_W_LSB, 4);
+
+int16_t quaternion[4];
+uint32_t lastReport;
+
+// data-ready or sync signal, e.g. the interrupt pin or an external trigger
+void onReady() {
+  quaternionRead.markReady();
+}
+
+void setup() {
+  Serial.begin(115200);
+  Wire.setClock(400000);
+
+  if(!bnoSensor.begin()) {
+    Serial.println("BNO055 cannot initialized!");
+    while(1);
+  }
+  bnoSensor.setOperationMode(OPERATION_MODE_NDOF);
+
+  quaternionRead.prepare();
+  quaternionRead.setBinWidth(16);
+  attachInterrupt(digitalPinToInterrupt(READY_PIN), onReady, RISING);
+  lastReport = millis();
+}
+
+void loop() {
+  quaternionRead.readMeasured(quaternion);
+  // ... compute and send the actuator command here ...
+
+  if(millis() - lastReport >= 5000) {
+    latencyStats stats;
+    quaternionRead.getLatency(&stats);
+    Serial.print("reads: ");
+    Serial.print(stats.samples);
+    Serial.print("  transfer p50/p99/max: ");
+    Serial.print(stats.transferP50);
+    Serial.print("/");
+    Serial.print(stats.transferP99);
+    Serial.print("/");
+    Serial.print(stats.transferMax);
+    Serial.print(" us  latency p50/p99/max: ");
+    Serial.print(stats.latencyP50);
+    Serial.print("/");
+    Serial.print(stats.latencyP99);
+    Serial.print("/");
+    Serial.print(stats.latencyMax);
+    Serial.println(" us");
+    quaternionRead.resetLatency();
+    lastReport = millis();
+  }
+}
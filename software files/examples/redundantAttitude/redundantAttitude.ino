@@ -0,0 +1,60 @@
+#include "BNO055.h"
+#include "BNO055MultiFusion.h"
+
+// Two sensors on one bus (COM3 high on the second one selects 0x29). A third sensor needs
+// a second bus, e.g. BNO055 third(0x28, Wire1), and turns disagreement detection into
+// fault exclusion.
+#define SENSORS 2
+
+BNO055 first(0x28);
+BNO055 second(0x29);
+BNO055* sensors[SENSORS] = { &first, &second };
+
+BNO055MultiFusion fusion;
+imuSnapshot snapshots[SENSORS];
+sensorHealth health[SENSORS];
+fusedAttitude attitude;
+
+void setup() {
+  Serial.begin(115200);
+
+  for (uint8_t i = 0; i < SENSORS; i++) {
+    if(!sensors[i]->begin()) {
+      Serial.print("BNO055 ");
+      Serial.print(i);
+      Serial.println(" cannot initialized!");
+      while(1);
+    }
+    sensors[i]->setOperationMode(OPERATION_MODE_NDOF);
+  }
+
+  // the second sensor is mounted upside down on the rig
+  fusion.setMounting(1, BNO055Remap::AxisRemap(AXIS_PLACEMENT_P6));
+}
+
+void loop() {
+  for (uint8_t i = 0; i < SENSORS; i++) {
+    if(!sensors[i]->readSnapshot(snapshots[i], health[i])) {
+      // a zero quaternion is dropped by the fusion for this update
+      memset(&snapshots[i], 0, sizeof(imuSnapshot));
+    }
+  }
+
+  if(fusion.update(snapshots, health, SENSORS, attitude)) {
+    Serial.print(attitude.qua[0], 4);
+    Serial.print("  ");
+    Serial.print(attitude.qua[1], 4);
+    Serial.print("  ");
+    Serial.print(attitude.qua[2], 4);
+    Serial.print("  ");
+    Serial.print(attitude.qua[3], 4);
+    Serial.print("  spread: ");
+    Serial.println(attitude.spread);
+  }
+  else {
+    Serial.print("no trustworthy attitude, excluded: ");
+    Serial.print(attitude.excluded, BIN);
+    Serial.println(attitude.disagree ? " (sensors disagree)" : "");
+  }
+  delay(10);
+}
@@ -0,0 +1,52 @@
+#include "BNO055.h"
+
+// Dumps all registers at start-up, then prints once a second the configuration fields
+// that differ from that dump, by name. Send 'd' for a full dump to compare with
+// extras/tools/register_diff, 'r' to restore the start-up configuration. A dump printed
+// by one unit and parsed into a registerImage clones its configuration onto another.
+#define MAX_CHANGES 8
+
+BNO055 bnoSensor;
+registerImage reference;
+registerImage current;
+
+void setup() {
+  Serial.begin(115200);
+
+  if(!bnoSensor.begin()) {
+    Serial.println("BNO055 cannot initialized!");
+    while(1);
+  }
+  bnoSensor.setOperationMode(OPERATION_MODE_NDOF);
+  bnoSensor.waitModeReady();
+
+  bnoSensor.dumpRegisters(&reference);
+  BNO055::printRegisterImage(&reference, Serial);
+}
+
+void loop() {
+  if(Serial.available()) {
+    char command = Serial.read();
+    if(command == 'd') {
+      bnoSensor.dumpRegisters(&current);
+      BNO055::printRegisterImage(&current, Serial);
+    }
+    else if(command == 'r') {
+      Serial.println(bnoSensor.restoreRegisters(&reference) ? "restored" : "restore failed");
+    }
+  }
+
+  bnoSensor.dumpRegisters(&current);
+  registerChange changes[MAX_CHANGES];
+  uint8_t count = BNO055RegisterMap::diff(&reference, &current, changes, MAX_CHANGES);
+  for (uint8_t i = 0; i < count && i < MAX_CHANGES; i++) {
+    registerField field;
+    BNO055RegisterMap::getField(changes[i].field, &field);
+    Serial.print(field.name);
+    Serial.print(": ");
+    Serial.print(changes[i].before);
+    Serial.print(" -> ");
+    Serial.println(changes[i].after);
+  }
+  delay(1000);
+}
@@ -0,0 +1,61 @@
+#include "BNO055.h"
+#include "BNO055Scheduler.h"
+
+BNO055 bnoSensor;
+BNO055Scheduler scheduler;
+
+imuSnapshot snapshot;
+int8_t readTask;
+uint32_t readErrors = 0;
+
+// 100 Hz: one burst read of all channels; a failed read keeps the last snapshot
+void readSensor(void* context) {
+  if(!((BNO055*)context)->readSnapshot(snapshot)) {
+    readErrors++;
+  }
+}
+
+// 10 Hz: print the orientation
+void printOrientation(void* context) {
+  Serial.print(snapshot.eul[0]);
+  Serial.print("  ");
+  Serial.print(snapshot.eul[1]);
+  Serial.print("  ");
+  Serial.println(snapshot.eul[2]);
+}
+
+// every 5 s: report the achieved timing of the read task
+void printStats(void* context) {
+  taskStats stats;
+  scheduler.getStats(readTask, &stats);
+  Serial.print("runs: ");
+  Serial.print(stats.runs);
+  Serial.print("  overruns: ");
+  Serial.print(stats.overruns);
+  Serial.print("  max run time: ");
+  Serial.print(stats.maxRunTime);
+  Serial.print(" us  max lateness: ");
+  Serial.print(stats.maxLateness);
+  Serial.print(" us  read errors: ");
+  Serial.println(readErrors);
+  readErrors = 0;
+  scheduler.resetStats();
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  if(!bnoSensor.begin()) {
+    Serial.println("BNO055 cannot initialized!");
+    while(1);
+  }
+  bnoSensor.setOperationMode(OPERATION_MODE_NDOF);
+
+  readTask = scheduler.addTask(readSensor, &bnoSensor, 10000);
+  scheduler.addTask(printOrientation, NULL, 100000, 5000);
+  scheduler.addTask(printStats, NULL, 5000000);
+}
+
+void loop() {
+  scheduler.run();
+}
@@ -0,0 +1,68 @@
+#include "BNO055.h"
+#include "BNO055SyncCapture.h"
+
+// Samples two sensors together at 100 Hz. The quaternions of both are read back to back
+// first, the rest of the snapshots afterwards; the skew printed for each sensor is its
+// sampling time relative to the common reference. trigger() may also be called from a
+// timer interrupt, poll() then runs the capture in the loop.
+#define SENSORS 2
+#define PERIOD 10000
+
+BNO055 first(0x28);
+BNO055 second(0x29);
+BNO055* sensors[SENSORS] = { &first, &second };
+
+bool readSensor(void* context, uint8_t reg, uint8_t* buffer, uint8_t length) {
+  return ((BNO055*)context)->readBytes(reg, buffer, length);
+}
+
+uint32_t clockMicros() {
+  return micros();
+}
+
+BNO055SyncCapture capture(clockMicros);
+uint32_t next = 0;
+uint8_t captures = 0;
+
+void setup() {
+  Serial.begin(115200);
+
+  for (uint8_t i = 0; i < SENSORS; i++) {
+    if(!sensors[i]->begin()) {
+      Serial.print("BNO055 ");
+      Serial.print(i);
+      Serial.println(" cannot initialized!");
+      while(1);
+    }
+    sensors[i]->setOperationMode(OPERATION_MODE_NDOF);
+    capture.addSensor(readSensor, sensors[i]);
+  }
+  next = micros();
+}
+
+void loop() {
+  if((int32_t)(micros() - next) >= 0) {
+    next += PERIOD;
+    capture.trigger();
+  }
+  if(!capture.poll() || ++captures < 100) {
+    return;
+  }
+  captures = 0;
+
+  for (uint8_t i = 0; i < SENSORS; i++) {
+    Serial.print("qua w: ");
+    Serial.print(capture.getSnapshot(i).qua[0], 4);
+    Serial.print("  skew: ");
+    Serial.print(capture.getSkew(i));
+    Serial.print(" us  ");
+  }
+  syncStats stats;
+  capture.getStats(&stats);
+  Serial.print("spread mean: ");
+  Serial.print(stats.meanSpread);
+  Serial.print(" max: ");
+  Serial.print(stats.maxSpread);
+  Serial.print(" us  latency max: ");
+  Serial.println(stats.maxLatency);
+}
@@ -0,0 +1,48 @@
+#include "BNO055.h"
+#include "BNO055WindowStats.h"
+
+// 1 s windows at 20 Hz, about 1.1 kB of RAM for both: the RMS of the linear acceleration
+// is the vibration level, the variance of the gyro vector tells whether the sensor is at rest.
+const uint8_t liaChannels[3] = { CHANNEL_LIA_X, CHANNEL_LIA_Y, CHANNEL_LIA_Z };
+const uint8_t gyrChannels[3] = { CHANNEL_GYR_X, CHANNEL_GYR_Y, CHANNEL_GYR_Z };
+
+BNO055 bnoSensor;
+BNO055WindowStats<3, 20> vibration(liaChannels);
+BNO055WindowStats<3, 20> rotation(gyrChannels);
+imuSnapshot snapshot;
+uint8_t samples = 0;
+
+void setup() {
+  Serial.begin(115200);
+
+  if(!bnoSensor.begin()) {
+    Serial.println("BNO055 cannot initialized!");
+    while(1);
+  }
+  bnoSensor.setOperationMode(OPERATION_MODE_NDOF);
+}
+
+void loop() {
+  if(!bnoSensor.readSnapshot(snapshot)) {
+    delay(50);
+    return;
+  }
+  vibration.update(snapshot);
+  rotation.update(snapshot);
+
+  if(++samples == 20 && vibration.isFull()) {
+    samples = 0;
+    windowStats x;
+    vibration.getWindow(0, &x);
+    Serial.print("vibration rms: ");
+    Serial.print(vibration.getRms(0));
+    Serial.print("  ");
+    Serial.print(vibration.getRms(1));
+    Serial.print("  ");
+    Serial.print(vibration.getRms(2));
+    Serial.print("  x peak-to-peak: ");
+    Serial.print(x.max - x.min);
+    Serial.println(rotation.getTotalVariance() < 0.1f ? "  (at rest)" : "");
+  }
+  delay(50);
+}
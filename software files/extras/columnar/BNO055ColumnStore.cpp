@@ -0,0 +1,462 @@
+#include "BNO055ColumnStore.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define STORE_ALIGN 8   // block alignment, so plain blocks can be used in place
+
+static inline uint64_t zigzag(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 0x01);
+}
+
+static inline void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+static inline uint64_t getVarint(const uint8_t*& in) {
+    uint64_t value = 0;
+    uint8_t shift = 0;
+    while (*in & 0x80) {
+        value |= (uint64_t)(*in++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= (uint64_t)(*in++) << shift;
+    return value;
+}
+
+/**
+ * @brief Constructor for BNO055ColumnWriter class.
+ */
+BNO055ColumnWriter::BNO055ColumnWriter() {
+    file = NULL;
+    position = 0;
+    lastTimestamp = 0;
+    time = 0;
+    started = false;
+    memset(&header, 0, sizeof(header));
+}
+
+/**
+ * @brief Destructor for BNO055ColumnWriter class. Closes the file if it is still open.
+ */
+BNO055ColumnWriter::~BNO055ColumnWriter() {
+    close();
+}
+
+/**
+ * @brief Creates a store.
+ *
+ * @param path The file to create.
+ * @param unitSel The value of the UNIT_SEL register the snapshots were decoded with.
+ * @param chunkSize The number of samples per chunk, e.g. 8192.
+ * @param compress True to delta/varint encode the blocks.
+ * @return True if the file was created.
+ */
+bool BNO055ColumnWriter::open(const char* path, uint8_t unitSel, uint32_t chunkSize, bool compress) {
+    close();
+    file = fopen(path, "wb");
+    if(file == NULL) {
+        return false;
+    }
+    memset(&header, 0, sizeof(header));
+    header.magic = STORE_MAGIC;
+    header.version = STORE_VERSION;
+    header.unitSel = unitSel;
+    header.flags = compress ? STORE_COMPRESSED : 0;
+    header.chunkSize = chunkSize > 0 ? chunkSize : 1;
+    for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+        inverseScale[c] = 1.0f / BNO055Decode::channelScale(c, unitSel);
+        columns[c].clear();
+        columns[c].reserve(header.chunkSize);
+    }
+    chunks.clear();
+    times.clear();
+    times.reserve(header.chunkSize);
+    started = false;
+    time = 0;
+    position = sizeof(header);
+    return fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+/**
+ * @brief Extends the 32-bit micros() timestamp to the 64-bit time since the first sample.
+ *
+ * @param timestamp The snapshot timestamp in us.
+ */
+void BNO055ColumnWriter::appendTime(uint32_t timestamp) {
+    if(started) {
+        time += (uint32_t)(timestamp - lastTimestamp);
+    }
+    started = true;
+    lastTimestamp = timestamp;
+    times.push_back(time);
+}
+
+/**
+ * @brief Appends a decoded snapshot.
+ *
+ * The values are converted back to raw register values with the scale of the header unit selection.
+ *
+ * @param snapshot The decoded snapshot.
+ * @return True if the sample was stored.
+ */
+bool BNO055ColumnWriter::append(const imuSnapshot& snapshot) {
+    if(file == NULL) {
+        return false;
+    }
+    const float* values[CHANNEL_COUNT] = {
+        &snapshot.acc[0], &snapshot.acc[1], &snapshot.acc[2],
+        &snapshot.mag[0], &snapshot.mag[1], &snapshot.mag[2],
+        &snapshot.gyr[0], &snapshot.gyr[1], &snapshot.gyr[2],
+        &snapshot.eul[0], &snapshot.eul[1], &snapshot.eul[2],
+        &snapshot.qua[0], &snapshot.qua[1], &snapshot.qua[2], &snapshot.qua[3],
+        &snapshot.lia[0], &snapshot.lia[1], &snapshot.lia[2],
+        &snapshot.grv[0], &snapshot.grv[1], &snapshot.grv[2],
+        &snapshot.temp
+    };
+    appendTime(snapshot.timestamp);
+    for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+        float raw = roundf(*values[c] * inverseScale[c]);
+        raw = raw > 32767.0f ? 32767.0f : (raw < -32768.0f ? -32768.0f : raw);
+        columns[c].push_back((int16_t)raw);
+    }
+    return times.size() < header.chunkSize || flushChunk();
+}
+
+/**
+ * @brief Appends a raw snapshot as read by BNO055::readRawSnapshot().
+ *
+ * @param timestamp The timestamp in us.
+ * @param raw Pointer to RAW_SNAPSHOT_SIZE bytes read from ACC_X_LSB..TEMP.
+ * @return True if the sample was stored.
+ */
+bool BNO055ColumnWriter::appendRaw(uint32_t timestamp, const uint8_t* raw) {
+    if(file == NULL) {
+        return false;
+    }
+    appendTime(timestamp);
+    for (uint8_t c = 0; c < RAW_SNAPSHOT_WORDS; c++) {
+        columns[c].push_back(BNO055Decode::readInt16LE(&raw[2 * c]));
+    }
+    columns[CHANNEL_TEMP].push_back((int8_t)raw[2 * RAW_SNAPSHOT_WORDS]);
+    return times.size() < header.chunkSize || flushChunk();
+}
+
+/**
+ * @brief Writes one column block at the next aligned position.
+ *
+ * @param data The plain block.
+ * @param size The size of the plain block in bytes.
+ * @param index The index entry of the chunk.
+ * @param column The column of the block.
+ * @return True if the block was written.
+ */
+bool BNO055ColumnWriter::writeBlock(const void* data, size_t size, chunkIndex& index, uint8_t column) {
+    static const uint8_t padding[STORE_ALIGN] = { 0 };
+    size_t pad = (STORE_ALIGN - position % STORE_ALIGN) % STORE_ALIGN;
+    if(pad > 0 && fwrite(padding, 1, pad, file) != pad) {
+        return false;
+    }
+    position += pad;
+    index.offset[column] = position;
+    index.size[column] = (uint32_t)size;
+    position += size;
+    return fwrite(data, 1, size, file) == size;
+}
+
+/**
+ * @brief Encodes and writes the buffered chunk and adds its index entry.
+ *
+ * @return True if the chunk was written.
+ */
+bool BNO055ColumnWriter::flushChunk() {
+    uint32_t count = (uint32_t)times.size();
+    if(count == 0) {
+        return true;
+    }
+    chunkIndex index;
+    memset(&index, 0, sizeof(index));
+    index.firstTime = times.front();
+    index.lastTime = times.back();
+    index.count = count;
+
+    bool success = true;
+    bool compress = header.flags & STORE_COMPRESSED;
+    if(compress) {
+        encoded.clear();
+        int64_t previous = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            putVarint(encoded, zigzag(times[i] - previous));
+            previous = times[i];
+        }
+        success = writeBlock(encoded.data(), encoded.size(), index, STORE_TIME_COLUMN);
+    }
+    else {
+        success = writeBlock(times.data(), count * sizeof(int64_t), index, STORE_TIME_COLUMN);
+    }
+
+    for (uint8_t c = 0; c < CHANNEL_COUNT && success; c++) {
+        const std::vector<int16_t>& column = columns[c];
+        int16_t low = column[0];
+        int16_t high = column[0];
+        for (uint32_t i = 1; i < count; i++) {
+            low = column[i] < low ? column[i] : low;
+            high = column[i] > high ? column[i] : high;
+        }
+        index.min[c] = low;
+        index.max[c] = high;
+        if(compress) {
+            encoded.clear();
+            int32_t previous = 0;
+            for (uint32_t i = 0; i < count; i++) {
+                putVarint(encoded, zigzag((int64_t)column[i] - previous));
+                previous = column[i];
+            }
+            success = writeBlock(encoded.data(), encoded.size(), index, c);
+        }
+        else {
+            success = writeBlock(column.data(), count * sizeof(int16_t), index, c);
+        }
+    }
+
+    chunks.push_back(index);
+    header.sampleCount += count;
+    times.clear();
+    for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+        columns[c].clear();
+    }
+    return success;
+}
+
+/**
+ * @brief Writes the last chunk, the index and the final header and closes the file.
+ *
+ * @return True if everything was written.
+ */
+bool BNO055ColumnWriter::close() {
+    if(file == NULL) {
+        return true;
+    }
+    bool success = flushChunk();
+    static const uint8_t padding[STORE_ALIGN] = { 0 };
+    size_t pad = (STORE_ALIGN - position % STORE_ALIGN) % STORE_ALIGN;
+    success = fwrite(padding, 1, pad, file) == pad && success;
+    position += pad;
+
+    header.chunkCount = (uint32_t)chunks.size();
+    header.indexOffset = position;
+    if(!chunks.empty()) {
+        success = fwrite(chunks.data(), sizeof(chunkIndex), chunks.size(), file) == chunks.size() && success;
+    }
+    success = fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1 && success;
+    success = fclose(file) == 0 && success;
+    file = NULL;
+    return success;
+}
+
+/**
+ * @brief Constructor for BNO055ColumnReader class.
+ */
+BNO055ColumnReader::BNO055ColumnReader() {
+    fd = -1;
+    map = NULL;
+    length = 0;
+    header = NULL;
+    index = NULL;
+}
+
+/**
+ * @brief Destructor for BNO055ColumnReader class. Unmaps the file.
+ */
+BNO055ColumnReader::~BNO055ColumnReader() {
+    close();
+}
+
+/**
+ * @brief Maps a store into memory and validates its header and index.
+ *
+ * @param path The store to open.
+ * @return True if the file is a valid store.
+ */
+bool BNO055ColumnReader::open(const char* path) {
+    close();
+    fd = ::open(path, O_RDONLY);
+    if(fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(fileHeader)) {
+        close();
+        return false;
+    }
+    length = (size_t)info.st_size;
+    void* address = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    if(address == MAP_FAILED) {
+        close();
+        return false;
+    }
+    map = (const uint8_t*)address;
+    header = (const fileHeader*)map;
+    if(header->magic != STORE_MAGIC || header->version != STORE_VERSION ||
+       header->indexOffset + (uint64_t)header->chunkCount * sizeof(chunkIndex) > length) {
+        close();
+        return false;
+    }
+    index = (const chunkIndex*)(map + header->indexOffset);
+    for (uint32_t c = 0; c < header->chunkCount; c++) {
+        for (uint8_t col = 0; col < STORE_COLUMNS; col++) {
+            if(index[c].offset[col] + index[c].size[col] > header->indexOffset) {
+                close();
+                return false;
+            }
+        }
+    }
+    madvise(address, length, MADV_RANDOM);
+    for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+        scale[c] = BNO055Decode::channelScale(c, header->unitSel);
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+void BNO055ColumnReader::close() {
+    if(map != NULL) {
+        munmap((void*)map, length);
+        map = NULL;
+    }
+    if(fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    header = NULL;
+    index = NULL;
+}
+
+/**
+ * @brief Gets the file header.
+ *
+ * @return Reference to the mapped header.
+ */
+const fileHeader& BNO055ColumnReader::getHeader() {
+    return *header;
+}
+
+/**
+ * @brief Gets the index entry of a chunk.
+ *
+ * @param chunk The chunk number.
+ * @return Reference to the mapped index entry.
+ */
+const chunkIndex& BNO055ColumnReader::getChunk(uint32_t chunk) {
+    return index[chunk];
+}
+
+/**
+ * @brief Gets the factor converting the raw values of a channel into physical units.
+ *
+ * @param channel The snapshot channel.
+ * @return The scale factor.
+ */
+float BNO055ColumnReader::getScale(uint8_t channel) {
+    return scale[channel];
+}
+
+/**
+ * @brief Finds the first chunk that ends at or after a time.
+ *
+ * @param time The time in us since the start of the recording.
+ * @return The chunk number, chunkCount if all chunks end earlier.
+ */
+uint32_t BNO055ColumnReader::findChunk(int64_t time) {
+    uint32_t low = 0;
+    uint32_t high = header->chunkCount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if(index[middle].lastTime < time) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Gets the raw values of a channel in a chunk.
+ *
+ * Plain blocks are returned in place from the mapping; compressed blocks are decoded into storage.
+ *
+ * @param chunk The chunk number.
+ * @param channel The snapshot channel.
+ * @param storage Buffer for decoded blocks.
+ * @return Pointer to count raw values.
+ */
+const int16_t* BNO055ColumnReader::readChannel(uint32_t chunk, uint8_t channel, std::vector<int16_t>& storage) {
+    const chunkIndex& entry = index[chunk];
+    const uint8_t* block = map + entry.offset[channel];
+    if(!(header->flags & STORE_COMPRESSED)) {
+        return (const int16_t*)block;
+    }
+    storage.resize(entry.count);
+    int32_t value = 0;
+    for (uint32_t i = 0; i < entry.count; i++) {
+        value += (int32_t)unzigzag(getVarint(block));
+        storage[i] = (int16_t)value;
+    }
+    return storage.data();
+}
+
+/**
+ * @brief Gets the timestamps of a chunk.
+ *
+ * @param chunk The chunk number.
+ * @param storage Buffer for decoded blocks.
+ * @return Pointer to count times in us since the start of the recording.
+ */
+const int64_t* BNO055ColumnReader::readTimes(uint32_t chunk, std::vector<int64_t>& storage) {
+    const chunkIndex& entry = index[chunk];
+    const uint8_t* block = map + entry.offset[STORE_TIME_COLUMN];
+    if(!(header->flags & STORE_COMPRESSED)) {
+        return (const int64_t*)block;
+    }
+    storage.resize(entry.count);
+    int64_t value = 0;
+    for (uint32_t i = 0; i < entry.count; i++) {
+        value += unzigzag(getVarint(block));
+        storage[i] = value;
+    }
+    return storage.data();
+}
+
+/**
+ * @brief Checks if the min/max of a chunk allow a match of all predicates.
+ *
+ * @param entry The index entry of the chunk.
+ * @param predicates Array of range predicates.
+ * @param count The number of predicates.
+ * @return False if some predicate cannot hold for any sample of the chunk.
+ */
+bool BNO055ColumnReader::chunkMayMatch(const chunkIndex& entry, const rangePredicate* predicates, uint8_t count) {
+    for (uint8_t p = 0; p < count; p++) {
+        uint8_t channel = predicates[p].channel;
+        float low = entry.min[channel] * scale[channel];
+        float high = entry.max[channel] * scale[channel];
+        if(high < predicates[p].lo || low > predicates[p].hi) {
+            return false;
+        }
+    }
+    return true;
+}
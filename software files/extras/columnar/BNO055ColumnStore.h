@@ -0,0 +1,288 @@
+#ifndef BNO055ColumnStore_h
+#define BNO055ColumnStore_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include "BNO055Decode.h"
+
+// Host-side (Linux) storage of decoded snapshots for long recordings.
+//
+// File layout: a fileHeader, then the chunks, then one chunkIndex per chunk. A chunk holds
+// up to chunkSize consecutive samples as one block per column: the timestamp column in us
+// since the start of the recording (64 bit, so multi-day recordings do not wrap) and one
+// column per snapshot channel holding the raw register value (int16), which is lossless
+// for data decoded from the sensor and half the size of float. Blocks are either plain
+// little-endian arrays, read in place from the mapping, or delta + zigzag + varint
+// encoded (STORE_COMPRESSED). The index holds the time range, the block locations and the
+// raw min/max of every channel per chunk; it is all a query touches before deciding which
+// blocks to decode, so time ranges are found by binary search and range predicates and
+// change searches skip every chunk whose min/max cannot match.
+
+#define STORE_MAGIC 0x434F4E42   // "BNOC"
+#define STORE_VERSION 1
+#define STORE_COMPRESSED 0x01
+#define STORE_COLUMNS (CHANNEL_COUNT + 1)
+#define STORE_TIME_COLUMN CHANNEL_COUNT
+
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint8_t unitSel;
+  uint8_t flags;
+  uint32_t chunkSize;
+  uint32_t chunkCount;
+  uint64_t sampleCount;
+  uint64_t indexOffset;
+} fileHeader;
+
+typedef struct {
+  int64_t firstTime;
+  int64_t lastTime;
+  uint32_t count;
+  uint32_t reserved;
+  uint64_t offset[STORE_COLUMNS];
+  uint32_t size[STORE_COLUMNS];
+  int16_t min[CHANNEL_COUNT];
+  int16_t max[CHANNEL_COUNT];
+} chunkIndex;
+
+typedef struct {
+  uint32_t chunks;
+  uint32_t chunksSkipped;
+  uint64_t samplesScanned;
+  uint64_t matches;
+} queryStats;
+
+// Range predicate on one channel in physical units: lo <= value <= hi.
+typedef struct {
+  uint8_t channel;
+  float lo;
+  float hi;
+} rangePredicate;
+
+class BNO055ColumnWriter {
+  public:
+      BNO055ColumnWriter();
+      ~BNO055ColumnWriter();
+      bool open(const char* path, uint8_t unitSel, uint32_t chunkSize, bool compress);
+      bool append(const imuSnapshot& snapshot);
+      bool appendRaw(uint32_t timestamp, const uint8_t* raw);
+      bool close();
+  private:
+      void appendTime(uint32_t timestamp);
+      bool flushChunk();
+      bool writeBlock(const void* data, size_t size, chunkIndex& index, uint8_t column);
+
+      FILE* file;
+      fileHeader header;
+      std::vector<chunkIndex> chunks;
+      std::vector<int64_t> times;
+      std::vector<int16_t> columns[CHANNEL_COUNT];
+      std::vector<uint8_t> encoded;
+      float inverseScale[CHANNEL_COUNT];
+      uint64_t position;
+      uint32_t lastTimestamp;
+      int64_t time;
+      bool started;
+};
+
+class BNO055ColumnReader {
+  public:
+      BNO055ColumnReader();
+      ~BNO055ColumnReader();
+      bool open(const char* path);
+      void close();
+      const fileHeader& getHeader();
+      const chunkIndex& getChunk(uint32_t chunk);
+      float getScale(uint8_t channel);
+      uint32_t findChunk(int64_t time);
+      const int16_t* readChannel(uint32_t chunk, uint8_t channel, std::vector<int16_t>& storage);
+      const int64_t* readTimes(uint32_t chunk, std::vector<int64_t>& storage);
+
+      template<typename Visitor>
+      queryStats select(int64_t from, int64_t to, const rangePredicate* predicates, uint8_t count,
+                        uint32_t channelMask, Visitor visit);
+      template<typename Visitor>
+      queryStats findChanges(uint8_t channel, float threshold, int64_t lag, int64_t from, int64_t to, Visitor visit);
+  private:
+      bool chunkMayMatch(const chunkIndex& entry, const rangePredicate* predicates, uint8_t count);
+
+      int fd;
+      const uint8_t* map;
+      size_t length;
+      const fileHeader* header;
+      const chunkIndex* index;
+      float scale[CHANNEL_COUNT];
+};
+
+/**
+ * @brief Selects the samples in a time range that satisfy all predicates.
+ *
+ * Chunks outside the range or whose min/max cannot satisfy a predicate are skipped without touching their data. Only the columns of the predicates and of channelMask are decoded.
+ *
+ * @param from The first time in us since the start of the recording.
+ * @param to The last time in us, inclusive.
+ * @param predicates Array of range predicates, all of which must hold.
+ * @param count The number of predicates.
+ * @param channelMask Bit c set if channel c is passed to the visitor.
+ * @param visit Called as visit(time, const float* values) for every match; values holds CHANNEL_COUNT entries, of which the masked and predicate channels are valid.
+ * @return The query statistics.
+ */
+template<typename Visitor>
+queryStats BNO055ColumnReader::select(int64_t from, int64_t to, const rangePredicate* predicates, uint8_t count,
+                                      uint32_t channelMask, Visitor visit) {
+    queryStats stats = { 0, 0, 0, 0 };
+    uint32_t needed = channelMask;
+    for (uint8_t p = 0; p < count; p++) {
+        needed |= (uint32_t)1 << predicates[p].channel;
+    }
+    std::vector<int64_t> timeStorage;
+    std::vector<int16_t> storage[CHANNEL_COUNT];
+    const int16_t* data[CHANNEL_COUNT];
+    float values[CHANNEL_COUNT] = { 0 };
+
+    for (uint32_t c = findChunk(from); c < header->chunkCount && index[c].firstTime <= to; c++) {
+        stats.chunks++;
+        if(!chunkMayMatch(index[c], predicates, count)) {
+            stats.chunksSkipped++;
+            continue;
+        }
+        const int64_t* times = readTimes(c, timeStorage);
+        for (uint8_t ch = 0; ch < CHANNEL_COUNT; ch++) {
+            data[ch] = ((needed >> ch) & 0x01) ? readChannel(c, ch, storage[ch]) : NULL;
+        }
+        for (uint32_t i = 0; i < index[c].count; i++) {
+            if(times[i] < from || times[i] > to) {
+                continue;
+            }
+            stats.samplesScanned++;
+            bool match = true;
+            for (uint8_t p = 0; p < count && match; p++) {
+                float value = data[predicates[p].channel][i] * scale[predicates[p].channel];
+                match = value >= predicates[p].lo && value <= predicates[p].hi;
+            }
+            if(!match) {
+                continue;
+            }
+            for (uint8_t ch = 0; ch < CHANNEL_COUNT; ch++) {
+                if(data[ch] != NULL) {
+                    values[ch] = data[ch][i] * scale[ch];
+                }
+            }
+            stats.matches++;
+            visit(times[i], (const float*)values);
+        }
+    }
+    return stats;
+}
+
+/**
+ * @brief Finds the samples at which a channel differs from its value lag us earlier by more than a threshold.
+ *
+ * The difference of the Euler angle channels is taken on the circle (e.g. 350° to 10° is 20°). A chunk is skipped when the spread of its min/max together with the chunks reaching back lag us is not above the threshold.
+ *
+ * @param channel The channel to test.
+ * @param threshold The minimum absolute change in physical units.
+ * @param lag The time between the two compared samples in us.
+ * @param from The first time in us since the start of the recording.
+ * @param to The last time in us, inclusive.
+ * @param visit Called as visit(time, value, change) for every match.
+ * @return The query statistics.
+ */
+template<typename Visitor>
+queryStats BNO055ColumnReader::findChanges(uint8_t channel, float threshold, int64_t lag, int64_t from, int64_t to, Visitor visit) {
+    queryStats stats = { 0, 0, 0, 0 };
+    const bool angle = channel >= CHANNEL_EUL_HEADING && channel <= CHANNEL_EUL_PITCH;
+    const float period = (header->unitSel & 0x04) ? 6.2831853f : 360.0f;
+    const int32_t rawThreshold = (int32_t)(threshold / scale[channel]);
+
+    // window of decoded chunks covering [time - lag, time]
+    std::vector<int64_t> windowTimes;
+    std::vector<int16_t> windowValues;
+    std::vector<int64_t> timeStorage;
+    std::vector<int16_t> storage;
+    uint32_t windowStart = 0;
+    uint32_t windowEnd = 0;   // chunks [windowStart, windowEnd) are decoded into the window
+
+    uint32_t first = findChunk(from);
+    for (uint32_t c = first; c < header->chunkCount && index[c].firstTime <= to; c++) {
+        stats.chunks++;
+        uint32_t back = c;
+        int16_t low = index[c].min[channel];
+        int16_t high = index[c].max[channel];
+        while (back > 0 && index[back - 1].lastTime >= index[c].firstTime - lag) {
+            back--;
+            low = index[back].min[channel] < low ? index[back].min[channel] : low;
+            high = index[back].max[channel] > high ? index[back].max[channel] : high;
+        }
+        if((int32_t)high - (int32_t)low <= rawThreshold) {
+            stats.chunksSkipped++;
+            continue;
+        }
+
+        if(back != windowStart || windowEnd <= back) {
+            windowTimes.clear();
+            windowValues.clear();
+            windowStart = back;
+            windowEnd = back;
+        }
+        while (windowEnd <= c) {
+            const int64_t* times = readTimes(windowEnd, timeStorage);
+            const int16_t* values = readChannel(windowEnd, channel, storage);
+            windowTimes.insert(windowTimes.end(), times, times + index[windowEnd].count);
+            windowValues.insert(windowValues.end(), values, values + index[windowEnd].count);
+            windowEnd++;
+        }
+
+        size_t begin = windowTimes.size() - index[c].count;
+        size_t reference = 0;
+        for (size_t i = begin; i < windowTimes.size(); i++) {
+            int64_t t = windowTimes[i];
+            if(t < from || t > to) {
+                continue;
+            }
+            stats.samplesScanned++;
+            while (reference + 1 < i && windowTimes[reference + 1] <= t - lag) {
+                reference++;
+            }
+            if(windowTimes[reference] > t - lag) {
+                continue;
+            }
+            float value = windowValues[i] * scale[channel];
+            float change = value - windowValues[reference] * scale[channel];
+            if(angle) {
+                change = fmodf(change, period);
+                if(change > period / 2) {
+                    change -= period;
+                }
+                else if(change < -period / 2) {
+                    change += period;
+                }
+            }
+            if(change > threshold || change < -threshold) {
+                stats.matches++;
+                visit(t, value, change);
+            }
+        }
+
+        // drop the chunks the next one cannot reach back to
+        if(c + 1 < header->chunkCount) {
+            uint32_t keep = windowStart;
+            while (keep < c && index[keep].lastTime < index[c + 1].firstTime - lag) {
+                keep++;
+            }
+            size_t drop = 0;
+            for (uint32_t k = windowStart; k < keep; k++) {
+                drop += index[k].count;
+            }
+            windowTimes.erase(windowTimes.begin(), windowTimes.begin() + drop);
+            windowValues.erase(windowValues.begin(), windowValues.begin() + drop);
+            windowStart = keep;
+        }
+    }
+    return stats;
+}
+#endif
@@ -0,0 +1,323 @@
+// Host tool for BNO055ColumnStore files: imports CSV logs, prints the chunk index, runs
+// time-range/predicate and change queries, and benchmarks a generated day-long recording.
+//
+// Build: g++ -O2 -I../../src column_tool.cpp BNO055ColumnStore.cpp ../../src/BNO055Decode.cpp -o column_tool
+// Usage: column_tool import [-z] [-c chunk] [-u unitsel] log.csv store.bnoc
+//        column_tool info store.bnoc
+//        column_tool select store.bnoc from_s to_s [channel lo hi]...
+//        column_tool changes store.bnoc channel threshold lag_s [from_s to_s]
+//        column_tool bench [-z] [-c chunk] [store.bnoc]
+//
+// CSV lines hold the timestamp in us followed by the 23 snapshot channels in imuSnapshot
+// order (acc, mag, gyr, eul, qua, lia, grv, temp), comma/space separated; other lines are
+// skipped. Channels are named acc_x .. temp, e.g. "changes day.bnoc eul_heading 30 1".
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "BNO055ColumnStore.h"
+
+#define DEFAULT_CHUNK 8192
+#define BENCH_SAMPLES 8640000   // one day at 100 Hz
+#define BENCH_PERIOD 10000
+
+static const char* channelNames[CHANNEL_COUNT] = {
+    "acc_x", "acc_y", "acc_z", "mag_x", "mag_y", "mag_z", "gyr_x", "gyr_y", "gyr_z",
+    "eul_heading", "eul_roll", "eul_pitch", "qua_w", "qua_x", "qua_y", "qua_z",
+    "lia_x", "lia_y", "lia_z", "grv_x", "grv_y", "grv_z", "temp"
+};
+
+static int channelByName(const char* name) {
+    for (int c = 0; c < CHANNEL_COUNT; c++) {
+        if(strcmp(name, channelNames[c]) == 0) {
+            return c;
+        }
+    }
+    fprintf(stderr, "unknown channel %s\n", name);
+    exit(1);
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool parseLine(char* line, imuSnapshot& s) {
+    float* values[CHANNEL_COUNT] = {
+        &s.acc[0], &s.acc[1], &s.acc[2], &s.mag[0], &s.mag[1], &s.mag[2],
+        &s.gyr[0], &s.gyr[1], &s.gyr[2], &s.eul[0], &s.eul[1], &s.eul[2],
+        &s.qua[0], &s.qua[1], &s.qua[2], &s.qua[3], &s.lia[0], &s.lia[1], &s.lia[2],
+        &s.grv[0], &s.grv[1], &s.grv[2], &s.temp
+    };
+    int found = 0;
+    for (char* token = strtok(line, ",; \t\r\n"); token != NULL && found <= CHANNEL_COUNT; token = strtok(NULL, ",; \t\r\n")) {
+        char* end;
+        double value = strtod(token, &end);
+        if(end == token) {
+            return false;
+        }
+        if(found == 0) {
+            s.timestamp = (uint32_t)(uint64_t)value;
+        }
+        else {
+            *values[found - 1] = (float)value;
+        }
+        found++;
+    }
+    return found == CHANNEL_COUNT + 1;
+}
+
+static int runImport(int argc, char** argv) {
+    bool compress = false;
+    uint32_t chunk = DEFAULT_CHUNK;
+    uint8_t unitSel = 0x80;
+    const char* paths[2] = { NULL, NULL };
+    int found = 0;
+    for (int i = 0; i < argc; i++) {
+        if(strcmp(argv[i], "-z") == 0) {
+            compress = true;
+        }
+        else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            chunk = (uint32_t)atol(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+            unitSel = (uint8_t)strtol(argv[++i], NULL, 0);
+        }
+        else if(found < 2) {
+            paths[found++] = argv[i];
+        }
+    }
+    if(found < 2) {
+        fprintf(stderr, "usage: column_tool import [-z] [-c chunk] [-u unitsel] log.csv store.bnoc\n");
+        return 1;
+    }
+    FILE* input = fopen(paths[0], "r");
+    if(input == NULL) {
+        fprintf(stderr, "cannot open %s\n", paths[0]);
+        return 1;
+    }
+    BNO055ColumnWriter writer;
+    if(!writer.open(paths[1], unitSel, chunk, compress)) {
+        fprintf(stderr, "cannot create %s\n", paths[1]);
+        fclose(input);
+        return 1;
+    }
+    char line[1024];
+    imuSnapshot s;
+    unsigned long samples = 0;
+    while (fgets(line, sizeof(line), input) != NULL) {
+        if(parseLine(line, s)) {
+            writer.append(s);
+            samples++;
+        }
+    }
+    fclose(input);
+    if(!writer.close()) {
+        fprintf(stderr, "write error on %s\n", paths[1]);
+        return 1;
+    }
+    printf("%lu samples imported\n", samples);
+    return 0;
+}
+
+static int runInfo(const char* path) {
+    BNO055ColumnReader reader;
+    if(!reader.open(path)) {
+        fprintf(stderr, "%s is not a column store\n", path);
+        return 1;
+    }
+    const fileHeader& header = reader.getHeader();
+    printf("%llu samples in %u chunks of %u, unit_sel 0x%02X, %s\n",
+        (unsigned long long)header.sampleCount, header.chunkCount, header.chunkSize,
+        header.unitSel, (header.flags & STORE_COMPRESSED) ? "compressed" : "plain");
+    for (uint32_t c = 0; c < header.chunkCount; c++) {
+        const chunkIndex& entry = reader.getChunk(c);
+        printf("chunk %5u  %12.3f .. %12.3f s  %6u samples  heading %7.2f .. %7.2f\n", c,
+            entry.firstTime * 1e-6, entry.lastTime * 1e-6, entry.count,
+            entry.min[CHANNEL_EUL_HEADING] * reader.getScale(CHANNEL_EUL_HEADING),
+            entry.max[CHANNEL_EUL_HEADING] * reader.getScale(CHANNEL_EUL_HEADING));
+    }
+    return 0;
+}
+
+static void printStats(const queryStats& stats, double ms) {
+    printf("%llu matches, %u chunks (%u skipped), %llu samples scanned, %.3f ms\n",
+        (unsigned long long)stats.matches, stats.chunks, stats.chunksSkipped,
+        (unsigned long long)stats.samplesScanned, ms);
+}
+
+static int runSelect(int argc, char** argv) {
+    if(argc < 3 || (argc - 3) % 3 != 0) {
+        fprintf(stderr, "usage: column_tool select store.bnoc from_s to_s [channel lo hi]...\n");
+        return 1;
+    }
+    BNO055ColumnReader reader;
+    if(!reader.open(argv[0])) {
+        fprintf(stderr, "%s is not a column store\n", argv[0]);
+        return 1;
+    }
+    rangePredicate predicates[8];
+    uint8_t count = 0;
+    uint32_t mask = 0;
+    for (int i = 3; i + 2 < argc && count < 8; i += 3, count++) {
+        predicates[count].channel = (uint8_t)channelByName(argv[i]);
+        predicates[count].lo = (float)atof(argv[i + 1]);
+        predicates[count].hi = (float)atof(argv[i + 2]);
+        mask |= (uint32_t)1 << predicates[count].channel;
+    }
+    int64_t from = (int64_t)(atof(argv[1]) * 1e6);
+    int64_t to = (int64_t)(atof(argv[2]) * 1e6);
+    auto start = std::chrono::steady_clock::now();
+    queryStats stats = reader.select(from, to, predicates, count, mask, [&](int64_t time, const float* values) {
+        printf("%.6f", time * 1e-6);
+        for (uint8_t p = 0; p < count; p++) {
+            printf(" %s=%.4f", channelNames[predicates[p].channel], values[predicates[p].channel]);
+        }
+        printf("\n");
+    });
+    printStats(stats, elapsedMs(start));
+    return 0;
+}
+
+static int runChanges(int argc, char** argv) {
+    if(argc < 4) {
+        fprintf(stderr, "usage: column_tool changes store.bnoc channel threshold lag_s [from_s to_s]\n");
+        return 1;
+    }
+    BNO055ColumnReader reader;
+    if(!reader.open(argv[0])) {
+        fprintf(stderr, "%s is not a column store\n", argv[0]);
+        return 1;
+    }
+    uint8_t channel = (uint8_t)channelByName(argv[1]);
+    float threshold = (float)atof(argv[2]);
+    int64_t lag = (int64_t)(atof(argv[3]) * 1e6);
+    int64_t from = argc > 4 ? (int64_t)(atof(argv[4]) * 1e6) : 0;
+    int64_t to = argc > 5 ? (int64_t)(atof(argv[5]) * 1e6) : INT64_MAX;
+    auto start = std::chrono::steady_clock::now();
+    queryStats stats = reader.findChanges(channel, threshold, lag, from, to, [&](int64_t time, float value, float change) {
+        printf("%.6f %s=%.4f change %+.4f\n", time * 1e-6, channelNames[channel], value, change);
+    });
+    printStats(stats, elapsedMs(start));
+    return 0;
+}
+
+// a unit that mostly holds its heading and turns a few times per hour, plus rare bumps
+static void benchSample(uint32_t k, double& heading, imuSnapshot& s) {
+    memset(&s, 0, sizeof(imuSnapshot));
+    s.timestamp = k * BENCH_PERIOD;
+    uint32_t phase = k % 90000;   // 15 min
+    if(phase < 1000) {
+        heading += (k / 90000 % 2 ? 0.09 : -0.06);   // 90° or 60° turn over 10 s
+        heading = fmod(heading + 360.0, 360.0);
+    }
+    double noise = ((rand() % 1000) - 500) * 1e-4;
+    s.eul[0] = (float)(floor((heading + noise) * 16.0) / 16.0);
+    s.eul[1] = (float)(floor(noise * 160.0) / 16.0);
+    s.eul[2] = (float)(floor(-noise * 160.0) / 16.0);
+    s.acc[2] = (float)(floor((9.81 + noise) * 100.0) / 100.0);
+    if(k % 1000003 == 500000) {
+        s.acc[2] = 40.0f;
+    }
+    s.grv[2] = 9.81f;
+    s.qua[0] = (float)(floor(cos(heading * M_PI / 360.0) * 16384.0) / 16384.0);
+    s.qua[3] = (float)(floor(sin(heading * M_PI / 360.0) * 16384.0) / 16384.0);
+    s.temp = (float)(25 + k / 360000);
+}
+
+static int runBench(int argc, char** argv) {
+    bool compress = false;
+    uint32_t chunk = DEFAULT_CHUNK;
+    const char* path = "/tmp/column_bench.bnoc";
+    for (int i = 0; i < argc; i++) {
+        if(strcmp(argv[i], "-z") == 0) {
+            compress = true;
+        }
+        else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            chunk = (uint32_t)atol(argv[++i]);
+        }
+        else {
+            path = argv[i];
+        }
+    }
+
+    BNO055ColumnWriter writer;
+    if(!writer.open(path, 0x80, chunk, compress)) {
+        fprintf(stderr, "cannot create %s\n", path);
+        return 1;
+    }
+    srand(1);
+    double heading = 0;
+    imuSnapshot s;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t k = 0; k < BENCH_SAMPLES; k++) {
+        benchSample(k, heading, s);
+        writer.append(s);
+    }
+    writer.close();
+    double writeMs = elapsedMs(start);
+
+    BNO055ColumnReader reader;
+    if(!reader.open(path)) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+    const fileHeader& header = reader.getHeader();
+    FILE* file = fopen(path, "rb");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    printf("%llu samples (24 h at 100 Hz), %u chunks of %u, %s: %.1f MB (%.1f B/sample), written in %.0f ms\n",
+        (unsigned long long)header.sampleCount, header.chunkCount, header.chunkSize,
+        compress ? "compressed" : "plain", size / 1e6, (double)size / header.sampleCount, writeMs);
+
+    uint64_t matches = 0;
+    start = std::chrono::steady_clock::now();
+    queryStats stats = reader.select(43200000000LL, 43260000000LL, NULL, 0, 1u << CHANNEL_EUL_HEADING,
+        [&](int64_t, const float*) { matches++; });
+    printf("one minute at noon:            ");
+    printStats(stats, elapsedMs(start));
+
+    rangePredicate bump = { CHANNEL_ACC_Z, 30.0f, 1000.0f };
+    start = std::chrono::steady_clock::now();
+    stats = reader.select(0, INT64_MAX, &bump, 1, 0, [&](int64_t, const float*) { matches++; });
+    printf("acc_z > 30 over the day:       ");
+    printStats(stats, elapsedMs(start));
+
+    start = std::chrono::steady_clock::now();
+    stats = reader.findChanges(CHANNEL_EUL_HEADING, 30.0f, 5000000, 0, INT64_MAX, [&](int64_t, float, float) { matches++; });
+    printf("heading change > 30 in 5 s:    ");
+    printStats(stats, elapsedMs(start));
+
+    rangePredicate all = { CHANNEL_EUL_HEADING, -1000.0f, 1000.0f };
+    start = std::chrono::steady_clock::now();
+    stats = reader.select(0, INT64_MAX, &all, 1, 0, [&](int64_t, const float*) { matches++; });
+    printf("full scan of heading:          ");
+    printStats(stats, elapsedMs(start));
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        fprintf(stderr, "usage: column_tool import|info|select|changes|bench ...\n");
+        return 1;
+    }
+    if(strcmp(argv[1], "import") == 0) {
+        return runImport(argc - 2, argv + 2);
+    }
+    if(strcmp(argv[1], "info") == 0 && argc > 2) {
+        return runInfo(argv[2]);
+    }
+    if(strcmp(argv[1], "select") == 0) {
+        return runSelect(argc - 2, argv + 2);
+    }
+    if(strcmp(argv[1], "changes") == 0) {
+        return runChanges(argc - 2, argv + 2);
+    }
+    if(strcmp(argv[1], "bench") == 0) {
+        return runBench(argc - 2, argv + 2);
+    }
+    fprintf(stderr, "unknown command %s\n", argv[1]);
+    return 1;
+}
@@ -0,0 +1,39 @@
+// Minimal sketch used by size_report.sh to measure the driver footprint per feature set.
+// Every feature that is enabled is also referenced, so the linker keeps it.
+#include "BNO055.h"
+
+BNO055 bnoSensor;
+
+void setup() {
+#if BNO055_ENABLE_TRACE
+  BNO055Trace::start();
+#endif
+  bnoSensor.begin();
+#if BNO055_ENABLE_INTERRUPTS
+  interruptConfig config;
+  bnoSensor.getInterruptConfig(&config);
+  bnoSensor.setInterruptConfig(&config);
+#endif
+#if BNO055_ENABLE_CALIBRATION
+  calibOffsets offsets;
+  bnoSensor.getCalibrationOffsets(&offsets);
+  bnoSensor.setCalibrationOffsets(&offsets);
+#endif
+  bnoSensor.setOperationMode(OPERATION_MODE_NDOF);
+}
+
+void loop() {
+#if BNO055_ENABLE_FLOAT
+  imuSnapshot snapshot;
+  bnoSensor.readSnapshot(snapshot);
+#else
+  uint8_t raw[RAW_SNAPSHOT_SIZE];
+  bnoSensor.readRawSnapshot(raw);
+#endif
+#if BNO055_ENABLE_CALIBRATION
+  bnoSensor.isFullyCalibrated();
+#endif
+#if BNO055_ENABLE_TRACE
+  BNO055Trace::dump(Serial);
+#endif
+}
@@ -0,0 +1,34 @@
+#!/bin/sh
+# Prints flash and RAM usage of the BNO055 driver for each feature set.
+#
+# Usage: size_report.sh [fqbn]       (default: arduino:avr:uno)
+# Requires arduino-cli with the core for the given board installed.
+
+FQBN=${1:-arduino:avr:uno}
+HERE=$(cd "$(dirname "$0")" && pwd)
+LIBRARY=$(cd "$HERE/../.." && pwd)
+
+report() {
+    name=$1
+    flags=$2
+    output=$(arduino-cli compile --fqbn "$FQBN" --library "$LIBRARY" \
+        --build-property "build.extra_flags=$flags" "$HERE" 2>&1)
+    flash=$(echo "$output" | sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p')
+    ram=$(echo "$output" | sed -n 's/^Global variables use \([0-9]*\) bytes.*/\1/p')
+    if [ -z "$flash" ]; then
+        printf "%-16s build failed\n" "$name"
+        echo "$output" | tail -n 5
+        return
+    fi
+    printf "%-16s %8s %8s\n" "$name" "$flash" "$ram"
+}
+
+printf "%-16s %8s %8s\n" "feature set" "flash" "ram"
+report "full"           ""
+report "no-float"       "-DBNO055_ENABLE_FLOAT=0"
+report "no-interrupts"  "-DBNO055_ENABLE_INTERRUPTS=0"
+report "no-calibration" "-DBNO055_ENABLE_CALIBRATION=0"
+report "diagnostics"    "-DBNO055_ENABLE_DIAGNOSTICS=1"
+report "trace"          "-DBNO055_ENABLE_TRACE=1"
+report "uart"           "-DBNO055_TRANSPORT_UART -DBNO055_ENABLE_DIAGNOSTICS=1"
+report "minimal"        "-DBNO055_ENABLE_FLOAT=0 -DBNO055_ENABLE_INTERRUPTS=0 -DBNO055_ENABLE_CALIBRATION=0"
@@ -0,0 +1,235 @@
+// Host replay benchmark of BNO055DeadReckoning. Without a log it generates two 100 Hz
+// datasets with sensor noise and an acceleration bias: a foot-mounted walk (three sides of a
+// square, 1.2 m steps with 0.4 s stance) and a vehicle drive (three legs with stops). Each is
+// replayed with and without zero-velocity updates and the end position error is printed,
+// then the throughput is measured on a long stream.
+//
+// Build: g++ -O2 -I../../src dead_reckoning_bench.cpp ../../src/BNO055DeadReckoning.cpp -o dead_reckoning_bench
+// Usage: dead_reckoning_bench [-n samples] [log.csv]
+//
+// A log is replayed instead of the generated datasets. Each line holds the timestamp in us,
+// the quaternion (w, x, y, z), the linear acceleration, the acceleration (m/s²) and the gyro
+// rate (dps), comma/space separated; other lines are skipped.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "BNO055DeadReckoning.h"
+
+#define SAMPLE_PERIOD 10000
+#define ACC_NOISE 0.05
+#define ACC_BIAS 0.03
+
+struct dataset {
+    const char* name;
+    std::vector<imuSnapshot> samples;
+    float truth[3];
+    float distance;
+};
+
+static double gaussian() {
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+// sensor aligned with the world except for the heading, lia = R(yaw)^T a
+static void makeSample(uint32_t k, double yaw, const double* world, double gyroRate, double noise, imuSnapshot& s) {
+    memset(&s, 0, sizeof(imuSnapshot));
+    s.timestamp = k * SAMPLE_PERIOD;
+    s.qua[0] = (float)cos(yaw / 2);
+    s.qua[3] = (float)sin(yaw / 2);
+    double c = cos(yaw), sn = sin(yaw);
+    double body[3] = { c * world[0] + sn * world[1], -sn * world[0] + c * world[1], world[2] };
+    for (int i = 0; i < 3; i++) {
+        double n = noise * gaussian();
+        s.lia[i] = (float)(body[i] + ACC_BIAS + n);
+        s.acc[i] = s.lia[i] + (i == 2 ? 9.81f : 0.0f);
+        s.gyr[i] = (float)((i == 1 ? gyroRate : 0) + 0.2 * gaussian());
+    }
+}
+
+// three sides of 10 steps; the forward acceleration of a swing is a full sine period
+static void walk(dataset& d) {
+    const double stance = 0.4, swing = 0.7, step = 1.2;
+    const int samplesPerStep = (int)((stance + swing) / (SAMPLE_PERIOD * 1e-6) + 0.5);
+    uint32_t k = 0;
+    double x = 0, y = 0;
+    for (int side = 0; side < 3; side++) {
+        double yaw = side * M_PI / 2;
+        for (int n = 0; n < 10; n++) {
+            for (int j = 0; j < samplesPerStep; j++, k++) {
+                double t = j * SAMPLE_PERIOD * 1e-6 - stance;
+                double world[3] = { 0, 0, 0 };
+                double rate = 0;
+                if(t >= 0) {
+                    double a = 2 * M_PI * step / (swing * swing) * sin(2 * M_PI * t / swing);
+                    world[0] = a * cos(yaw);
+                    world[1] = a * sin(yaw);
+                    world[2] = 3.0 * (cos(2 * M_PI * t / swing) - cos(4 * M_PI * t / swing));
+                    rate = 300.0 * sin(2 * M_PI * t / swing);
+                }
+                imuSnapshot s;
+                makeSample(k, yaw, world, rate, ACC_NOISE, s);
+                d.samples.push_back(s);
+            }
+            x += step * cos(yaw);
+            y += step * sin(yaw);
+        }
+    }
+    for (int j = 0; j < 50; j++, k++) {
+        double world[3] = { 0, 0, 0 };
+        imuSnapshot s;
+        makeSample(k, 0, world, 0, ACC_NOISE, s);
+        d.samples.push_back(s);
+    }
+    d.truth[0] = (float)x;
+    d.truth[1] = (float)y;
+    d.truth[2] = 0;
+    d.distance = 30 * step;
+}
+
+// legs of 5 s acceleration, 20 s cruise, 5 s braking and a 5 s stop; road vibration while moving
+static void vehicle(dataset& d) {
+    const double accel = 2.0;
+    uint32_t k = 0;
+    double x = 0, y = 0, distance = 0;
+    for (int leg = 0; leg < 3; leg++) {
+        double yaw = leg * M_PI / 2;
+        for (int j = 0; j < 3500; j++, k++) {
+            double t = j * SAMPLE_PERIOD * 1e-6;
+            double a = t < 5 ? accel : (t < 25 ? 0 : (t < 30 ? -accel : 0));
+            bool moving = t < 30;
+            double world[3] = { a * cos(yaw), a * sin(yaw), 0 };
+            imuSnapshot s;
+            makeSample(k, yaw, world, moving ? 2.0 * gaussian() : 0, moving ? 0.4 : ACC_NOISE, s);
+            d.samples.push_back(s);
+        }
+        double legLength = accel * 25 * 5;
+        x += legLength * cos(yaw);
+        y += legLength * sin(yaw);
+        distance += legLength;
+    }
+    d.truth[0] = (float)x;
+    d.truth[1] = (float)y;
+    d.truth[2] = 0;
+    d.distance = (float)distance;
+}
+
+static bool parseLine(char* line, imuSnapshot& s) {
+    float values[14];
+    int found = 0;
+    for (char* token = strtok(line, ",; \t\r\n"); token != NULL && found < 14; token = strtok(NULL, ",; \t\r\n")) {
+        char* end;
+        values[found] = strtof(token, &end);
+        if(end == token) {
+            return false;
+        }
+        found++;
+    }
+    if(found < 14) {
+        return false;
+    }
+    memset(&s, 0, sizeof(imuSnapshot));
+    s.timestamp = (uint32_t)values[0];
+    memcpy(s.qua, &values[1], sizeof(s.qua));
+    memcpy(s.lia, &values[5], sizeof(s.lia));
+    memcpy(s.acc, &values[8], sizeof(s.acc));
+    memcpy(s.gyr, &values[11], sizeof(s.gyr));
+    return true;
+}
+
+static void replay(const std::vector<imuSnapshot>& samples, bool zupt, float* position, deadReckoningStats* stats) {
+    BNO055DeadReckoning dr;
+    if(!zupt) {
+        dr.setStance(0, 0, 0);
+    }
+    for (size_t i = 0; i < samples.size(); i++) {
+        dr.update(samples[i]);
+    }
+    dr.getPosition(position);
+    dr.getStats(stats);
+}
+
+static void report(const dataset& d) {
+    float position[3];
+    deadReckoningStats stats;
+    printf("%s: %zu samples, %.1f m travelled, end at (%.2f, %.2f)\n",
+        d.name, d.samples.size(), d.distance, d.truth[0], d.truth[1]);
+    for (int zupt = 0; zupt < 2; zupt++) {
+        replay(d.samples, zupt != 0, position, &stats);
+        double error = sqrt(pow(position[0] - d.truth[0], 2) + pow(position[1] - d.truth[1], 2) + pow(position[2] - d.truth[2], 2));
+        printf("  %-8s end error %8.2f m (%6.2f %% of distance), %lu stances, max velocity error %.3f m/s\n",
+            zupt ? "ZUPT" : "no ZUPT", error, 100.0 * error / d.distance,
+            (unsigned long)stats.stances, stats.maxVelocityError);
+    }
+}
+
+int main(int argc, char** argv) {
+    long count = 10000000;
+    const char* path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = atol(argv[++i]);
+        }
+        else {
+            path = argv[i];
+        }
+    }
+
+    std::vector<imuSnapshot> stream;
+    if(path != NULL) {
+        FILE* input = fopen(path, "r");
+        if(input == NULL) {
+            fprintf(stderr, "cannot open %s\n", path);
+            return 1;
+        }
+        char line[512];
+        imuSnapshot s;
+        while (fgets(line, sizeof(line), input) != NULL) {
+            if(parseLine(line, s)) {
+                stream.push_back(s);
+            }
+        }
+        fclose(input);
+        if(stream.empty()) {
+            fprintf(stderr, "no samples in %s\n", path);
+            return 1;
+        }
+        float position[3];
+        deadReckoningStats stats;
+        replay(stream, true, position, &stats);
+        printf("%s: %zu samples, end at (%.2f, %.2f, %.2f), %lu stances, %lu gaps\n",
+            path, stream.size(), position[0], position[1], position[2],
+            (unsigned long)stats.stances, (unsigned long)stats.gaps);
+    }
+    else {
+        srand(1);
+        dataset w, v;
+        w.name = "walk";
+        v.name = "vehicle";
+        walk(w);
+        vehicle(v);
+        report(w);
+        report(v);
+        stream = w.samples;
+    }
+
+    BNO055DeadReckoning dr;
+    float position[3];
+    size_t size = stream.size();
+    auto start = std::chrono::steady_clock::now();
+    for (long k = 0; k < count; k++) {
+        imuSnapshot& s = stream[k % size];
+        s.timestamp = (uint32_t)(k * SAMPLE_PERIOD);
+        dr.update(s);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    dr.getPosition(position);
+    printf("%ld samples, %.1f M samples/s, %.1f ns/sample (end x %.1f)\n",
+        count, count / seconds * 1e-6, seconds * 1e9 / count, position[0]);
+    return 0;
+}
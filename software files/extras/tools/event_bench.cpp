@@ -0,0 +1,84 @@
+// Host benchmark of BNO055EventDetector: plays a synthetic 100 Hz scenario (rest, slow
+// tilt and back, taps, flip to face down and back) through the detector, prints the
+// events, and then measures the throughput on a long stream.
+//
+// Build: g++ -O2 -I../../src event_bench.cpp ../../src/BNO055EventDetector.cpp -o event_bench
+// Usage: event_bench [-n samples]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "BNO055EventDetector.h"
+
+#define SAMPLE_PERIOD 10000
+
+static const char* eventNames[] = { "TILT_ENTER", "TILT_EXIT", "FACE_UP", "FACE_DOWN", "TAP", "STILL", "MOVING" };
+
+// orientation as a rotation of the gravity vector about the x-axis, plus optional impulse
+static void scenario(uint32_t k, imuSnapshot& s) {
+    double t = k * (SAMPLE_PERIOD * 1e-6);
+    double angle = 0;
+    double impulse = 0;
+    if(t >= 3 && t < 6) {
+        angle = 60.0 * sin(M_PI * (t - 3) / 3.0);
+    }
+    else if(t >= 9 && t < 12) {
+        angle = 180.0 * (t < 10 ? t - 9 : (t < 11 ? 1.0 : 12 - t));
+    }
+    if(k == 700 || k == 760) {
+        impulse = 30.0;
+    }
+    double rad = angle * M_PI / 180.0;
+    memset(&s, 0, sizeof(imuSnapshot));
+    s.timestamp = k * SAMPLE_PERIOD;
+    s.grv[1] = (float)(9.81 * sin(rad));
+    s.grv[2] = (float)(9.81 * cos(rad));
+    double noise = ((rand() % 1000) - 500) * 1e-4;
+    for (int i = 0; i < 3; i++) {
+        s.acc[i] = s.grv[i] + (float)noise;
+    }
+    s.acc[0] += (float)impulse;
+}
+
+int main(int argc, char** argv) {
+    long count = 10000000;
+    for (int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = atol(argv[++i]);
+        }
+    }
+
+    BNO055EventDetector detector;
+    imuSnapshot snapshot;
+    motionEvent event;
+    srand(1);
+    for (uint32_t k = 0; k < 1400; k++) {
+        scenario(k, snapshot);
+        detector.update(snapshot);
+        while (detector.pop(event)) {
+            printf("%7.2f s  %-10s %.3f\n", event.timestamp * 1e-6, eventNames[event.type], event.value);
+        }
+    }
+
+    static imuSnapshot stream[4096];
+    for (uint32_t k = 0; k < 4096; k++) {
+        scenario(k * 3, stream[k]);
+    }
+    detector.reset();
+    unsigned long events = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long k = 0; k < count; k++) {
+        imuSnapshot& s = stream[k & 4095];
+        s.timestamp = (uint32_t)(k * SAMPLE_PERIOD);
+        detector.update(s);
+        while (detector.pop(event)) {
+            events++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%ld samples, %lu events, %.1f M samples/s, %.1f ns/sample\n",
+        count, events, count / seconds * 1e-6, seconds * 1e9 / count);
+    return 0;
+}
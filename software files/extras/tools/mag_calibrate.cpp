@@ -0,0 +1,93 @@
+// Host batch tool: fits the magnetometer ellipsoid to recorded samples and prints the
+// hard-iron offsets, soft-iron scale factors and the MAG_OFFSET_*/MAG_RADIUS register values.
+//
+// Build: g++ -O2 -I../../src mag_calibrate.cpp ../../src/BNO055MagFit.cpp -o mag_calibrate
+// Usage: mag_calibrate [-c column] [-s spacing] [log.csv]
+//
+// The log is read as comma/space separated text; lines that do not contain three numbers
+// starting at the given column (default 0, values in uT as returned by getMagnetometer)
+// are skipped, so headers and other channels in the same log are fine.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "BNO055MagFit.h"
+
+#define QUALITY_BUFFER 4096
+
+static float buffer[QUALITY_BUFFER][3];
+
+static bool parseLine(char* line, int column, float* values) {
+    int index = 0;
+    int found = 0;
+    for (char* token = strtok(line, ",; \t\r\n"); token != NULL; token = strtok(NULL, ",; \t\r\n"), index++) {
+        if(index < column) {
+            continue;
+        }
+        char* end;
+        values[found] = strtof(token, &end);
+        if(end == token) {
+            return false;
+        }
+        if(++found == 3) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    int column = 0;
+    float spacing = 1.0f;
+    const char* path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            column = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            spacing = (float)atof(argv[++i]);
+        }
+        else {
+            path = argv[i];
+        }
+    }
+
+    FILE* input = path ? fopen(path, "r") : stdin;
+    if(input == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    BNO055MagFit magFit(buffer, QUALITY_BUFFER);
+    magFit.setMinSpacing(spacing);
+    char line[1024];
+    unsigned long lines = 0;
+    while (fgets(line, sizeof(line), input) != NULL) {
+        float values[3];
+        if(parseLine(line, column, values)) {
+            magFit.addSample(values[0], values[1], values[2]);
+            lines++;
+        }
+    }
+    if(input != stdin) {
+        fclose(input);
+    }
+
+    magFitResult result;
+    if(!magFit.fit(&result)) {
+        fprintf(stderr, "fit failed: %lu samples read, %u accepted\n", lines, (unsigned)result.samples);
+        return 2;
+    }
+
+    printf("samples      %lu read, %u accepted\n", lines, (unsigned)result.samples);
+    printf("offset (uT)  %.2f %.2f %.2f\n", result.offset[0], result.offset[1], result.offset[2]);
+    printf("scale        %.4f %.4f %.4f\n", result.scale[0], result.scale[1], result.scale[2]);
+    printf("radius (uT)  %.2f\n", result.radius);
+    printf("rms error    %.4f\n", result.rms);
+    printf("coverage     %d/8 octants\n", __builtin_popcount(result.coverage));
+    printf("MAG_OFFSET   %ld %ld %ld (add to current registers)\n",
+        lroundf(result.offset[0] * 16.0f), lroundf(result.offset[1] * 16.0f), lroundf(result.offset[2] * 16.0f));
+    printf("MAG_RADIUS   %ld\n", lroundf(result.radius * 16.0f));
+    return 0;
+}
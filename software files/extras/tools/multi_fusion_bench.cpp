@@ -0,0 +1,236 @@
+// Host benchmark of BNO055MultiFusion for N = 2..8 redundant sensors at 100 Hz. The rig
+// turns on smooth random-looking rates; sensor i is mounted in placement P(i mod 8) and
+// reports the rig attitude with 0.5° of noise per axis and a slow heading wander of its
+// own. Sensor 1 freezes from 20 s to 40 s (a stuck output while the rig keeps turning) and
+// then recovers. For every N the fused error against the truth is compared with a single
+// sensor, and the fault detection latency, the worst error during the fault, the
+// unattributed disagreements and the update time are printed. With two sensors the run is
+// repeated with sensor 1 at a lower calibration status, which is what allows attribution.
+//
+// Build: g++ -O2 -I../../src multi_fusion_bench.cpp ../../src/BNO055MultiFusion.cpp -o multi_fusion_bench
+// Usage: multi_fusion_bench [-s seconds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "BNO055MultiFusion.h"
+
+#define SAMPLE_PERIOD 10000
+#define NOISE_DEG 0.5
+#define FAULT_SENSOR 1
+#define FAULT_START 20.0
+#define FAULT_END 40.0
+
+static double gaussian() {
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static void multiply(const double* a, const double* b, double* out) {
+    double w = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+    double x = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+    double y = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+    double z = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+    out[0] = w;
+    out[1] = x;
+    out[2] = y;
+    out[3] = z;
+}
+
+// rotation by the vector v (radians, axis * angle)
+static void rotation(const double* v, double* q) {
+    double angle = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    double s = angle > 1e-12 ? sin(angle / 2) / angle : 0.5;
+    q[0] = cos(angle / 2);
+    q[1] = v[0] * s;
+    q[2] = v[1] * s;
+    q[3] = v[2] * s;
+}
+
+static double angleBetween(const double* a, const float* b) {
+    double d = fabs(a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+    return 2 * acos(d < 1 ? d : 1) * 180 / M_PI;
+}
+
+struct recording {
+    std::vector<double> truth;            // 4 per update
+    std::vector<imuSnapshot> snapshots;   // sensors per update
+};
+
+static void generate(uint8_t sensors, uint32_t updates, recording& r) {
+    srand(7);
+    r.truth.resize(4 * updates);
+    r.snapshots.resize((size_t)sensors * updates);
+    double q[4] = { 1, 0, 0, 0 };
+    double phase[3] = { 0.3, 1.7, 2.9 };
+    double wander[MULTI_FUSION_MAX_SENSORS];
+    for (uint8_t i = 0; i < sensors; i++) {
+        wander[i] = 0;
+    }
+    for (uint32_t k = 0; k < updates; k++) {
+        double t = k * SAMPLE_PERIOD * 1e-6;
+        double rate[3];
+        for (int a = 0; a < 3; a++) {
+            rate[a] = (40 + 20 * a) * M_PI / 180 * sin(0.3 * (a + 1) * t + phase[a]) * SAMPLE_PERIOD * 1e-6;
+        }
+        double step[4], next[4];
+        rotation(rate, step);
+        multiply(q, step, next);
+        double n = sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+        for (int c = 0; c < 4; c++) {
+            q[c] = next[c] / n;
+            r.truth[4 * k + c] = q[c];
+        }
+        for (uint8_t i = 0; i < sensors; i++) {
+            imuSnapshot& s = r.snapshots[(size_t)k * sensors + i];
+            bool stuck = i == FAULT_SENSOR && t >= FAULT_START && t < FAULT_END;
+            if(stuck) {
+                s = r.snapshots[(size_t)(k - 1) * sensors + i];
+                s.timestamp = k * SAMPLE_PERIOD + 50 * i;
+                continue;
+            }
+            memset(&s, 0, sizeof(imuSnapshot));
+            s.timestamp = k * SAMPLE_PERIOD + 50 * i;   // sequential reads on one bus
+            wander[i] += 0.002 * gaussian();
+            double error[3] = { NOISE_DEG * M_PI / 180 * gaussian(), NOISE_DEG * M_PI / 180 * gaussian(),
+                                NOISE_DEG * M_PI / 180 * gaussian() + wander[i] * M_PI / 180 };
+            double e[4], noisy[4], sensor[4];
+            rotation(error, e);
+            multiply(e, q, noisy);
+            // the sensor frame is the rig frame rotated by the mounting: q_sensor = q_rig ⊗ m
+            BNO055Remap::AxisRemap remap((AxisPlacement)(i % 8));
+            double m[4] = { remap.r[0], remap.r[1], remap.r[2], remap.r[3] };
+            multiply(noisy, m, sensor);
+            for (int c = 0; c < 4; c++) {
+                s.qua[c] = (float)sensor[c];
+            }
+        }
+    }
+}
+
+struct result {
+    double rms;
+    double single;
+    double worst;
+    double latency;
+    multiFusionStats stats;
+};
+
+static void mount(BNO055MultiFusion& fusion, uint8_t sensors) {
+    for (uint8_t i = 0; i < sensors; i++) {
+        fusion.setMounting(i, BNO055Remap::AxisRemap((AxisPlacement)(i % 8)));
+    }
+}
+
+static void replay(const recording& r, uint8_t sensors, uint32_t updates, const sensorHealth* health, result& out) {
+    BNO055MultiFusion fusion;
+    mount(fusion, sensors);
+    double sum = 0, singleSum = 0;
+    uint32_t valid = 0, clean = 0;
+    out.worst = 0;
+    out.latency = -1;
+    fusedAttitude attitude;
+    for (uint32_t k = 0; k < updates; k++) {
+        const double* truth = &r.truth[4 * k];
+        const imuSnapshot* set = &r.snapshots[(size_t)k * sensors];
+        double t = k * SAMPLE_PERIOD * 1e-6;
+        if(!fusion.update(set, health, sensors, attitude)) {
+            continue;
+        }
+        double e = angleBetween(truth, attitude.qua);
+        valid++;
+        sum += e * e;
+        bool fault = t >= FAULT_START && t < FAULT_END;
+        if(fault && e > out.worst) {
+            out.worst = e;
+        }
+        if(fault && out.latency < 0 && ((attitude.excluded >> FAULT_SENSOR) & 0x01)) {
+            out.latency = (t - FAULT_START) * 1000;
+        }
+        if(!fault) {
+            // sensor 0 alone, rotated back into the rig frame
+            BNO055Remap::AxisRemap remap(AXIS_PLACEMENT_P0);
+            float single[4];
+            remap.quaternion(set[0].qua, single);
+            double s = angleBetween(truth, single);
+            singleSum += s * s;
+            clean++;
+        }
+    }
+    out.rms = valid ? sqrt(sum / valid) : 0;
+    out.single = clean ? sqrt(singleSum / clean) : 0;
+    fusion.getStats(&out.stats);
+}
+
+static double timeUpdates(const recording& r, uint8_t sensors, uint32_t updates) {
+    BNO055MultiFusion fusion;
+    mount(fusion, sensors);
+    fusedAttitude attitude;
+    uint32_t passes = 20;
+    uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t p = 0; p < passes; p++) {
+        fusion.reset();
+        for (uint32_t k = 0; k < updates; k++) {
+            sink += fusion.update(&r.snapshots[(size_t)k * sensors], NULL, sensors, attitude);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(sink == 0) {
+        printf("(no valid output)\n");
+    }
+    return seconds / ((double)passes * updates) * 1e9;
+}
+
+int main(int argc, char** argv) {
+    double seconds = 60;
+    for (int i = 1; i + 1 < argc; i++) {
+        if(strcmp(argv[i], "-s") == 0) {
+            seconds = atof(argv[++i]);
+        }
+    }
+    if(seconds <= FAULT_END) {
+        seconds = FAULT_END + 10;
+    }
+    uint32_t updates = (uint32_t)(seconds * 1e6 / SAMPLE_PERIOD);
+
+    sensorHealth health[MULTI_FUSION_MAX_SENSORS];
+    memset(health, 0, sizeof(health));
+    for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+        health[i].calSys = 3;
+        health[i].calGyro = 3;
+        health[i].status = SYSTEM_STATUS_FUSION_RUNNING;
+    }
+
+    printf("%.0f s at 100 Hz, sensor %d stuck from %.0f s to %.0f s, %.1f deg noise per axis\n\n",
+        seconds, FAULT_SENSOR, FAULT_START, FAULT_END, NOISE_DEG);
+    printf(" N  rms err  single  worst in fault  detected  disagree  excluded  readmitted  ns/update  CPU at 100 Hz\n");
+    for (uint8_t n = 2; n <= MULTI_FUSION_MAX_SENSORS; n++) {
+        recording r;
+        generate(n, updates, r);
+        for (int variant = 0; variant < (n == 2 ? 2 : 1); variant++) {
+            health[FAULT_SENSOR].calSys = variant == 1 ? 2 : 3;
+            result res;
+            replay(r, n, updates, health, res);
+            double ns = timeUpdates(r, n, updates);
+            char detected[16];
+            if(res.latency >= 0) {
+                snprintf(detected, sizeof(detected), "%.0f ms", res.latency);
+            }
+            else {
+                snprintf(detected, sizeof(detected), "no");
+            }
+            printf("%2d%s %6.2f   %6.2f   %9.2f     %8s  %8lu  %8lu  %10lu  %9.0f  %11.4f%%\n",
+                n, variant == 1 ? "*" : " ", res.rms, res.single, res.worst, detected,
+                (unsigned long)res.stats.disagreements, (unsigned long)res.stats.exclusions,
+                (unsigned long)res.stats.recoveries, ns, ns / (SAMPLE_PERIOD * 1e3) * 100);
+        }
+        health[FAULT_SENSOR].calSys = 3;
+    }
+    printf("\nerrors in degrees; * = sensor %d at calSys 2. rms err counts valid outputs only.\n", FAULT_SENSOR);
+    return 0;
+}
@@ -0,0 +1,321 @@
+// Compares two register dumps printed by BNO055::printRegisterImage() and reports the
+// changed fields by name, e.g. to find what differs between a working and a failing unit
+// or before and after a configuration step. Any other lines of the serial logs are
+// skipped; the last dump of each file is used. Measurements, status and trigger bits are
+// left out unless --all is given. --plan prints the bursts restoreRegisters() would write
+// to bring the first unit to the configuration of the second.
+//
+// With --self-test the tool checks the field table against the image layout, and runs
+// BNO055RegisterMap::planRestore on random images against a simulated register file:
+// after applying the bursts every restorable field must match the target and no other
+// bit may have changed.
+//
+// Build: g++ -O2 -I../../src register_diff.cpp ../../src/BNO055RegisterMap.cpp -o register_diff
+// Usage: register_diff before.txt after.txt [--all] [--plan] | register_diff --self-test
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BNO055RegisterMap.h"
+
+// I2C bytes per transaction besides the data: address + register, repeated start + address
+#define I2C_OVERHEAD 3
+
+static bool readDump(const char* path, registerImage& image) {
+    FILE* input = fopen(path, "r");
+    if(input == NULL) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    char line[256];
+    bool found = false;
+    bool inDump = false;
+    unsigned int filled = 0;
+    registerImage parsed;
+    while (fgets(line, sizeof(line), input) != NULL) {
+        if(strncmp(line, "# BNO055 registers", 18) == 0) {
+            memset(&parsed, 0, sizeof(parsed));
+            filled = 0;
+            inDump = true;
+            continue;
+        }
+        unsigned int page, address;
+        int used;
+        if(!inDump || sscanf(line, "%u %x:%n", &page, &address, &used) != 2) {
+            continue;
+        }
+        const char* p = line + used;
+        unsigned int value;
+        int step;
+        while (sscanf(p, "%x%n", &value, &step) == 1) {
+            uint8_t* byte = BNO055RegisterMap::locate(&parsed, page, address++);
+            if(byte != NULL) {
+                *byte = (uint8_t)value;
+                filled++;
+            }
+            p += step;
+        }
+        if(filled == sizeof(registerImage)) {
+            image = parsed;
+            found = true;
+            inDump = false;
+        }
+    }
+    fclose(input);
+    if(!found) {
+        fprintf(stderr, "no complete register dump in %s\n", path);
+    }
+    return found;
+}
+
+static void printValue(const registerField& field, uint16_t value) {
+    if(field.flags & REGISTER_FIELD_SIGNED) {
+        printf("%6d", (int16_t)value);
+    }
+    else {
+        printf("  0x%02X", value);
+    }
+}
+
+static void printDiff(const registerImage& before, const registerImage& after, bool all) {
+    registerChange changes[256];
+    uint8_t count = BNO055RegisterMap::diff(&before, &after, changes, 255, all);
+    if(count == 0) {
+        printf("no changed fields\n");
+        return;
+    }
+    printf("field              page  reg   before   after\n");
+    for (uint8_t i = 0; i < count; i++) {
+        registerField field;
+        BNO055RegisterMap::getField(changes[i].field, &field);
+        printf("%-18s %4u  0x%02X ", field.name, field.page, field.address);
+        printValue(field, changes[i].before);
+        printf("  ");
+        printValue(field, changes[i].after);
+        printf("%s\n", (field.flags & REGISTER_FIELD_WRITABLE) ? "" : "   (read-only)");
+    }
+}
+
+static void printPlan(const registerImage& current, const registerImage& target) {
+    registerImage values = current;
+    registerBurst bursts[REGISTER_MAX_BURSTS];
+    uint8_t count = BNO055RegisterMap::planRestore(&current, &target, bursts, &values);
+    unsigned int bytes = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        bytes += bursts[i].length + I2C_OVERHEAD;
+        printf("page %u 0x%02X..0x%02X:", bursts[i].page, bursts[i].start, bursts[i].start + bursts[i].length - 1);
+        for (uint8_t j = 0; j < bursts[i].length; j++) {
+            printf(" %02X", *BNO055RegisterMap::locate(&values, bursts[i].page, bursts[i].start + j));
+        }
+        printf("\n");
+    }
+    printf("%u bursts, %u bytes on I2C, then the operation mode\n", count, bytes);
+}
+
+// restorable bits of every register, from the table
+static void restorableMasks(registerImage& masks, registerImage& writeOnly) {
+    memset(&masks, 0, sizeof(masks));
+    memset(&writeOnly, 0, sizeof(writeOnly));
+    for (uint8_t i = 0; i < BNO055RegisterMap::fieldCount(); i++) {
+        registerField field;
+        BNO055RegisterMap::getField(i, &field);
+        if((field.flags & (REGISTER_FIELD_WRITABLE | REGISTER_FIELD_NO_RESTORE)) != REGISTER_FIELD_WRITABLE) {
+            continue;
+        }
+        for (uint8_t b = 0; b < field.width; b++) {
+            *BNO055RegisterMap::locate(&masks, field.page, field.address + b) |= (uint8_t)(field.mask >> (8 * b));
+            *BNO055RegisterMap::locate(&writeOnly, field.page, field.address + b) |= (field.flags & REGISTER_FIELD_WRITE_ONLY) ? 0xFF : 0;
+        }
+    }
+}
+
+static bool checkTable() {
+    bool ok = true;
+    registerImage used;
+    memset(&used, 0, sizeof(used));
+    registerField previous;
+    memset(&previous, 0, sizeof(previous));
+    for (uint8_t i = 0; i < BNO055RegisterMap::fieldCount(); i++) {
+        registerField field;
+        BNO055RegisterMap::getField(i, &field);
+        if(i > 0 && (field.page < previous.page || (field.page == previous.page && field.address < previous.address))) {
+            printf("FAIL: %s is out of order\n", field.name);
+            ok = false;
+        }
+        for (uint8_t b = 0; b < field.width; b++) {
+            uint8_t* byte = BNO055RegisterMap::locate(&used, field.page, field.address + b);
+            uint8_t mask = (uint8_t)(field.mask >> (8 * b));
+            if(byte == NULL) {
+                printf("FAIL: %s lies outside the image\n", field.name);
+                ok = false;
+            }
+            else if(*byte & mask) {
+                printf("FAIL: %s overlaps another field\n", field.name);
+                ok = false;
+            }
+            else {
+                *byte |= mask;
+            }
+        }
+        for (uint8_t j = 0; j < i; j++) {
+            registerField other;
+            BNO055RegisterMap::getField(j, &other);
+            if(strcmp(other.name, field.name) == 0) {
+                printf("FAIL: %s is listed twice\n", field.name);
+                ok = false;
+            }
+        }
+        previous = field;
+    }
+    printf("field table: %u fields, %zu bytes\n", BNO055RegisterMap::fieldCount(),
+        BNO055RegisterMap::fieldCount() * sizeof(registerField));
+    return ok;
+}
+
+static void randomImage(registerImage& image) {
+    uint8_t* bytes = (uint8_t*)&image;
+    for (size_t i = 0; i < sizeof(image); i++) {
+        bytes[i] = (uint8_t)rand();
+    }
+}
+
+static bool selfTest() {
+    bool ok = checkTable();
+    registerImage masks, writeOnly;
+    restorableMasks(masks, writeOnly);
+    const uint8_t* m = (const uint8_t*)&masks;
+    const uint8_t* w = (const uint8_t*)&writeOnly;
+
+    unsigned int maxBursts = 0, trials = 100000;
+    unsigned long bursts = 0;
+    for (unsigned int t = 0; t < trials; t++) {
+        registerImage current, target;
+        randomImage(current);
+        target = current;
+        // change a few random bytes, or everything
+        uint8_t* bytes = (uint8_t*)&target;
+        unsigned int changes = (t % 10 == 0) ? sizeof(target) : 1 + rand() % 6;
+        for (unsigned int c = 0; c < changes; c++) {
+            bytes[rand() % sizeof(target)] = (uint8_t)rand();
+        }
+
+        registerImage values = current;
+        registerBurst plan[REGISTER_MAX_BURSTS];
+        uint8_t count = BNO055RegisterMap::planRestore(&current, &target, plan, &values);
+        maxBursts = count > maxBursts ? count : maxBursts;
+        bursts += count;
+
+        // the simulated register file; write-only registers read back as written
+        registerImage device = current;
+        for (uint8_t i = 0; i < count; i++) {
+            for (uint8_t j = 0; j < plan[i].length; j++) {
+                uint8_t address = plan[i].start + j;
+                uint8_t mask = *BNO055RegisterMap::locate(&masks, plan[i].page, address);
+                if(mask == 0) {
+                    printf("FAIL: burst writes non-restorable register %u/0x%02X\n", plan[i].page, address);
+                    return false;
+                }
+                *BNO055RegisterMap::locate(&device, plan[i].page, address) = *BNO055RegisterMap::locate(&values, plan[i].page, address);
+            }
+        }
+        const uint8_t* d = (const uint8_t*)&device;
+        const uint8_t* c = (const uint8_t*)&current;
+        const uint8_t* g = (const uint8_t*)&target;
+        for (size_t i = 0; i < sizeof(registerImage); i++) {
+            uint8_t keep = w[i] ? 0 : (uint8_t)~m[i];
+            bool restored = ((d[i] ^ g[i]) & m[i]) == 0;
+            bool untouched = ((d[i] ^ c[i]) & keep) == 0;
+            if(!restored || !untouched) {
+                printf("FAIL: byte %zu: current %02X target %02X device %02X\n", i, c[i], g[i], d[i]);
+                return false;
+            }
+        }
+        // nothing to do must mean no write at all
+        registerImage same = current;
+        if(BNO055RegisterMap::planRestore(&current, &same, plan, &values) != 0) {
+            printf("FAIL: identical images produce writes\n");
+            return false;
+        }
+    }
+    // worst case: a changed register at the start of every writable run and then after
+    // each gap just too long to write along
+    registerImage current, target;
+    memset(&current, 0, sizeof(current));
+    target = current;
+    for (uint8_t page = 0; page < 2; page++) {
+        uint8_t first = page == 0 ? 0 : REGISTER_PAGE1_START;
+        uint8_t end = first + (page == 0 ? REGISTER_PAGE0_SIZE : REGISTER_PAGE1_SIZE);
+        int last = -100;
+        for (uint8_t address = first; address < end; address++) {
+            uint8_t mask = *BNO055RegisterMap::locate(&masks, page, address);
+            if(mask == 0) {
+                last = -100;
+            }
+            else if(address - last > REGISTER_BURST_GAP + 1) {
+                *BNO055RegisterMap::locate(&target, page, address) = mask;
+                last = address;
+            }
+        }
+    }
+    registerImage values = current;
+    registerBurst plan[REGISTER_MAX_BURSTS];
+    uint8_t worst = BNO055RegisterMap::planRestore(&current, &target, plan, &values);
+    printf("restore plan: worst case %u bursts\n", worst);
+    maxBursts = worst > maxBursts ? worst : maxBursts;
+
+    if(maxBursts > 14) {
+        printf("FAIL: %u bursts exceed the documented worst case\n", maxBursts);
+        ok = false;
+    }
+    printf("restore plan: %u random trials, %.2f bursts on average, at most %u (limit %d)\n",
+        trials, (double)bursts / trials, maxBursts, REGISTER_MAX_BURSTS);
+
+    // bus traffic of a dump against one transaction per register, both with two page
+    // switches (address, PAGE_ID, value); the bursts are split at the 32-byte Wire buffer
+    unsigned int transfers = (REGISTER_PAGE0_SIZE + 31) / 32 + (REGISTER_PAGE1_SIZE + 31) / 32;
+    unsigned int burst = sizeof(registerImage) + transfers * I2C_OVERHEAD + 2 * 3;
+    unsigned int single = sizeof(registerImage) * (1 + I2C_OVERHEAD) + 2 * 3;
+    printf("dump: %u I2C bytes in two bursts against %u one register at a time (%.1f ms vs %.1f ms at 400 kHz)\n",
+        burst, single, burst * 9 / 400.0, single * 9 / 400.0);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    const char* paths[2] = { NULL, NULL };
+    bool all = false, plan = false, test = false;
+    int count = 0;
+    for (int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--all") == 0) {
+            all = true;
+        }
+        else if(strcmp(argv[i], "--plan") == 0) {
+            plan = true;
+        }
+        else if(strcmp(argv[i], "--self-test") == 0) {
+            test = true;
+        }
+        else if(count < 2) {
+            paths[count++] = argv[i];
+        }
+    }
+    if(test) {
+        srand(11);
+        bool ok = selfTest();
+        printf(ok ? "all checks passed\n" : "checks FAILED\n");
+        return ok ? 0 : 1;
+    }
+    if(count < 2) {
+        fprintf(stderr, "usage: register_diff before.txt after.txt [--all] [--plan] | register_diff --self-test\n");
+        return 1;
+    }
+    registerImage before, after;
+    if(!readDump(paths[0], before) || !readDump(paths[1], after)) {
+        return 1;
+    }
+    printDiff(before, after, all);
+    if(plan) {
+        printf("\n");
+        printPlan(before, after);
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Host benchmark of BNO055Resampler: feeds a synthetic 100 Hz stream with timestamp jitter
+// through the streaming and the batch interface and prints the throughput and the error
+// against the exact signal for each interpolation mode and output rate.
+//
+// Build: g++ -O2 -I../../src resample_bench.cpp ../../src/BNO055Resampler.cpp -o resample_bench
+// Usage: resample_bench [-n samples] [-j jitter_us]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "BNO055Resampler.h"
+
+#define INPUT_PERIOD 10000
+#define MAX_SAMPLES 200000
+
+static imuSnapshot input[MAX_SAMPLES];
+static imuSnapshot output[MAX_SAMPLES * 2];
+
+static void exact(double t, imuSnapshot& s) {
+    double w = 2.0 * M_PI * 1.3;
+    for (int i = 0; i < 3; i++) {
+        double phase = w * t + i;
+        s.acc[i] = (float)(9.81 * sin(phase));
+        s.mag[i] = (float)(40.0 * cos(phase));
+        s.gyr[i] = (float)(90.0 * sin(2.0 * phase));
+        s.lia[i] = (float)(2.0 * sin(3.0 * phase));
+        s.grv[i] = (float)(9.81 * cos(phase));
+    }
+    double heading = fmod(100.0 * t, 360.0);
+    s.eul[0] = (float)heading;
+    s.eul[1] = (float)(30.0 * sin(w * t));
+    s.eul[2] = (float)(20.0 * cos(w * t));
+    double angle = 0.5 * 2.0 * M_PI * 0.4 * t;
+    s.qua[0] = (float)cos(angle);
+    s.qua[1] = (float)(sin(angle) * 0.6);
+    s.qua[2] = (float)(sin(angle) * 0.8);
+    s.qua[3] = 0.0f;
+    s.temp = 25.0f;
+}
+
+static void measure(const char* label, uint32_t rateNum, uint32_t rateDen, InterpolationMode mode, size_t count) {
+    BNO055Resampler resampler(rateNum, rateDen, mode);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t produced = 0;
+    for (size_t i = 0; i < count; i++) {
+        resampler.push(input[i]);
+        while (produced < MAX_SAMPLES * 2 && resampler.pop(output[produced])) {
+            produced++;
+        }
+    }
+    double stream = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    size_t batch = resampler.resample(input, count, output, MAX_SAMPLES * 2);
+    double offline = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    double vecErr = 0;
+    double eulErr = 0;
+    double quaErr = 0;
+    for (size_t k = 0; k < batch; k++) {
+        imuSnapshot truth;
+        exact(output[k].timestamp * 1e-6, truth);
+        for (int i = 0; i < 3; i++) {
+            vecErr = fmax(vecErr, fabs(output[k].acc[i] - truth.acc[i]));
+            double d = fabs(output[k].eul[i] - truth.eul[i]);
+            eulErr = fmax(eulErr, fmin(d, 360.0 - d));
+        }
+        double dot = 0;
+        double chord = 0;
+        for (int i = 0; i < 4; i++) {
+            dot += output[k].qua[i] * truth.qua[i];
+        }
+        for (int i = 0; i < 4; i++) {
+            double d = output[k].qua[i] - (dot < 0 ? -truth.qua[i] : truth.qua[i]);
+            chord += d * d;
+        }
+        quaErr = fmax(quaErr, 4.0 * asin(fmin(1.0, sqrt(chord) * 0.5)) * 180.0 / M_PI);
+    }
+
+    printf("%-8s %-6s %8zu out  stream %6.1f ns/out  batch %6.1f ns/out  acc %.4f  eul %.4f deg  qua %.4f deg\n",
+        label, mode == INTERPOLATION_CUBIC ? "cubic" : "linear", batch,
+        stream / (produced ? produced : 1), offline / (batch ? batch : 1), vecErr, eulErr, quaErr);
+}
+
+int main(int argc, char** argv) {
+    size_t count = 100000;
+    long jitter = 2000;
+    for (int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = (size_t)atol(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            jitter = atol(argv[++i]);
+        }
+    }
+    if(count > MAX_SAMPLES) {
+        count = MAX_SAMPLES;
+    }
+
+    srand(1);
+    uint32_t time = 1000000;
+    for (size_t i = 0; i < count; i++) {
+        long offset = jitter > 0 ? (rand() % (2 * jitter + 1)) - jitter : 0;
+        input[i].timestamp = time + (uint32_t)offset;
+        exact(input[i].timestamp * 1e-6, input[i]);
+        time += INPUT_PERIOD;
+    }
+
+    printf("%zu input samples at 100 Hz, +-%ld us jitter\n", count, jitter);
+    measure("100 Hz", 100, 1, INTERPOLATION_LINEAR, count);
+    measure("100 Hz", 100, 1, INTERPOLATION_CUBIC, count);
+    measure("29.97 Hz", 30000, 1001, INTERPOLATION_LINEAR, count);
+    measure("29.97 Hz", 30000, 1001, INTERPOLATION_CUBIC, count);
+    measure("250 Hz", 250, 1, INTERPOLATION_LINEAR, count);
+    measure("250 Hz", 250, 1, INTERPOLATION_CUBIC, count);
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Host stress test and reader latency benchmark of BNO055StateCache: one owner thread
+// publishes snapshots as fast as it can while several reader threads copy them and check
+// that every copy is consistent (all fields belong to the same publication). Prints the
+// number of reads, torn copies (must be 0), retries and the reader latency percentiles.
+//
+// Build: g++ -O2 -pthread -I../../src state_cache_stress.cpp ../../src/BNO055StateCache.cpp -o state_cache_stress
+// Usage: state_cache_stress [-r readers] [-t seconds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "BNO055StateCache.h"
+
+#define LATENCY_SAMPLES 100000
+
+struct readerResult {
+    unsigned long reads;
+    unsigned long torn;
+    unsigned long retries;
+    std::vector<double> latency;
+};
+
+static BNO055StateCache cache;
+static std::atomic<bool> running(true);
+
+static void fill(imuSnapshot& s, uint32_t counter) {
+    s.timestamp = counter;
+    float* values = &s.acc[0];
+    for (size_t i = 0; i < (sizeof(imuSnapshot) - sizeof(uint32_t)) / sizeof(float); i++) {
+        values[i] = (float)(counter % 1000000) + (float)i * 0.5f;
+    }
+}
+
+static bool consistent(const imuSnapshot& s) {
+    imuSnapshot expected;
+    fill(expected, s.timestamp);
+    return memcmp(&expected, &s, sizeof(imuSnapshot)) == 0;
+}
+
+static void owner(unsigned long* published) {
+    imuSnapshot snapshot;
+    uint32_t counter = 1;
+    while (running.load(std::memory_order_relaxed)) {
+        fill(snapshot, counter++);
+        cache.publish(snapshot);
+    }
+    *published = counter - 1;
+}
+
+static void reader(readerResult* result) {
+    imuSnapshot copy;
+    result->latency.reserve(LATENCY_SAMPLES);
+    while (running.load(std::memory_order_relaxed)) {
+        auto start = std::chrono::steady_clock::now();
+        while (!cache.tryRead(copy)) {
+            result->retries++;
+        }
+        auto end = std::chrono::steady_clock::now();
+        if(result->latency.size() < LATENCY_SAMPLES) {
+            result->latency.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        result->reads++;
+        if(copy.timestamp != 0 && !consistent(copy)) {
+            result->torn++;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int readers = 4;
+    double seconds = 2.0;
+    for (int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            readers = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        }
+    }
+
+    std::vector<readerResult> results(readers);
+    std::vector<std::thread> threads;
+    unsigned long published = 0;
+    threads.push_back(std::thread(owner, &published));
+    for (int i = 0; i < readers; i++) {
+        results[i] = readerResult();
+        threads.push_back(std::thread(reader, &results[i]));
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    running = false;
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    unsigned long reads = 0;
+    unsigned long torn = 0;
+    unsigned long retries = 0;
+    std::vector<double> latency;
+    for (int i = 0; i < readers; i++) {
+        reads += results[i].reads;
+        torn += results[i].torn;
+        retries += results[i].retries;
+        latency.insert(latency.end(), results[i].latency.begin(), results[i].latency.end());
+    }
+    std::sort(latency.begin(), latency.end());
+    size_t n = latency.size();
+
+    printf("published    %lu\n", published);
+    printf("reads        %lu (%d readers)\n", reads, readers);
+    printf("torn copies  %lu\n", torn);
+    printf("retries      %lu\n", retries);
+    if(n > 0) {
+        printf("latency ns   p50 %.0f  p99 %.0f  p99.9 %.0f  max %.0f\n",
+            latency[n / 2], latency[n * 99 / 100], latency[n * 999 / 1000], latency[n - 1]);
+    }
+    return torn == 0 ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+// Runs BNO055SyncCapture against a simulated bus. Every sensor sits on a bus of its own
+// speed (I2C at 100 or 400 kHz, UART at 115200 baud) and a read advances a simulated
+// clock by the length of the transaction, plus random delays from interrupts on the host.
+// The simulated sensors turn about z at a known rate and latch their data at the middle of
+// each transfer, so the tool knows the true sample time of every snapshot and checks:
+//  - that the skew tagged on each snapshot matches the true sample time;
+//  - the spread against reading full snapshots one after the other, and against reading
+//    the critical block in a fixed order;
+//  - the heading disagreement between the sensors with and without compensating the skew
+//    with the gyro rate;
+//  - that failed transfers are counted and leave the other sensors valid.
+// Exits with 1 if a check fails.
+//
+// Build: g++ -O2 -I../../src sync_capture_sim.cpp ../../src/BNO055SyncCapture.cpp ../../src/BNO055Decode.cpp -o sync_capture_sim
+// Usage: sync_capture_sim [-n captures]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "BNO055SyncCapture.h"
+
+#define RATE_DPS 180.0      // turn rate of the simulated rig
+#define PERIOD 10000        // trigger period, us
+#define WIRE_OVERHEAD 20.0  // us per transaction in the bus driver
+#define INTERRUPT_DELAY 40  // longest host interrupt hitting a transfer, us
+
+struct simSensor {
+    const char* bus;
+    double bitTime;      // us
+    bool uart;
+    double failRate;
+    double lastSample;   // true sample time of the last critical block, us
+};
+
+static double now = 0;   // simulated time, us
+
+static uint32_t simClock() {
+    return (uint32_t)now;
+}
+
+static double transferTime(const simSensor& s, uint8_t length) {
+    if(s.uart) {
+        // 4 byte request, 2 byte response header, 10 bits per byte
+        return WIRE_OVERHEAD + (6 + length) * 10 * s.bitTime;
+    }
+    // address and register, repeated start and address, then the data; 9 bits per byte
+    return WIRE_OVERHEAD + (3 + length) * 9 * s.bitTime;
+}
+
+static void put16(uint8_t* raw, uint8_t reg, double value) {
+    int16_t v = (int16_t)lround(value);
+    raw[reg - RAW_SNAPSHOT_START] = (uint8_t)(v & 0xFF);
+    raw[reg - RAW_SNAPSHOT_START + 1] = (uint8_t)((uint16_t)v >> 8);
+}
+
+static bool simRead(void* context, uint8_t reg, uint8_t* buffer, uint8_t length) {
+    simSensor& s = *(simSensor*)context;
+    now += (rand() % 100 < 5) ? rand() % INTERRUPT_DELAY : 0;   // an interrupt on the host
+    double duration = transferTime(s, length);
+    double sample = now + duration / 2;
+    now += duration;
+    if(rand() / (double)RAND_MAX < s.failRate) {
+        return false;
+    }
+    // the rig turns about z: quaternion (cos(a/2), 0, 0, sin(a/2)), gyro z constant
+    uint8_t raw[RAW_SNAPSHOT_SIZE];
+    memset(raw, 0, sizeof(raw));
+    double angle = RATE_DPS * M_PI / 180.0 * sample * 1e-6;
+    put16(raw, 0x20, cos(angle / 2) * 16384.0);
+    put16(raw, 0x26, sin(angle / 2) * 16384.0);
+    put16(raw, 0x18, RATE_DPS * 16.0);
+    memcpy(buffer, raw + (reg - RAW_SNAPSHOT_START), length);
+    if(reg <= 0x20 && reg + length >= 0x28) {
+        s.lastSample = sample;
+    }
+    return true;
+}
+
+// heading of a snapshot in degrees, optionally moved to the reference time
+static double heading(const imuSnapshot& s, int32_t skew, bool compensate) {
+    double h = 2 * atan2(s.qua[3], s.qua[0]) * 180.0 / M_PI;
+    if(compensate) {
+        h -= s.gyr[2] * skew * 1e-6;
+    }
+    return h;
+}
+
+static double wrap180(double a) {
+    while (a > 180) a -= 360;
+    while (a < -180) a += 360;
+    return a;
+}
+
+// spread of the midpoints when each sensor is read with one transfer in index order
+static double sequentialSpread(simSensor* sensors, uint8_t count, uint8_t length) {
+    double first = 0, last = 0, t = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        double d = transferTime(sensors[i], length);
+        if(i == 0) first = t + d / 2;
+        last = t + d / 2;
+        t += d;
+    }
+    return last - first;
+}
+
+static bool run(const char* name, simSensor* sensors, uint8_t count, long captures) {
+    BNO055SyncCapture sync(simClock);
+    for (uint8_t i = 0; i < count; i++) {
+        sync.addSensor(simRead, &sensors[i]);
+    }
+    double tagError = 0, raw = 0, compensated = 0;
+    long pairs = 0, invalid = 0, expectedFailures = 0;
+    bool ok = true;
+    for (long k = 0; k < captures; k++) {
+        now = k * (double)PERIOD + (rand() % 50);
+        sync.trigger();
+        now += 5 + rand() % 30;   // loop latency until poll
+        if(!sync.poll()) {
+            // a failed sensor; the others must still be usable
+            invalid++;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            if(!sync.isValid(i)) {
+                expectedFailures++;
+                continue;
+            }
+            double truth = sensors[i].lastSample - (double)sync.getReference();
+            double e = fabs(truth - sync.getSkew(i));
+            tagError = e > tagError ? e : tagError;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            for (uint8_t j = i + 1; j < count; j++) {
+                if(!sync.isValid(i) || !sync.isValid(j)) {
+                    continue;
+                }
+                const imuSnapshot& a = sync.getSnapshot(i);
+                const imuSnapshot& b = sync.getSnapshot(j);
+                double r = fabs(wrap180(heading(a, 0, false) - heading(b, 0, false)));
+                double c = fabs(wrap180(heading(a, sync.getSkew(i), true) - heading(b, sync.getSkew(j), true)));
+                raw = r > raw ? r : raw;
+                compensated = c > compensated ? c : compensated;
+                pairs++;
+            }
+        }
+    }
+    syncStats stats;
+    sync.getStats(&stats);
+
+    printf("%s\n", name);
+    printf("  spread (us): full snapshots in turn %.0f, critical block in index order %.0f, "
+           "sync mean %.0f max %lu\n", sequentialSpread(sensors, count, RAW_SNAPSHOT_SIZE),
+           sequentialSpread(sensors, count, SYNC_CRITICAL_SIZE), stats.meanSpread, (unsigned long)stats.maxSpread);
+    printf("  latency (us): max %lu   tagged skew error: max %.1f us\n", (unsigned long)stats.maxLatency, tagError);
+    printf("  heading disagreement at %.0f dps: raw %.4f deg, compensated %.4f deg (%ld pairs)\n",
+        RATE_DPS, raw, compensated, pairs);
+    printf("  captures %lu, failed transfers %lu, incomplete captures %ld\n",
+        (unsigned long)stats.captures, (unsigned long)stats.failures, invalid);
+
+    // an interrupt during a transfer moves the measured midpoint by half its length; the
+    // clock has 1 us resolution
+    if(tagError > INTERRUPT_DELAY / 2 + 2.0) {
+        printf("  FAIL: tagged skew does not match the sample time\n");
+        ok = false;
+    }
+    if(stats.captures != (uint32_t)captures || stats.failures < (uint32_t)expectedFailures) {
+        printf("  FAIL: statistics do not count every capture and failure\n");
+        ok = false;
+    }
+    if(count > 1 && compensated > raw) {
+        printf("  FAIL: compensation increased the disagreement\n");
+        ok = false;
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    long captures = 20000;
+    for (int i = 1; i + 1 < argc; i++) {
+        if(strcmp(argv[i], "-n") == 0) {
+            captures = atol(argv[++i]);
+        }
+    }
+    srand(7);
+    bool ok = true;
+
+    simSensor fast[3] = {
+        { "i2c 400k", 2.5, false, 0, 0 },
+        { "i2c 400k", 2.5, false, 0, 0 },
+        { "i2c 400k", 2.5, false, 0, 0 },
+    };
+    ok = run("three sensors, I2C 400 kHz", fast, 3, captures) && ok;
+
+    // the slow sensors are added in the middle, where they would count fully
+    simSensor mixed[4] = {
+        { "i2c 400k", 2.5, false, 0, 0 },
+        { "i2c 100k", 10.0, false, 0, 0 },
+        { "uart 115200", 1e6 / 115200, true, 0, 0 },
+        { "i2c 400k", 2.5, false, 0, 0 },
+    };
+    ok = run("mixed buses: 400 kHz, 100 kHz, UART, 400 kHz", mixed, 4, captures) && ok;
+
+    simSensor flaky[3] = {
+        { "i2c 400k", 2.5, false, 0, 0 },
+        { "i2c 400k", 2.5, false, 0.01, 0 },
+        { "i2c 400k", 2.5, false, 0, 0 },
+    };
+    ok = run("three sensors, 1% failed transfers on the second", flaky, 3, captures) && ok;
+
+    printf(ok ? "all checks passed\n" : "checks FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// Converts the text printed by BNO055Trace::dump() into a Chrome trace (JSON Trace Event
+// Format), which chrome://tracing and ui.perfetto.dev show as a flame chart. Any other
+// lines of the serial log are skipped, so a whole session log can be passed; consecutive
+// dumps are joined into one timeline. Counter values are unwrapped from 32 bits assuming
+// consecutive events are less than one wrap apart. An exit without its entry, left when
+// the ring overwrote the oldest events, is dropped.
+//
+// With --self-test the tool records nested scopes through BNO055Trace on the host (TSC
+// or CLOCK_MONOTONIC), measures the cost of a tracepoint and converts the result.
+//
+// Build: g++ -O2 -DBNO055_ENABLE_TRACE=1 -I../../src trace_to_chrome.cpp ../../src/BNO055Trace.cpp -o trace_to_chrome
+// Usage: trace_to_chrome [log.txt | --self-test] [-o trace.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "BNO055Trace.h"
+
+#define TRACE_MAX_DEPTH 64
+
+static const char* const transportNames[] = {
+#define BNO055_TRACE_NAME(id, name) name,
+    BNO055_TRACE_TRANSPORT(BNO055_TRACE_NAME)
+};
+static const char* const apiNames[] = {
+    BNO055_TRACE_API(BNO055_TRACE_NAME)
+#undef BNO055_TRACE_NAME
+};
+static const uint8_t transportCount = sizeof(transportNames) / sizeof(transportNames[0]);
+
+struct converter {
+    FILE* out;
+    double frequency;
+    uint64_t time;       // unwrapped counter
+    uint32_t last;
+    bool started;
+    uint8_t stack[TRACE_MAX_DEPTH];
+    uint8_t depth;
+    unsigned long events;
+    unsigned long unmatched;
+    unsigned long dropped;
+};
+
+static void writeEvent(converter& c, uint8_t point, char phase) {
+    char user[16];
+    const char* name;
+    const char* category;
+    if(point < transportCount) {
+        name = transportNames[point];
+        category = "transport";
+    }
+    else if(point < TRACE_POINT_COUNT) {
+        name = apiNames[point - transportCount];
+        category = "api";
+    }
+    else {
+        snprintf(user, sizeof(user), "user%u", point >= TRACE_USER ? point - TRACE_USER : point);
+        name = user;
+        category = "user";
+    }
+    fprintf(c.out, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":1}",
+        c.events ? "," : "", name, category, phase, c.time / c.frequency * 1e6);
+    c.events++;
+}
+
+static void addEvent(converter& c, uint32_t cycles, uint8_t point, uint8_t phase) {
+    if(c.started) {
+        c.time += (uint32_t)(cycles - c.last);
+    }
+    c.last = cycles;
+    c.started = true;
+    if(phase == TRACE_PHASE_BEGIN) {
+        if(c.depth < TRACE_MAX_DEPTH) {
+            c.stack[c.depth++] = point;
+        }
+        writeEvent(c, point, 'B');
+    }
+    else if(c.depth > 0 && c.stack[c.depth - 1] == point) {
+        c.depth--;
+        writeEvent(c, point, 'E');
+    }
+    else {
+        c.unmatched++;
+    }
+}
+
+// closes the scopes still open at the end of a dump
+static void closeOpen(converter& c) {
+    while (c.depth > 0) {
+        writeEvent(c, c.stack[--c.depth], 'E');
+    }
+}
+
+static bool convertLog(FILE* input, converter& c) {
+    char line[256];
+    bool found = false;
+    while (fgets(line, sizeof(line), input) != NULL) {
+        unsigned long hz, dropped;
+        if(sscanf(line, "# BNO055 trace %lu %lu", &hz, &dropped) == 2) {
+            closeOpen(c);
+            c.frequency = hz > 0 ? hz : 1e6;
+            c.dropped += dropped;
+            c.depth = 0;
+            found = true;
+            continue;
+        }
+        unsigned long cycles;
+        char phase;
+        unsigned int point;
+        if(found && sscanf(line, "%lu %c %u", &cycles, &phase, &point) == 3 && (phase == 'B' || phase == 'E') && point < 256) {
+            addEvent(c, (uint32_t)cycles, (uint8_t)point, phase == 'B' ? TRACE_PHASE_BEGIN : TRACE_PHASE_END);
+        }
+    }
+    closeOpen(c);
+    return found;
+}
+
+static volatile uint32_t sink;
+
+static void work(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        sink += i * i;
+    }
+}
+
+// a readSnapshot-shaped call tree: API entry, page select, burst read
+static void fakeRead() {
+    BNO055_TRACE_SCOPE(TRACE_READ_SNAPSHOT);
+    {
+        BNO055_TRACE_SCOPE(TRACE_SELECT_PAGE);
+        work(200);
+    }
+    {
+        BNO055_TRACE_SCOPE(TRACE_READ_BYTES);
+        work(2000);
+    }
+    work(300);
+}
+
+static void selfTest(converter& c, const char* path) {
+    // cost of one event, ring overwriting
+    BNO055Trace::start();
+    const uint32_t n = 10000000;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) {
+        BNO055Trace::record(TRACE_USER, TRACE_PHASE_BEGIN);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "record: %.1f ns per event, %lu dropped\n", seconds / n * 1e9, (unsigned long)BNO055Trace::getDropped());
+
+    BNO055Trace::start();
+    work(5000000);
+    for (int i = 0; i < 20; i++) {
+        fakeRead();
+        work(20000);
+    }
+    c.frequency = BNO055Trace::frequency();
+    fprintf(stderr, "counter: %.0f Hz, %u events in a %d-event ring\n", c.frequency, BNO055Trace::available(), BNO055_TRACE_SIZE);
+    BNO055Trace::stop();
+
+    // round trip through the dump format
+    FILE* dump = fopen(path, "w+");
+    if(dump == NULL) {
+        return;
+    }
+    fprintf(dump, "# BNO055 trace %lu %lu\n", (unsigned long)BNO055Trace::frequency(), (unsigned long)BNO055Trace::getDropped());
+    traceEvent event;
+    while (BNO055Trace::drain(&event, 1) == 1) {
+        fprintf(dump, "%lu %c %u\n", (unsigned long)event.cycles, event.phase == TRACE_PHASE_BEGIN ? 'B' : 'E', event.point);
+    }
+    rewind(dump);
+    convertLog(dump, c);
+    fclose(dump);
+    remove(path);
+}
+
+int main(int argc, char** argv) {
+    const char* inputPath = NULL;
+    const char* outputPath = NULL;
+    bool test = false;
+    for (int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        }
+        else if(strcmp(argv[i], "--self-test") == 0) {
+            test = true;
+        }
+        else {
+            inputPath = argv[i];
+        }
+    }
+
+    converter c;
+    memset(&c, 0, sizeof(c));
+    c.frequency = 1e6;
+    c.out = outputPath != NULL ? fopen(outputPath, "w") : stdout;
+    if(c.out == NULL) {
+        fprintf(stderr, "cannot open %s\n", outputPath);
+        return 1;
+    }
+    fprintf(c.out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    bool found = true;
+    if(test) {
+        selfTest(c, "trace_self_test.txt");
+    }
+    else {
+        FILE* input = inputPath != NULL ? fopen(inputPath, "r") : stdin;
+        if(input == NULL) {
+            fprintf(stderr, "cannot open %s\n", inputPath);
+            return 1;
+        }
+        found = convertLog(input, c);
+        if(input != stdin) {
+            fclose(input);
+        }
+    }
+    fprintf(c.out, "\n]}\n");
+    if(c.out != stdout) {
+        fclose(c.out);
+    }
+    if(!found) {
+        fprintf(stderr, "no trace dump found\n");
+        return 1;
+    }
+    fprintf(stderr, "%lu events, %lu unmatched exits, %lu dropped on the device\n", c.events, c.unmatched, c.dropped);
+    return 0;
+}
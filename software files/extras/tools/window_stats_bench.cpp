@@ -0,0 +1,171 @@
+// Host benchmark of BNO055WindowStats. A synthetic 100 Hz accelerometer stream (gravity on
+// z, noise, a vibration burst and slow drift) is fed through the sliding-window statistics
+// and every output is compared with a brute-force evaluation of the same window, both at
+// the start and at the end of a long stream, where rounding errors of the sliding update
+// would have accumulated. Then the per-sample cost is measured against the brute-force
+// O(window) loops for several window lengths.
+//
+// Build: g++ -O2 -I../../src window_stats_bench.cpp -o window_stats_bench
+// Usage: window_stats_bench [-n samples]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "BNO055WindowStats.h"
+
+#define SAMPLE_PERIOD 10000
+
+static const uint8_t accChannels[3] = { CHANNEL_ACC_X, CHANNEL_ACC_Y, CHANNEL_ACC_Z };
+
+static void sample(uint32_t k, imuSnapshot& s) {
+    double t = k * (SAMPLE_PERIOD * 1e-6);
+    double burst = fmod(t, 60.0) >= 30 && fmod(t, 60.0) < 32 ? 4.0 * sin(2 * M_PI * 25 * t) : 0;
+    memset(&s, 0, sizeof(imuSnapshot));
+    s.timestamp = k * SAMPLE_PERIOD;
+    for (int i = 0; i < 3; i++) {
+        double noise = ((rand() % 2001) - 1000) * 5e-5;
+        s.acc[i] = (float)(noise + 0.05 * sin(t / 600.0 + i) + (i == 2 ? 9.81 : 0) + (i == 0 ? burst : 0));
+    }
+}
+
+// brute force over the last window samples of one axis
+static void exact(const std::vector<float>& history, size_t end, size_t window, windowStats& out) {
+    size_t n = end < window ? end : window;
+    double sum = 0, squares = 0;
+    float low = history[end - n], high = history[end - n];
+    for (size_t i = end - n; i < end; i++) {
+        sum += history[i];
+        low = history[i] < low ? history[i] : low;
+        high = history[i] > high ? history[i] : high;
+    }
+    double mean = sum / n;
+    for (size_t i = end - n; i < end; i++) {
+        squares += (history[i] - mean) * (history[i] - mean);
+    }
+    out.mean = (float)mean;
+    out.variance = (float)(squares / n);
+    out.rms = (float)sqrt(squares / n + mean * mean);
+    out.min = low;
+    out.max = high;
+}
+
+struct errors {
+    double mean;
+    double variance;   // relative
+    double minMax;
+};
+
+template<uint16_t Window>
+static void verify(long count) {
+    BNO055WindowStats<3, Window> stats(accChannels);
+    std::vector<float> history[3];
+    for (int a = 0; a < 3; a++) {
+        history[a].reserve(count);
+    }
+    errors early = { 0, 0, 0 }, late = { 0, 0, 0 };
+    srand(3);
+    for (long k = 0; k < count; k++) {
+        imuSnapshot s;
+        sample((uint32_t)k, s);
+        stats.update(s);
+        for (int a = 0; a < 3; a++) {
+            history[a].push_back(s.acc[a]);
+        }
+        bool first = k < 100000;
+        if(!first && k < count - 100000) {
+            continue;
+        }
+        errors& e = first ? early : late;
+        for (int a = 0; a < 3; a++) {
+            windowStats got, want;
+            stats.getWindow(a, &got);
+            exact(history[a], k + 1, Window, want);
+            double dm = fabs(got.mean - want.mean);
+            double dv = fabs(got.variance - want.variance) / (want.variance > 1e-6 ? want.variance : 1e-6);
+            double dx = fabs(got.min - want.min) + fabs(got.max - want.max);
+            e.mean = dm > e.mean ? dm : e.mean;
+            e.variance = dv > e.variance ? dv : e.variance;
+            e.minMax = dx > e.minMax ? dx : e.minMax;
+        }
+    }
+    printf("%6u  %10.2e  %10.2e  %8.2e   %10.2e  %10.2e  %8.2e\n", Window,
+        early.mean, early.variance, early.minMax, late.mean, late.variance, late.minMax);
+}
+
+template<uint16_t Window>
+static void measure(const std::vector<imuSnapshot>& stream) {
+    BNO055WindowStats<3, Window> stats(accChannels);
+    float sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < stream.size(); k++) {
+        stats.update(stream[k]);
+        sink += stats.getTotalVariance() + stats.getMax(0) - stats.getMin(0);
+    }
+    double fast = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // the usual O(window) loops over a ring of the last samples
+    static float ring[3][Window];
+    start = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < stream.size(); k++) {
+        uint16_t slot = k % Window;
+        uint16_t n = k < Window ? k + 1 : Window;
+        float total = 0;
+        for (int a = 0; a < 3; a++) {
+            ring[a][slot] = stream[k].acc[a];
+            float sum = 0, squares = 0, low = ring[a][0], high = ring[a][0];
+            for (uint16_t i = 0; i < n; i++) {
+                sum += ring[a][i];
+                low = ring[a][i] < low ? ring[a][i] : low;
+                high = ring[a][i] > high ? ring[a][i] : high;
+            }
+            float mean = sum / n;
+            for (uint16_t i = 0; i < n; i++) {
+                squares += (ring[a][i] - mean) * (ring[a][i] - mean);
+            }
+            total += squares / n;
+            if(a == 0) {
+                total += high - low;
+            }
+        }
+        sink += total;
+    }
+    double slow = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%6u  %10.1f  %12.1f  %8.1fx  %9zu B\n", Window, fast / stream.size() * 1e9, slow / stream.size() * 1e9,
+        slow / fast, sizeof(stats));
+    if(sink == 12345.0f) {
+        printf("\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    long count = 2000000;
+    for (int i = 1; i + 1 < argc; i++) {
+        if(strcmp(argv[i], "-n") == 0) {
+            count = atol(argv[++i]);
+        }
+    }
+    if(count < 200000) {
+        count = 200000;
+    }
+
+    printf("accuracy against brute force, first and last 100000 of %ld samples\n", count);
+    printf("window  mean err    var rel err  min/max     mean err    var rel err  min/max\n");
+    verify<10>(count);
+    verify<100>(count);
+    verify<1000>(count);
+
+    std::vector<imuSnapshot> stream(count);
+    srand(5);
+    for (long k = 0; k < count; k++) {
+        sample((uint32_t)k, stream[k]);
+    }
+    printf("\nper-sample cost, 3 axes (ns)\n");
+    printf("window  sliding     brute force   speedup   state\n");
+    measure<10>(stream);
+    measure<100>(stream);
+    measure<1000>(stream);
+    return 0;
+}
@@ -1,10 +1,10 @@
 #include "BNO055.h"
-#include <SoftwareSerial.h>
 
-SoftwareSerial mySerial(21, 22);
+#ifdef BNO055_TRANSPORT_UART
+#include <SoftwareSerial.h>
 
-#define I2C
-//#define UART
+SoftwareSerial mySerial(BNO055_UART_RX_PIN, BNO055_UART_TX_PIN);
+#endif
 
 /**
  * @brief Constructor for BNO055 class.
@@ -12,8 +12,27 @@ SoftwareSerial mySerial(21, 22);
  * Initializes the BNO055 object with the sensor's I2C address.
  * 
  */
-BNO055::BNO055() {
-    address = 0x28; // BNO055 sensor's I2C address
+BNO055::BNO055() : BNO055(0x28) {
+}
+
+/**
+ * @brief Constructor for BNO055 class with a custom address and bus.
+ * 
+ * Use it for several sensors: two on one bus (0x28 and 0x29 via the COM3 pin) or more on further buses.
+ * 
+ * @param address The 7-bit I2C address, 0x28 or 0x29.
+ * @param wire The I2C bus the sensor is connected to.
+ */
+BNO055::BNO055(uint8_t address, TwoWire& wire) {
+    this->address = address;
+    this->wire = &wire;
+    powermode = POWERMODE_NORMAL;
+    page = 0xFF; // unknown until the first page write
+    unitSel = 0x80; // UNIT_SEL reset value
+    mode = OPERATION_MODE_CONFIG;
+    modeKnown = false; // unknown until the first mode write
+    modeReadyAt = 0;
+    modePending = false;
 }
 
 /**
@@ -24,31 +43,71 @@ BNO055::BNO055() {
  * @return True if the sensor is successfully initialized, false otherwise.
  */
 bool BNO055::begin() {
-    #ifdef I2C
-    Wire.begin();
+    BNO055_TRACE_SCOPE(TRACE_BEGIN);
+    #ifdef BNO055_TRANSPORT_I2C
+    wire->begin();
     setPage(0x00);
-    writeByte(0x3D, 0x00);
-    delay(50);
-    setPowerMode(PowerMode::POWERMODE_NORMAL);
-    delay(10);
+    modeKnown = false;
     setOperationMode(OperationMode::OPERATION_MODE_CONFIG);
-    delay(50);
+    waitModeReady();
+    setPowerMode(PowerMode::POWERMODE_NORMAL);
     return isReady();
     #endif
 
-    #ifdef UART
+    #ifdef BNO055_TRANSPORT_UART
     mySerial.begin(115200);
     setPage(0x00);
-    writeByte(0x3D, 0x00);
-    delay(30);
-    setPowerMode(PowerMode::POWERMODE_NORMAL);
-    delay(20);
+    modeKnown = false;
     setOperationMode(OperationMode::OPERATION_MODE_CONFIG);
-    delay(30);
+    waitModeReady();
+    setPowerMode(PowerMode::POWERMODE_NORMAL);
     return isReady();
     #endif
 }
 
+/**
+ * @brief Takes over a sensor that kept running through an MCU reset.
+ * 
+ * This function is used instead of begin() after the MCU restarted without the sensor being power-cycled, e.g. after a watchdog reset. It checks the chip ID and the health block, burst-reads the configuration image and compares its hash with the one stored after the last full configuration. If they match, the sensor keeps running in its current mode with its calibration and no reset, mode change or delay is needed. Otherwise the caller has to run begin() and the full configuration.
+ * 
+ * @param configHash The value returned by getConfigHash() after the sensor was last configured.
+ * @return True if the sensor is running with the expected configuration, false otherwise.
+ */
+bool BNO055::warmStart(uint32_t configHash) {
+    BNO055_TRACE_SCOPE(TRACE_WARM_START);
+    #ifdef BNO055_TRANSPORT_I2C
+    wire->begin();
+    #endif
+    #ifdef BNO055_TRANSPORT_UART
+    mySerial.begin(115200);
+    #endif
+    page = 0xFF; // unknown after the MCU reset
+    selectPage(0x00);
+    if(readByte(CHIP_ID) != 0xA0) {
+        return false;
+    }
+
+    sensorHealth health;
+    if(!readHealth(health)) {
+        return false;
+    }
+    if(!health.selfTestPassed || health.status == SYSTEM_STATUS_ERROR || health.error != SYSTEM_ERROR_NONE) {
+        return false;
+    }
+
+    configImage image;
+    if(!readConfigImage(&image) || hashConfigImage(&image) != configHash) {
+        return false;
+    }
+    unitSel = image.system[0];
+    mode = (OperationMode)(image.system[OPR_MODE - UNIT_SEL] & 0x0F);
+    modeKnown = true;
+    modeReadyAt = micros();
+    modePending = false;
+    powermode = (PowerMode)(image.system[PWR_MODE - UNIT_SEL] & 0x03);
+    return true;
+}
+
 /**
  * @brief Resets the BNO055 sensor.
  * 
@@ -56,11 +115,17 @@ bool BNO055::begin() {
  * 
  */
 void BNO055::reset() {
+    BNO055_TRACE_SCOPE(TRACE_RESET);
     setPage(0x00);
     writeByte(SYS_TRIGGER, 0x20);    
     delay(500);
     writeByte(SYS_TRIGGER, 0x00);
     delay(50);
+    page = 0x00;
+    mode = OPERATION_MODE_CONFIG;
+    modeKnown = true;
+    modeReadyAt = micros();
+    modePending = false;
 }
 
 /**
@@ -71,7 +136,8 @@ void BNO055::reset() {
  * @return True if the sensor is ready, false otherwise.
  */
 bool BNO055::isReady() {
-    setPage(0x00);
+    BNO055_TRACE_SCOPE(TRACE_IS_READY);
+    selectPage(0x00);
     uint8_t selfTest = readByte(SELFTEST_RESULT);
 
     return (selfTest & 0x0F);
@@ -85,32 +151,86 @@ bool BNO055::isReady() {
  * @param powermode The power mode to set (NORMAL, LOWPOWER, SUSPEND).
  */
 void BNO055::setPowerMode(PowerMode powermode) {
+    BNO055_TRACE_SCOPE(TRACE_SET_POWER_MODE);
     setPage(0x00);
     writeByte(PWR_MODE, powermode);
+    this->powermode = powermode;
 }
 
 /**
  * @brief Sets the operation mode of the BNO055 sensor.
  * 
- * This function sets the operation mode of the BNO055 sensor to the specified mode.
+ * This function records the new mode and the time at which it becomes valid instead of sleeping: switching from CONFIG mode to any operation mode takes 7 ms, switching to CONFIG mode 19 ms. A pending switch is completed before the next one is issued, and setting the current mode again is skipped.
  * 
  * @param mode The operation mode to set (CONFIG, ACCONLY, MAGONLY, GYRONLY, etc.).
+ * @return The micros() time at which the new mode is valid.
  */
-void BNO055::setOperationMode(OperationMode mode) {
-    setPage(0x00);
+uint32_t BNO055::setOperationMode(OperationMode mode) {
+    BNO055_TRACE_SCOPE(TRACE_SET_OPERATION_MODE);
+    if(modeKnown && mode == this->mode) {
+        return modeReadyAt;
+    }
+    uint32_t switchTime = BNO055_MODE_TO_CONFIG;
+    if(mode != OPERATION_MODE_CONFIG) {
+        switchTime = (modeKnown && this->mode == OPERATION_MODE_CONFIG) ? BNO055_MODE_FROM_CONFIG : BNO055_MODE_TO_CONFIG + BNO055_MODE_FROM_CONFIG;
+    }
+    waitModeReady();
+    selectPage(0x00);
     writeByte(OPR_MODE, mode);
+    this->mode = mode;
+    modeKnown = true;
+    modeReadyAt = micros() + switchTime;
+    modePending = true;
+    return modeReadyAt;
 }
 
 /**
  * @brief Gets the current operation mode of the BNO055 sensor.
  * 
- * This function reads the operation mode register of the BNO055 sensor to get the current operation mode.
+ * This function reads the operation mode register of the BNO055 sensor to get the current operation mode and updates the recorded mode.
  * 
  * @return The current operation mode of the sensor (CONFIG, ACCONLY, MAGONLY, GYRONLY, etc.).
  */
 OperationMode BNO055::getMode() {
-    setPage(0x00);
-    return (OperationMode)readByte(OPR_MODE);
+    BNO055_TRACE_SCOPE(TRACE_GET_MODE);
+    selectPage(0x00);
+    mode = (OperationMode)(readByte(OPR_MODE) & 0x0F);
+    modeKnown = true;
+    return mode;
+}
+
+/**
+ * @brief Checks if the last operation mode switch has completed.
+ * 
+ * @return True if the current mode is valid, false while the sensor is still switching.
+ */
+bool BNO055::isModeReady() {
+    BNO055_TRACE_SCOPE(TRACE_IS_MODE_READY);
+    return modeSwitched();
+}
+
+/**
+ * @brief Waits until the last operation mode switch has completed.
+ * 
+ * This function returns immediately if no switch is pending.
+ */
+void BNO055::waitModeReady() {
+    BNO055_TRACE_SCOPE(TRACE_WAIT_MODE_READY);
+    while (!modeSwitched()) {
+        yield();
+    }
+}
+
+/**
+ * @brief Gets the last power mode set on the BNO055 sensor.
+ * 
+ * This function returns the power mode written by the last call to setPowerMode without accessing the sensor.
+ * 
+ * @return The current power mode of the sensor (NORMAL, LOWPOWER, SUSPEND).
+ */
+PowerMode BNO055::getPowerMode() {
+    BNO055_TRACE_SCOPE(TRACE_GET_POWER_MODE);
+    return powermode;
 }
 
 /**
@@ -121,7 +241,9 @@ OperationMode BNO055::getMode() {
  * @param page The page ID to set.
  */
 void BNO055::setPage(uint8_t page) {
+    BNO055_TRACE_SCOPE(TRACE_SET_PAGE);
     writeByte(PAGE_ID, page);
+    this->page = page;
 }
 
 /**
@@ -132,16 +254,65 @@ void BNO055::setPage(uint8_t page) {
  * @return The current page ID of the sensor.
  */
 void BNO055::getPage() {
+    BNO055_TRACE_SCOPE(TRACE_GET_PAGE);
     readByte(PAGE_ID);
 }
 
+/**
+ * @brief Gets the I2C address of the BNO055 sensor.
+ * 
+ * @return The 7-bit I2C address.
+ */
+uint8_t BNO055::getAddress() {
+    return address;
+}
+
+/**
+ * @brief Gets the I2C bus of the BNO055 sensor.
+ * 
+ * @return The bus the sensor was constructed with.
+ */
+TwoWire& BNO055::getWire() {
+    return *wire;
+}
+
+/**
+ * @brief Checks if the last operation mode switch has completed, without a tracepoint.
+ * 
+ * This function only compares times while a switch is pending, so the result stays valid after micros() has moved more than 2^31 us past the deadline. The driver polls it internally so a wait does not fill the trace buffer.
+ * 
+ * @return True if the current mode is valid, false while the sensor is still switching.
+ */
+bool BNO055::modeSwitched() {
+    if(modePending && (int32_t)(micros() - modeReadyAt) >= 0) {
+        modePending = false;
+    }
+    return !modePending;
+}
+
+/**
+ * @brief Selects a register page only if it is not already selected.
+ * 
+ * This function compares the requested page with the last page written by setPage and skips the PAGE_ID write when they match.
+ * 
+ * @param page The page ID to select.
+ */
+void BNO055::selectPage(uint8_t page) {
+    BNO055_TRACE_SCOPE(TRACE_SELECT_PAGE);
+    if(this->page != page) {
+        setPage(page);
+    }
+}
+
+#if BNO055_ENABLE_INTERRUPTS
 /**
  * @brief Resets the interrupt of the BNO055 sensor.
  * 
  * This function resets the interrupt of the BNO055 sensor by writing a specific value to the SYS_TRIGGER register. 
  */
 void BNO055::interruptReset() {
-    writeByte(SYS_TRIGGER, 0x40);
+    BNO055_TRACE_SCOPE(TRACE_INTERRUPT_RESET);
+    write<BNO055Reg::SysTriggerRstInt>(1);
 }
 
 /**
@@ -152,8 +323,8 @@ void BNO055::interruptReset() {
  * @param mask The mask value to set for interrupts.
  */
 void BNO055::interruptMask(uint8_t mask) {
-    setPage(0x01);
-    writeByte(INT_MSK, mask);
+    BNO055_TRACE_SCOPE(TRACE_INTERRUPT_MASK);
+    write<BNO055Reg::IntMskAll>(mask);
 }
 
 /**
@@ -164,8 +335,8 @@ void BNO055::interruptMask(uint8_t mask) {
  * @param regVal The value to enable specific interrupts.
  */
 void BNO055::interruptEnable(uint8_t regVal) {
-    setPage(0x01);
-    writeByte(INT_EN, regVal);
+    BNO055_TRACE_SCOPE(TRACE_INTERRUPT_ENABLE);
+    write<BNO055Reg::IntEnAll>(regVal);
 }
 
 /**
@@ -174,8 +345,8 @@ void BNO055::interruptEnable(uint8_t regVal) {
  * This function disables all interrupts on the BNO055 sensor by writing 0x00 to the INT_EN register.
  */
 void BNO055::interruptDisable() {
-    setPage(0x01);
-    writeByte(INT_EN, 0x00);
+    BNO055_TRACE_SCOPE(TRACE_INTERRUPT_DISABLE);
+    write<BNO055Reg::IntEnAll>(0x00);
 }
 
 /**
@@ -186,8 +357,8 @@ void BNO055::interruptDisable() {
  * @param threshold The threshold value for accelerometer activity detection.
  */
 void BNO055::accAMThresh(uint8_t threshold) {
-    setPage(0x01);
-    writeByte(ACC_AM_THRES, threshold);
+    BNO055_TRACE_SCOPE(TRACE_ACC_AM_THRESH);
+    write<BNO055Reg::AccAmThresValue>(threshold);
 }
 
 /**
@@ -200,8 +371,8 @@ void BNO055::accAMThresh(uint8_t threshold) {
  * @param duration The duration value for the interrupt.
  */
 void BNO055::accIntSettings(uint8_t hgAxis, uint8_t motionAxis, uint8_t duration) {
-    setPage(0x01);
-    writeByte(ACC_INT_SETTINGS, hgAxis << 5| motionAxis << 2| duration);
+    BNO055_TRACE_SCOPE(TRACE_ACC_INT_SETTINGS);
+    write<BNO055Reg::AccIntSettingsHgAxis, BNO055Reg::AccIntSettingsAmNmAxis, BNO055Reg::AccIntSettingsAmDuration>(hgAxis, motionAxis, duration);
 }
 
 /**
@@ -212,8 +383,8 @@ void BNO055::accIntSettings(uint8_t hgAxis, uint8_t motionAxis, uint8_t duration
  * @param hgDuration The duration value for high-g acceleration interrupt.
  */
 void BNO055::accHGSettings(uint8_t hgDuration) {
-    setPage(0x01);
-    writeByte(ACC_HG_DURATION, hgDuration);
+    BNO055_TRACE_SCOPE(TRACE_ACC_HG_SETTINGS);
+    write<BNO055Reg::AccHgDurationValue>(hgDuration);
 }
 
 /**
@@ -224,8 +395,8 @@ void BNO055::accHGSettings(uint8_t hgDuration) {
  * @param threshold The threshold value for high-g acceleration interrupt.
  */
 void BNO055::accHGThresh(uint8_t threshold) {
-    setPage(0x01);
-    writeByte(ACC_HG_THRES, threshold);
+    BNO055_TRACE_SCOPE(TRACE_ACC_HG_THRESH);
+    write<BNO055Reg::AccHgThresValue>(threshold);
 }
 
 /**
@@ -236,8 +407,8 @@ void BNO055::accHGThresh(uint8_t threshold) {
  * @param threshold The threshold value for no-motion interrupt.
  */
 void BNO055::accNMThresh(uint8_t threshold) {
-    setPage(0x01);
-    writeByte(ACC_NM_THRES, threshold);
+    BNO055_TRACE_SCOPE(TRACE_ACC_NM_THRESH);
+    write<BNO055Reg::AccNmThresValue>(threshold);
 }
 
 /**
@@ -249,10 +420,8 @@ void BNO055::accNMThresh(uint8_t threshold) {
  * @param motion Flag indicating if motion should be considered for no-motion detection.
  */
 void BNO055::accNMSet(uint8_t duration, bool motion) {
-    setPage(0x01);
-    uint8_t temp = readByte(ACC_NM_SET);
-    temp = (temp & 0x80) | (duration << 1| motion);
-    writeByte(ACC_NM_SET, temp);
+    BNO055_TRACE_SCOPE(TRACE_ACC_NM_SET);
+    write<BNO055Reg::AccNmSetDuration, BNO055Reg::AccNmSetSmnm>(duration, motion);
 }
 
 /**
@@ -266,8 +435,8 @@ void BNO055::accNMSet(uint8_t duration, bool motion) {
  * @param amAxis Axis for any motion gyro interrupt (X_AXIS, Y_AXIS, Z_AXIS).
  */
 void BNO055::gyrIntSettings(uint8_t hrFilter, uint8_t amFilter, uint8_t hrAxis, uint8_t amAxis) {
-    setPage(0x01);
-    writeByte(GYR_INT_SETTING, hrFilter << 7 | amFilter << 6 | hrAxis << 3 | amAxis);
+    BNO055_TRACE_SCOPE(TRACE_GYR_INT_SETTINGS);
+    write<BNO055Reg::GyrIntSettingHrFilter, BNO055Reg::GyrIntSettingAmFilter, BNO055Reg::GyrIntSettingHrAxis, BNO055Reg::GyrIntSettingAmAxis>(hrFilter, amFilter, hrAxis, amAxis);
 }
 
 /**
@@ -279,10 +448,8 @@ void BNO055::gyrIntSettings(uint8_t hrFilter, uint8_t amFilter, uint8_t hrAxis,
  * @param threshold The threshold value for X-axis gyro interrupt.
  */
 void BNO055::gyrHrXSet(uint8_t hrHysteresis, uint8_t threshold) {
-    setPage(0x01);
-    uint8_t temp = readByte(GYR_HR_X_SET);
-    temp = (temp & 0x80) | (hrHysteresis << 5 | threshold);
-    writeByte(GYR_HR_X_SET, temp);
+    BNO055_TRACE_SCOPE(TRACE_GYR_HR_X_SET);
+    write<BNO055Reg::GyrHrXSetHysteresis, BNO055Reg::GyrHrXSetThreshold>(hrHysteresis, threshold);
 }
 
 /**
@@ -293,8 +460,8 @@ void BNO055::gyrHrXSet(uint8_t hrHysteresis, uint8_t threshold) {
  * @param duration The duration value for X-axis gyro interrupt.
  */
 void BNO055::gyrDurationX(uint8_t duration) {
-    setPage(0x01);
-    writeByte(GYR_DUR_X, duration);
+    BNO055_TRACE_SCOPE(TRACE_GYR_DURATION_X);
+    write<BNO055Reg::GyrDurXValue>(duration);
 }
 
 /**
@@ -306,10 +473,8 @@ void BNO055::gyrDurationX(uint8_t duration) {
  * @param threshold The threshold value for Y-axis gyro interrupt.
  */
 void BNO055::gyrHrYSet(uint8_t hrHysteresis, uint8_t threshold) {
-    setPage(0x01);
-    uint8_t temp = readByte(GYR_HR_Y_SET);
-    temp = (temp & 0x80) | (hrHysteresis << 5 | threshold);
-    writeByte(GYR_HR_Y_SET, temp);
+    BNO055_TRACE_SCOPE(TRACE_GYR_HR_Y_SET);
+    write<BNO055Reg::GyrHrYSetHysteresis, BNO055Reg::GyrHrYSetThreshold>(hrHysteresis, threshold);
 }
 
 /**
@@ -320,8 +485,8 @@ void BNO055::gyrHrYSet(uint8_t hrHysteresis, uint8_t threshold) {
  * @param duration The duration value for Y-axis gyro interrupt.
  */
 void BNO055::gyrDurationY(uint8_t duration) {
-    setPage(0x01);
-    writeByte(GYR_DUR_Y, duration);
+    BNO055_TRACE_SCOPE(TRACE_GYR_DURATION_Y);
+    write<BNO055Reg::GyrDurYValue>(duration);
 }
 
 /**
@@ -333,10 +498,8 @@ void BNO055::gyrDurationY(uint8_t duration) {
  * @param threshold The threshold value for Z-axis gyro interrupt.
  */
 void BNO055::gyrHrZSet(uint8_t hrHysteresis, uint8_t threshold) {
-    setPage(0x01);
-    uint8_t temp = readByte(GYR_HR_Z_SET);
-    temp = (temp & 0x80) | (hrHysteresis << 5 | threshold);
-    writeByte(GYR_HR_Z_SET, temp);
+    BNO055_TRACE_SCOPE(TRACE_GYR_HR_Z_SET);
+    write<BNO055Reg::GyrHrZSetHysteresis, BNO055Reg::GyrHrZSetThreshold>(hrHysteresis, threshold);
 }
 
 /**
@@ -347,8 +510,8 @@ void BNO055::gyrHrZSet(uint8_t hrHysteresis, uint8_t threshold) {
  * @param duration The duration value for Z-axis gyro interrupt.
  */
 void BNO055::gyrDurationZ(uint8_t duration) {
-    setPage(0x01);
-    writeByte(GYR_DUR_Z, duration);
+    BNO055_TRACE_SCOPE(TRACE_GYR_DURATION_Z);
+    write<BNO055Reg::GyrDurZValue>(duration);
 }
 
 /**
@@ -359,8 +522,8 @@ void BNO055::gyrDurationZ(uint8_t duration) {
  * @param threshold The threshold value for angular rate gyro interrupt.
  */
 void BNO055::gyrAmThresh(uint8_t threshold) {
-    setPage(0x01);
-    writeByte(GYR_AM_THRES, threshold);
+    BNO055_TRACE_SCOPE(TRACE_GYR_AM_THRESH);
+    write<BNO055Reg::GyrAmThresValue>(threshold);
 }
 
 /**
@@ -372,11 +535,10 @@ void BNO055::gyrAmThresh(uint8_t threshold) {
  * @param samples The number of samples for gyro interrupt.
  */
 void BNO055::gyrAmSet(uint8_t duration, uint8_t samples) {
-    setPage(0x01);
-    uint8_t temp = readByte(GYR_AM_SET);
-    temp = (temp & 0xF0) | (duration << 2 | samples);
-    writeByte(GYR_AM_SET, temp);
+    BNO055_TRACE_SCOPE(TRACE_GYR_AM_SET);
+    write<BNO055Reg::GyrAmSetAwakeDuration, BNO055Reg::GyrAmSetSlopeSamples>(duration, samples);
 }
+#endif
 
 /**
  * @brief Sets the unit selection for the BNO055 sensor.
@@ -387,6 +549,7 @@ void BNO055::gyrAmSet(uint8_t duration, uint8_t samples) {
  * while values less than or equal to 0x20 are used for clearing units.
  */
 void BNO055::setUnit(uint8_t unitValue) {
+    BNO055_TRACE_SCOPE(TRACE_SET_UNIT);
     setPage(0x00);
     uint8_t tempValue = readByte(UNIT_SEL);
     if (unitValue>0x20)
@@ -399,6 +562,7 @@ void BNO055::setUnit(uint8_t unitValue) {
         tempValue = tempValue & ~unitValue;
         writeByte(UNIT_SEL, tempValue | unitValue);
         }
+    unitSel = readByte(UNIT_SEL);
 
 }
 
@@ -412,9 +576,8 @@ void BNO055::setUnit(uint8_t unitValue) {
  * @param accOPmode The accelerometer operating mode to be set.
  */
 void BNO055::setAccConfig(AccRange accRange, AccBW accBW, AccOPMode accOPmode) {
-    setPage(0x01);
-    uint8_t tempValue = (readByte(ACC_CONFIG) & 0x00) | accRange << 5 | accBW << 2 | accOPmode;
-    writeByte(ACC_CONFIG, tempValue);
+    BNO055_TRACE_SCOPE(TRACE_SET_ACC_CONFIG);
+    write<BNO055Reg::AccConfigRange, BNO055Reg::AccConfigBW, BNO055Reg::AccConfigPwrMode>(accRange, accBW, accOPmode);
 }
 
 /**
@@ -427,11 +590,9 @@ void BNO055::setAccConfig(AccRange accRange, AccBW accBW, AccOPMode accOPmode) {
  * @param gyrOPmode The gyroscope operating mode to be set.
  */
 void BNO055::setGyroConfig(GyrRange gyrRange, GyrBW gyrBW, GyrOPMode gyrOPmode) {
-    setPage(0x01);
-    uint8_t tempValue0 = (readByte(GYR_CONFIG_0) & 0x00) | gyrBW << 3 | gyrRange;
-    writeByte(GYR_CONFIG_0, tempValue0);
-    uint8_t tempValue1 = (readByte(GYR_CONFIG_1) & 0x00) | gyrOPmode;
-    writeByte(GYR_CONFIG_1, tempValue1);
+    BNO055_TRACE_SCOPE(TRACE_SET_GYRO_CONFIG);
+    write<BNO055Reg::GyrConfig0Range, BNO055Reg::GyrConfig0BW>(gyrRange, gyrBW);
+    write<BNO055Reg::GyrConfig1PwrMode>(gyrOPmode);
 }
 
 /**
@@ -444,9 +605,8 @@ void BNO055::setGyroConfig(GyrRange gyrRange, GyrBW gyrBW, GyrOPMode gyrOPmode)
  * @param magOPmode The magnetometer operating mode to be set.
  */
 void BNO055::setMagConfig(MagRate rate, MagPMode Pmode, MagOPMode magOPmode) {
-    setPage(0x01);
-    uint8_t tempValue = (readByte(MAG_CONFIG) & 0x00) | Pmode << 5 | magOPmode << 3 | rate;
-    writeByte(MAG_CONFIG, tempValue);
+    BNO055_TRACE_SCOPE(TRACE_SET_MAG_CONFIG);
+    write<BNO055Reg::MagConfigRate, BNO055Reg::MagConfigOprMode, BNO055Reg::MagConfigPwrMode>(rate, magOPmode, Pmode);
 }
 
 /**
@@ -458,10 +618,8 @@ void BNO055::setMagConfig(MagRate rate, MagPMode Pmode, MagOPMode magOPmode) {
  * @param mode The sleep mode to be set (true for sleep mode enabled, false for sleep mode disabled).
  */
 void BNO055::setAccSleepConfig(uint8_t duration, bool mode) {
-    setPage(0x01);
-    uint8_t tempValue = readByte(ACC_SLEEP_CONFIG);
-    tempValue = (tempValue & 0xE0) | duration << 1 | mode;
-    writeByte(ACC_SLEEP_CONFIG, tempValue);
+    BNO055_TRACE_SCOPE(TRACE_SET_ACC_SLEEP_CONFIG);
+    write<BNO055Reg::AccSleepConfigDuration, BNO055Reg::AccSleepConfigMode>(duration, mode);
 }
 
 /**
@@ -473,12 +631,11 @@ void BNO055::setAccSleepConfig(uint8_t duration, bool mode) {
  * @param sleepDuration The sleep duration value for gyroscope.
  */
 void BNO055::setGyrSleepConfig(uint8_t autoSleepDuration, uint8_t sleepDuration) {
-    setPage(0x01);
-    uint8_t tempValue = readByte(GYR_SLEEP_CONFIG);
-    tempValue = (tempValue & 0xC0) | autoSleepDuration << 3 | sleepDuration;
-    writeByte(GYR_SLEEP_CONFIG, tempValue);
+    BNO055_TRACE_SCOPE(TRACE_SET_GYR_SLEEP_CONFIG);
+    write<BNO055Reg::GyrSleepConfigAutoSleep, BNO055Reg::GyrSleepConfigDuration>(autoSleepDuration, sleepDuration);
 }
 
+#if BNO055_ENABLE_CALIBRATION
 /**
  * @brief Sets the accelerometer X-axis offset for the BNO055 sensor.
  * 
@@ -487,9 +644,8 @@ void BNO055::setGyrSleepConfig(uint8_t autoSleepDuration, uint8_t sleepDuration)
  * @param offset The offset value to be set for the X-axis accelerometer.
  */
 void BNO055::accOffsetX(uint16_t offset) {
-    setPage(0x00);
-    writeByte(ACC_OFFSET_X_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(ACC_OFFSET_X_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_ACC_OFFSET_X);
+    write<BNO055Reg::AccOffsetXValue>(offset);
 }
 
 /**
@@ -500,9 +656,8 @@ void BNO055::accOffsetX(uint16_t offset) {
  * @param offset The offset value to be set for the Y-axis accelerometer.
  */
 void BNO055::accOffsetY(uint16_t offset) {
-    setPage(0x00);
-    writeByte(ACC_OFFSET_Y_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(ACC_OFFSET_Y_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_ACC_OFFSET_Y);
+    write<BNO055Reg::AccOffsetYValue>(offset);
 }
 
 /**
@@ -513,9 +668,8 @@ void BNO055::accOffsetY(uint16_t offset) {
  * @param offset The offset value to be set for the Z-axis accelerometer.
  */
 void BNO055::accOffsetZ(uint16_t offset) {
-    setPage(0x00);
-    writeByte(ACC_OFFSET_Z_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(ACC_OFFSET_Z_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_ACC_OFFSET_Z);
+    write<BNO055Reg::AccOffsetZValue>(offset);
 }
 
 /**
@@ -526,9 +680,8 @@ void BNO055::accOffsetZ(uint16_t offset) {
  * @param offset The offset value to be set for the X-axis magnetometer.
  */
 void BNO055::magOffsetX(uint16_t offset) {
-    setPage(0x00);
-    writeByte(MAG_OFFSET_X_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(MAG_OFFSET_X_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_MAG_OFFSET_X);
+    write<BNO055Reg::MagOffsetXValue>(offset);
 }
 
 /**
@@ -539,9 +692,8 @@ void BNO055::magOffsetX(uint16_t offset) {
  * @param offset The offset value to be set for the Y-axis magnetometer.
  */
 void BNO055::magOffsetY(uint16_t offset) {
-    setPage(0x00);
-    writeByte(MAG_OFFSET_Y_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(MAG_OFFSET_Y_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_MAG_OFFSET_Y);
+    write<BNO055Reg::MagOffsetYValue>(offset);
 }
 
 /**
@@ -552,9 +704,8 @@ void BNO055::magOffsetY(uint16_t offset) {
  * @param offset The offset value to be set for the Z-axis magnetometer.
  */
 void BNO055::magOffsetZ(uint16_t offset) {
-    setPage(0x00);
-    writeByte(MAG_OFFSET_Z_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(MAG_OFFSET_Z_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_MAG_OFFSET_Z);
+    write<BNO055Reg::MagOffsetZValue>(offset);
 }
 
 /**
@@ -565,9 +716,8 @@ void BNO055::magOffsetZ(uint16_t offset) {
  * @param offset The offset value to be set for the X-axis gyroscope.
  */
 void BNO055::gyrOffsetX(uint16_t offset) {
-    setPage(0x00);
-    writeByte(GYR_OFFSET_X_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(GYR_OFFSET_X_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_GYR_OFFSET_X);
+    write<BNO055Reg::GyrOffsetXValue>(offset);
 }
 
 /**
@@ -578,9 +728,8 @@ void BNO055::gyrOffsetX(uint16_t offset) {
  * @param offset The offset value to be set for the Y-axis gyroscope.
  */
 void BNO055::gyrOffsetY(uint16_t offset) {
-    setPage(0x00);
-    writeByte(GYR_OFFSET_Y_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(GYR_OFFSET_Y_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_GYR_OFFSET_Y);
+    write<BNO055Reg::GyrOffsetYValue>(offset);
 }
 
 /**
@@ -591,11 +740,96 @@ void BNO055::gyrOffsetY(uint16_t offset) {
  * @param offset The offset value to be set for the Z-axis gyroscope.
  */
 void BNO055::gyrOffsetZ(uint16_t offset) {
-    setPage(0x00);
-    writeByte(GYR_OFFSET_Z_LSB, (uint8_t)(offset & 0x00FF));
-    writeByte(GYR_OFFSET_Z_MSB, (uint8_t)(offset >> 8));
+    BNO055_TRACE_SCOPE(TRACE_GYR_OFFSET_Z);
+    write<BNO055Reg::GyrOffsetZValue>(offset);
+}
+
+/**
+ * @brief Sets all calibration offsets and radii of the BNO055 sensor.
+ * 
+ * This function writes the accelerometer, magnetometer and gyroscope offsets and the accelerometer and magnetometer radii (ACC_OFFSET_X_LSB..MAG_RADIUS_MSB) in a single burst. The sensor must be in CONFIG mode.
+ * 
+ * @param offsets Pointer to a calibOffsets struct holding the values to write.
+ * @return True if the offsets were successfully written, false otherwise.
+ */
+bool BNO055::setCalibrationOffsets(const calibOffsets *offsets) {
+    BNO055_TRACE_SCOPE(TRACE_SET_CALIBRATION_OFFSETS);
+    const int16_t values[11] = {
+        offsets->accX, offsets->accY, offsets->accZ,
+        offsets->magX, offsets->magY, offsets->magZ,
+        offsets->gyrX, offsets->gyrY, offsets->gyrZ,
+        offsets->accRadius, offsets->magRadius
+    };
+    uint8_t buffer[22];
+    for (uint8_t i = 0; i < 11; i++) {
+        buffer[2 * i] = (uint8_t)((uint16_t)values[i] & 0x00FF);
+        buffer[2 * i + 1] = (uint8_t)((uint16_t)values[i] >> 8);
+    }
+    selectPage(0x00);
+    return writeBytes(ACC_OFFSET_X_LSB, buffer, sizeof(buffer));
+}
+
+/**
+ * @brief Gets all calibration offsets and radii of the BNO055 sensor.
+ * 
+ * This function reads ACC_OFFSET_X_LSB..MAG_RADIUS_MSB in a single burst and stores the values in the provided struct.
+ * 
+ * @param offsets Pointer to a calibOffsets struct to store the values.
+ */
+void BNO055::getCalibrationOffsets(calibOffsets *offsets) {
+    BNO055_TRACE_SCOPE(TRACE_GET_CALIBRATION_OFFSETS);
+    uint8_t buffer[22];
+    selectPage(0x00);
+    readBytes(ACC_OFFSET_X_LSB, buffer, sizeof(buffer));
+
+    int16_t values[11];
+    for (uint8_t i = 0; i < 11; i++) {
+        values[i] = (int16_t)((uint16_t)buffer[2 * i] | ((uint16_t)buffer[2 * i + 1] << 8));
+    }
+    offsets->accX = values[0];
+    offsets->accY = values[1];
+    offsets->accZ = values[2];
+    offsets->magX = values[3];
+    offsets->magY = values[4];
+    offsets->magZ = values[5];
+    offsets->gyrX = values[6];
+    offsets->gyrY = values[7];
+    offsets->gyrZ = values[8];
+    offsets->accRadius = values[9];
+    offsets->magRadius = values[10];
+}
+#endif
+
+#if BNO055_ENABLE_INTERRUPTS
+/**
+ * @brief Sets the complete interrupt configuration of the BNO055 sensor.
+ * 
+ * This function writes INT_MSK..GYR_AM_SET (page 1, 0x0F-0x1F) in a single burst, so a full interrupt reconfiguration takes one page write and one data transfer.
+ * 
+ * @param config Pointer to an interruptConfig struct holding the register values.
+ * @return True if the configuration was successfully written, false otherwise.
+ */
+bool BNO055::setInterruptConfig(const interruptConfig *config) {
+    BNO055_TRACE_SCOPE(TRACE_SET_INTERRUPT_CONFIG);
+    selectPage(0x01);
+    return writeBytes(INT_MSK, (const uint8_t*)config, sizeof(interruptConfig));
 }
 
+/**
+ * @brief Gets the complete interrupt configuration of the BNO055 sensor.
+ * 
+ * This function reads INT_MSK..GYR_AM_SET (page 1, 0x0F-0x1F) in a single burst. Together with setInterruptConfig it allows changing single settings with one read and one write.
+ * 
+ * @param config Pointer to an interruptConfig struct to store the register values.
+ */
+void BNO055::getInterruptConfig(interruptConfig *config) {
+    BNO055_TRACE_SCOPE(TRACE_GET_INTERRUPT_CONFIG);
+    selectPage(0x01);
+    readBytes(INT_MSK, (uint8_t*)config, sizeof(interruptConfig));
+}
+#endif
+
+#if BNO055_ENABLE_FLOAT
 /**
  * @brief Gets the acceleration values in x, y, and z axes from the BNO055 sensor.
  * 
@@ -606,16 +840,17 @@ void BNO055::gyrOffsetZ(uint16_t offset) {
  * @param z Reference to a float variable to store the acceleration value in the z-axis.
  */
 void BNO055::getAcceleration(float& x, float& y, float& z) {
+    BNO055_TRACE_SCOPE(TRACE_GET_ACCELERATION);
+    waitModeReady();
     setPage(0x00);
-    int16_t rawX, rawY, rawZ;
-    readBytes(ACC_X_LSB, (uint8_t*)&rawX, 2);
-    readBytes(ACC_Y_LSB, (uint8_t*)&rawY, 2);
-    readBytes(ACC_Z_LSB, (uint8_t*)&rawZ, 2);
+    uint8_t buffer[6];
+    readBytes(ACC_X_LSB, buffer, 6);
 
-    x = rawX / 100.0;
-    y = rawY / 100.0;
-    z = rawZ / 100.0;
+    x = BNO055Decode::readInt16LE(&buffer[0]) / 100.0;
+    y = BNO055Decode::readInt16LE(&buffer[2]) / 100.0;
+    z = BNO055Decode::readInt16LE(&buffer[4]) / 100.0;
 }
+#endif
 
 /**
  * @brief Sets the axis remap configuration for the BNO055 sensor.
@@ -625,15 +860,14 @@ void BNO055::getAcceleration(float& x, float& y, float& z) {
  * @param remapconfig The axis remap configuration value to be set.
  */
 void BNO055::setAxisRemap(axisRemapConfig remapconfig) {
-    setPage(0x00);
-    OperationMode mode = getMode();
+    BNO055_TRACE_SCOPE(TRACE_SET_AXIS_REMAP);
+    OperationMode runMode = modeKnown ? mode : getMode();
 
     setOperationMode(OPERATION_MODE_CONFIG);
-    delay(25);
+    waitModeReady();
+    selectPage(0x00);
     writeByte(AXIS_MAP_CONFIG, remapconfig);
-    delay(10);
-    setOperationMode(mode);
-    delay(20);
+    setOperationMode(runMode);
 }
 
 /**
@@ -644,16 +878,33 @@ void BNO055::setAxisRemap(axisRemapConfig remapconfig) {
  * @param remapsign The axis sign configuration value to be set.
  */
 void BNO055::setAxisSign(axisRemapSign remapsign) {
-    setPage(0x00);
-    OperationMode mode = getMode();
+    BNO055_TRACE_SCOPE(TRACE_SET_AXIS_SIGN);
+    OperationMode runMode = modeKnown ? mode : getMode();
 
     setOperationMode(OPERATION_MODE_CONFIG);
-    delay(25);
+    waitModeReady();
+    selectPage(0x00);
     writeByte(AXIS_MAP_SIGN, remapsign);
-    delay(10);
-    setOperationMode(mode);
+    setOperationMode(runMode);
+}
 
-    delay(20);
+/**
+ * @brief Sets the mounting placement of the BNO055 sensor.
+ * 
+ * This function writes AXIS_MAP_CONFIG and AXIS_MAP_SIGN of a datasheet placement in one burst and a single CONFIG mode round trip. To reorient the data without interrupting the fusion, remap it on the host with BNO055Remap::AxisRemap or BNO055Remap::PlacementRemap instead.
+ * 
+ * @param placement The placement to set (P0..P7).
+ */
+void BNO055::setAxisPlacement(AxisPlacement placement) {
+    BNO055_TRACE_SCOPE(TRACE_SET_AXIS_PLACEMENT);
+    OperationMode runMode = modeKnown ? mode : getMode();
+    const uint8_t remap[2] = { BNO055Remap::placementConfig(placement), BNO055Remap::placementSign(placement) };
+
+    setOperationMode(OPERATION_MODE_CONFIG);
+    waitModeReady();
+    selectPage(0x00);
+    writeBytes(AXIS_MAP_CONFIG, remap, sizeof(remap));
+    setOperationMode(runMode);
 }
 
 /**
@@ -664,6 +915,7 @@ void BNO055::setAxisSign(axisRemapSign remapsign) {
  * @param info Pointer to a revInfo struct to store the revision information.
  */
 void BNO055::getrevInfo(revInfo *info) {
+    BNO055_TRACE_SCOPE(TRACE_GET_REV_INFO);
     setPage(0x00);
     uint8_t a, b;
 
@@ -678,6 +930,145 @@ void BNO055::getrevInfo(revInfo *info) {
     info->sw_rev = (((uint16_t)b) << 8) | ((uint16_t)a);
 }
 
+/**
+ * @brief Reads the configuration image of the BNO055 sensor.
+ * 
+ * This function reads the three configuration blocks described by configImage in one burst each.
+ * 
+ * @param image Pointer to a configImage struct to store the register values.
+ * @return True if all three blocks were read, false otherwise.
+ */
+bool BNO055::readConfigImage(configImage *image) {
+    BNO055_TRACE_SCOPE(TRACE_READ_CONFIG_IMAGE);
+    selectPage(0x00);
+    bool success = readBytes(UNIT_SEL, image->system, sizeof(image->system));
+    success = readBytes(ACC_OFFSET_X_LSB, image->offsets, sizeof(image->offsets)) && success;
+    selectPage(0x01);
+    success = readBytes(ACC_CONFIG, image->sensor, sizeof(image->sensor)) && success;
+    return success;
+}
+
+/**
+ * @brief Gets the hash of the current configuration of the BNO055 sensor.
+ * 
+ * This function should be called once the sensor is fully configured and running, and the result stored (e.g. in EEPROM) for warmStart().
+ * 
+ * @return The hash of the configuration image.
+ */
+uint32_t BNO055::getConfigHash() {
+    BNO055_TRACE_SCOPE(TRACE_GET_CONFIG_HASH);
+    configImage image;
+    readConfigImage(&image);
+    return hashConfigImage(&image);
+}
+
+/**
+ * @brief Computes the hash of a configuration image.
+ * 
+ * This function computes a FNV-1a hash over the configuration bits of the image. Reserved registers, SYS_TRIGGER and the reserved bits of the other registers are masked out, so the hash only changes with the configuration.
+ * 
+ * @param image Pointer to the configImage struct to hash.
+ * @return The hash value.
+ */
+uint32_t BNO055::hashConfigImage(const configImage *image) {
+    // UNIT_SEL, reserved, OPR_MODE, PWR_MODE, SYS_TRIGGER, TEMP_SOURCE, AXIS_MAP_CONFIG, AXIS_MAP_SIGN
+    static const uint8_t systemMask[8] = { 0x97, 0x00, 0x0F, 0x03, 0x00, 0x03, 0x3F, 0x07 };
+    const uint8_t* bytes = (const uint8_t*)image;
+    uint32_t hash = 2166136261UL;
+    for (uint8_t i = 0; i < sizeof(configImage); i++) {
+        uint8_t value = bytes[i];
+        if(i < sizeof(image->system)) {
+            value &= systemMask[i];
+        }
+        else if(i == offsetof(configImage, sensor) + 0x0E - ACC_CONFIG) {
+            value = 0x00; // reserved register between GYR_SLEEP_CONFIG and INT_MSK
+        }
+        hash = (hash ^ value) * 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Reads both register pages of the BNO055 sensor.
+ * 
+ * This function reads page 0 (CHIP_ID..MAG_RADIUS_MSB) and page 1 (PAGE_ID..GYR_AM_SET) in one burst each, instead of one transaction per register. On I2C a burst longer than the Wire buffer is split into back-to-back transfers.
+ * 
+ * @param image Pointer to a registerImage struct to store the register values.
+ */
+void BNO055::dumpRegisters(registerImage *image) {
+    BNO055_TRACE_SCOPE(TRACE_DUMP_REGISTERS);
+    selectPage(0x00);
+    readBytes(CHIP_ID, image->page0, sizeof(image->page0));
+    selectPage(0x01);
+    readBytes(PAGE_ID, image->page1, sizeof(image->page1));
+}
+
+/**
+ * @brief Restores a register image, e.g. to clone the configuration of another unit.
+ * 
+ * This function dumps the current registers and writes back only the writable registers whose configuration bits differ from the image, coalesced into bursts by BNO055RegisterMap::planRestore. The writes are made in CONFIG mode; afterwards the operation mode of the image is set. Measurements, status, trigger bits and the read-only registers of the image are ignored. If nothing differs, no register is written.
+ * 
+ * @param image Pointer to the registerImage struct to restore, as read by dumpRegisters.
+ * @return True if all bursts were successfully written, false otherwise.
+ */
+bool BNO055::restoreRegisters(const registerImage *image) {
+    BNO055_TRACE_SCOPE(TRACE_RESTORE_REGISTERS);
+    registerImage values;
+    registerBurst bursts[REGISTER_MAX_BURSTS];
+    dumpRegisters(&values);
+    mode = (OperationMode)(values.page0[OPR_MODE] & 0x0F);
+    modeKnown = true;
+
+    uint8_t count = BNO055RegisterMap::planRestore(&values, image, bursts, &values);
+    bool success = true;
+    if(count > 0) {
+        setOperationMode(OPERATION_MODE_CONFIG);
+        waitModeReady();
+        for (uint8_t i = 0; i < count; i++) {
+            selectPage(bursts[i].page);
+            success = writeBytes(bursts[i].start, BNO055RegisterMap::locate(&values, bursts[i].page, bursts[i].start), bursts[i].length) && success;
+        }
+        unitSel = image->page0[UNIT_SEL];
+        powermode = (PowerMode)(image->page0[PWR_MODE] & 0x03);
+    }
+    setOperationMode((OperationMode)(image->page0[OPR_MODE] & 0x0F));
+    return success;
+}
+
+/**
+ * @brief Prints a register image as text.
+ * 
+ * This function prints a header line and 16 registers per line as "<page> <address>: <bytes>" in hex, the format read by extras/tools/register_diff.
+ * 
+ * @param image Pointer to the registerImage struct to print.
+ * @param out The output, e.g. Serial.
+ */
+void BNO055::printRegisterImage(const registerImage *image, Print& out) {
+    static const char digits[] = "0123456789ABCDEF";
+    out.println("# BNO055 registers");
+    for (uint8_t page = 0; page < 2; page++) {
+        const uint8_t* bytes = (page == 0) ? image->page0 : image->page1;
+        uint8_t first = (page == 0) ? 0 : REGISTER_PAGE1_START;
+        uint8_t size = (page == 0) ? sizeof(image->page0) : sizeof(image->page1);
+        for (uint8_t i = 0; i < size; i++) {
+            if(i % 16 == 0) {
+                out.print(page);
+                out.print(' ');
+                out.print(digits[(first + i) >> 4]);
+                out.print(digits[(first + i) & 0x0F]);
+                out.print(':');
+            }
+            out.print(' ');
+            out.print(digits[bytes[i] >> 4]);
+            out.print(digits[bytes[i] & 0x0F]);
+            if(i % 16 == 15 || i == size - 1) {
+                out.println();
+            }
+        }
+    }
+}
+
+#if BNO055_ENABLE_FLOAT
 /**
  * @brief Gets the gravity values in x, y, and z axes from the BNO055 sensor.
  * 
@@ -688,15 +1079,15 @@ void BNO055::getrevInfo(revInfo *info) {
  * @param z Reference to a float variable to store the gravity value in the z-axis.
  */
 void BNO055::getGravity(float& x, float& y, float& z) {
+    BNO055_TRACE_SCOPE(TRACE_GET_GRAVITY);
+    waitModeReady();
     setPage(0x00);
-    int16_t rawX, rawY, rawZ;
-    readBytes(GRV_X_LSB, (uint8_t*)&rawX, 2);
-    readBytes(GRV_Y_LSB, (uint8_t*)&rawY, 2);
-    readBytes(GRV_Z_LSB, (uint8_t*)&rawZ, 2);
+    uint8_t buffer[6];
+    readBytes(GRV_X_LSB, buffer, 6);
 
-    x = rawX / 100.0;
-    y = rawY / 100.0;
-    z = rawZ / 100.0;
+    x = BNO055Decode::readInt16LE(&buffer[0]) / 100.0;
+    y = BNO055Decode::readInt16LE(&buffer[2]) / 100.0;
+    z = BNO055Decode::readInt16LE(&buffer[4]) / 100.0;
 }
 
 /**
@@ -709,15 +1100,15 @@ void BNO055::getGravity(float& x, float& y, float& z) {
  * @param z Reference to a float variable to store the linear acceleration value in the z-axis.
  */
 void BNO055::getLinearAcceleration(float& x, float& y, float& z) {
+    BNO055_TRACE_SCOPE(TRACE_GET_LINEAR_ACCELERATION);
+    waitModeReady();
     setPage(0x00);
-    int16_t rawX, rawY, rawZ;
-    readBytes(LIA_X_LSB, (uint8_t*)&rawX, 2);
-    readBytes(LIA_Y_LSB, (uint8_t*)&rawY, 2);
-    readBytes(LIA_Z_LSB, (uint8_t*)&rawZ, 2);
+    uint8_t buffer[6];
+    readBytes(LIA_X_LSB, buffer, 6);
 
-    x = rawX / 100.0;
-    y = rawY / 100.0;
-    z = rawZ / 100.0;
+    x = BNO055Decode::readInt16LE(&buffer[0]) / 100.0;
+    y = BNO055Decode::readInt16LE(&buffer[2]) / 100.0;
+    z = BNO055Decode::readInt16LE(&buffer[4]) / 100.0;
 }
 
 /**
@@ -730,15 +1121,15 @@ void BNO055::getLinearAcceleration(float& x, float& y, float& z) {
  * @param pitch Reference to a float variable to store the pitch angle.
  */
 void BNO055::getEulerAngles(float& heading, float& roll, float& pitch) {
+    BNO055_TRACE_SCOPE(TRACE_GET_EULER_ANGLES);
+    waitModeReady();
     setPage(0x00);
-    int16_t rawHeading, rawRoll, rawPitch;
-    readBytes(EUL_X_LSB, (uint8_t*)&rawHeading, 2);
-    readBytes(EUL_Y_LSB, (uint8_t*)&rawRoll, 2);
-    readBytes(EUL_Z_LSB, (uint8_t*)&rawPitch, 2);
+    uint8_t buffer[6];
+    readBytes(EUL_X_LSB, buffer, 6);
 
-    heading = rawHeading / 16.0;
-    roll = rawRoll / 16.0;
-    pitch = rawPitch / 16.0;
+    heading = BNO055Decode::readInt16LE(&buffer[0]) / 16.0;
+    roll = BNO055Decode::readInt16LE(&buffer[2]) / 16.0;
+    pitch = BNO055Decode::readInt16LE(&buffer[4]) / 16.0;
 }
 
 /**
@@ -752,19 +1143,20 @@ void BNO055::getEulerAngles(float& heading, float& roll, float& pitch) {
  * @param z Reference to a float variable to store the z value of the quaternion.
  */
 void BNO055::getQuaternions(float& w, float& x, float& y, float& z) {
+    BNO055_TRACE_SCOPE(TRACE_GET_QUATERNIONS);
+    waitModeReady();
     setPage(0x00);
-    int16_t rawW, rawX, rawY, rawZ;
-    readBytes(QUA_W_LSB, (uint8_t*)&rawW, 2);
-    readBytes(QUA_X_LSB, (uint8_t*)&rawX, 2);
-    readBytes(QUA_Y_LSB, (uint8_t*)&rawY, 2);
-    readBytes(QUA_Z_LSB, (uint8_t*)&rawZ, 2);
+    uint8_t buffer[8];
+    readBytes(QUA_W_LSB, buffer, 8);
 
-    w = rawW / 16384.0;
-    x = rawX / 16384.0;
-    y = rawY / 16384.0;
-    z = rawZ / 16384.0;
+    w = BNO055Decode::readInt16LE(&buffer[0]) / 16384.0;
+    x = BNO055Decode::readInt16LE(&buffer[2]) / 16384.0;
+    y = BNO055Decode::readInt16LE(&buffer[4]) / 16384.0;
+    z = BNO055Decode::readInt16LE(&buffer[6]) / 16384.0;
 }
+#endif
 
+#if BNO055_ENABLE_CALIBRATION
 /**
  * @brief Gets the calibration status of the BNO055 sensor for different sensor components.
  * 
@@ -776,22 +1168,17 @@ void BNO055::getQuaternions(float& w, float& x, float& y, float& z) {
  * @param mag Reference to a uint8_t variable to store the calibration status of the magnetometer.
  */
 void BNO055::getCalibrationStatus(uint8_t& sys, uint8_t& gyro, uint8_t& accel, uint8_t& mag) {
-    setPage(0x00);
+    BNO055_TRACE_SCOPE(TRACE_GET_CALIBRATION_STATUS);
+    selectPage(0x00);
     uint8_t calStatus = readByte(CALIB_STAT);
-    if(sys != NULL) {
-        sys = (calStatus >> 6) & 0x03;
-    }
-    if(gyro != NULL) {
-        gyro = (calStatus >> 4) & 0x03;
-    }
-    if(accel != NULL) {
-        accel = (calStatus >> 2) & 0x03;
-    }
-    if(mag != NULL) {
-        mag = calStatus & 0x03;
-    }
+    sys = (calStatus >> 6) & 0x03;
+    gyro = (calStatus >> 4) & 0x03;
+    accel = (calStatus >> 2) & 0x03;
+    mag = calStatus & 0x03;
 }
+#endif
 
+#if BNO055_ENABLE_FLOAT
 /**
  * @brief Gets the magnetometer data (x, y, z) from the BNO055 sensor.
  * 
@@ -802,15 +1189,15 @@ void BNO055::getCalibrationStatus(uint8_t& sys, uint8_t& gyro, uint8_t& accel, u
  * @param z Reference to a float variable to store the magnetometer data along the z-axis.
  */
 void BNO055::getMagnetometer(float& x, float& y, float& z) {
+    BNO055_TRACE_SCOPE(TRACE_GET_MAGNETOMETER);
+    waitModeReady();
     setPage(0x00);
-    int16_t rawX, rawY, rawZ;
-    readBytes(MAG_X_LSB, (uint8_t*)&rawX, 2);
-    readBytes(MAG_Y_LSB, (uint8_t*)&rawY, 2);
-    readBytes(MAG_Z_LSB, (uint8_t*)&rawZ, 2);
+    uint8_t buffer[6];
+    readBytes(MAG_X_LSB, buffer, 6);
 
-    x = rawX / 16.0;
-    y = rawY / 16.0;
-    z = rawZ / 16.0;
+    x = BNO055Decode::readInt16LE(&buffer[0]) / 16.0;
+    y = BNO055Decode::readInt16LE(&buffer[2]) / 16.0;
+    z = BNO055Decode::readInt16LE(&buffer[4]) / 16.0;
 }
 
 /**
@@ -823,15 +1210,15 @@ void BNO055::getMagnetometer(float& x, float& y, float& z) {
  * @param z Reference to a float variable to store the gyroscope data along the z-axis.
  */
 void BNO055::getGyroscope(float& x, float& y, float& z) {
+    BNO055_TRACE_SCOPE(TRACE_GET_GYROSCOPE);
+    waitModeReady();
     setPage(0x00);
-    int16_t rawX, rawY, rawZ;
-    readBytes(GYR_X_LSB, (uint8_t*)&rawX, 2);
-    readBytes(GYR_Y_LSB, (uint8_t*)&rawY, 2);
-    readBytes(GYR_Z_LSB, (uint8_t*)&rawZ, 2);
-    
-    x = rawX / 900.0;
-    y = rawY / 900.0;
-    z = rawZ / 900.0;
+    uint8_t buffer[6];
+    readBytes(GYR_X_LSB, buffer, 6);
+
+    x = BNO055Decode::readInt16LE(&buffer[0]) / 900.0;
+    y = BNO055Decode::readInt16LE(&buffer[2]) / 900.0;
+    z = BNO055Decode::readInt16LE(&buffer[4]) / 900.0;
 }
 
 /**
@@ -842,6 +1229,8 @@ void BNO055::getGyroscope(float& x, float& y, float& z) {
  * @param temperature Reference to a float variable to store the temperature data in degrees Celsius.
  */
 void BNO055::getTemperature(float& temperature) {
+    BNO055_TRACE_SCOPE(TRACE_GET_TEMPERATURE);
+    waitModeReady();
     setPage(0x00);
     int8_t rawTemperature, tempTemperature;
     readBytes(TEMP, (uint8_t*)&rawTemperature, 1);
@@ -860,6 +1249,7 @@ void BNO055::getTemperature(float& temperature) {
  * @param z Reference to a float variable to store the accuracy value for the z component of the quaternion.
  */
 void BNO055::getQuaternionAccuracy(float& w, float& x, float& y, float& z) {
+    BNO055_TRACE_SCOPE(TRACE_GET_QUATERNION_ACCURACY);
     setPage(0x00);
     uint8_t rawAccuracy;
     readBytes(0x3A, &rawAccuracy, 1);
@@ -880,28 +1270,143 @@ void BNO055::getQuaternionAccuracy(float& w, float& x, float& y, float& z) {
  * @param z Reference to a float variable to store the angular velocity data along the z-axis.
  */
 void BNO055::getAngularVelocity(float& x, float& y, float& z) {
+    BNO055_TRACE_SCOPE(TRACE_GET_ANGULAR_VELOCITY);
+    waitModeReady();
     setPage(0x00);
-    int16_t rawX, rawY, rawZ;
-    readBytes(GYR_X_LSB, (uint8_t*)&rawX, 2); // Angular velocity değerleri datasheet üzerinde yazana göre 
-    readBytes(GYR_Y_LSB, (uint8_t*)&rawY, 2); // GYR_X/Y/Z_LSB registerlarından okunabiliyor.
-    readBytes(GYR_Z_LSB, (uint8_t*)&rawZ, 2);
+    uint8_t buffer[6];
+    readBytes(GYR_X_LSB, buffer, 6);
+
+    x = BNO055Decode::readInt16LE(&buffer[0]) / 16.0;
+    y = BNO055Decode::readInt16LE(&buffer[2]) / 16.0;
+    z = BNO055Decode::readInt16LE(&buffer[4]) / 16.0;
+}
+#endif
+
+/**
+ * @brief Reads consecutive 16-bit output registers of the BNO055 sensor.
+ * 
+ * This function reads count LSB/MSB register pairs starting at reg in one burst and assembles them without float conversion, e.g. readRawVector(ACC_X_LSB, values, 3).
+ * 
+ * @param reg The LSB register of the first value.
+ * @param values Pointer to an int16_t array to store the raw values.
+ * @param count The number of values to read, at most 11.
+ * @return True if all bytes were received, false otherwise.
+ */
+bool BNO055::readRawVector(uint8_t reg, int16_t* values, uint8_t count) {
+    BNO055_TRACE_SCOPE(TRACE_READ_RAW_VECTOR);
+    uint8_t buffer[22];
+    if(count > 11) {
+        count = 11;
+    }
+    waitModeReady();
+    selectPage(0x00);
+    if(!readBytes(reg, buffer, 2 * count)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        values[i] = BNO055Decode::readInt16LE(&buffer[2 * i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Reads all output registers of the BNO055 sensor in one burst.
+ * 
+ * This function reads ACC_X_LSB..TEMP (RAW_SNAPSHOT_SIZE bytes) with a single readBytes call, so all channels belong to the same sensor sample.
+ * 
+ * @param raw Pointer to a buffer of at least RAW_SNAPSHOT_SIZE bytes to store the raw register values.
+ * @return True if the registers were read, false if an operation mode switch is still pending or the transfer failed.
+ */
+bool BNO055::readRawSnapshot(uint8_t* raw) {
+    BNO055_TRACE_SCOPE(TRACE_READ_RAW_SNAPSHOT);
+    if(!modeSwitched()) {
+        return false;
+    }
+    selectPage(0x00);
+    return readBytes(RAW_SNAPSHOT_START, raw, RAW_SNAPSHOT_SIZE);
+}
 
-    x = rawX / 16.0;
-    y = rawY / 16.0;
-    z = rawZ / 16.0;
+#if BNO055_ENABLE_FLOAT
+/**
+ * @brief Reads and decodes all output channels of the BNO055 sensor.
+ * 
+ * This function reads a raw snapshot in one burst and converts it with the unit selection last written by setUnit. The timestamp is taken with micros() before the transfer. The snapshot is left unchanged if the read fails.
+ * 
+ * @param snapshot Reference to an imuSnapshot struct to store the decoded values.
+ * @return True if the snapshot was read, false if an operation mode switch is still pending or the transfer failed.
+ */
+bool BNO055::readSnapshot(imuSnapshot& snapshot) {
+    BNO055_TRACE_SCOPE(TRACE_READ_SNAPSHOT);
+    uint8_t raw[RAW_SNAPSHOT_SIZE];
+    uint32_t timestamp = micros();
+    if(!readRawSnapshot(raw)) {
+        return false;
+    }
+    snapshot.timestamp = timestamp;
+    BNO055Decode::decodeSnapshot(raw, unitSel, snapshot);
+    return true;
+}
+
+/**
+ * @brief Reads and decodes all output channels and the health block of the BNO055 sensor.
+ * 
+ * This function extends the snapshot burst to SYS_ERR, so the health information comes with the data at no extra transaction. Note that the burst includes INT_STA.
+ * 
+ * @param snapshot Reference to an imuSnapshot struct to store the decoded values.
+ * @param health Reference to a sensorHealth struct to store the decoded health block.
+ * @return True if the snapshot was read, false if an operation mode switch is still pending or the transfer failed.
+ */
+bool BNO055::readSnapshot(imuSnapshot& snapshot, sensorHealth& health) {
+    BNO055_TRACE_SCOPE(TRACE_READ_SNAPSHOT);
+    uint8_t raw[RAW_SNAPSHOT_HEALTH_SIZE];
+    if(!modeSwitched()) {
+        return false;
+    }
+    uint32_t timestamp = micros();
+    selectPage(0x00);
+    if(!readBytes(RAW_SNAPSHOT_START, raw, RAW_SNAPSHOT_HEALTH_SIZE)) {
+        return false;
+    }
+    snapshot.timestamp = timestamp;
+    BNO055Decode::decodeSnapshot(raw, unitSel, snapshot);
+    BNO055Decode::decodeHealth(&raw[RAW_SNAPSHOT_SIZE], health);
+    return true;
+}
+#endif
+
+/**
+ * @brief Reads the health block of the BNO055 sensor.
+ * 
+ * This function reads CALIB_STAT, SELFTEST_RESULT, INT_STA, SYS_CLK_STATUS, SYS_STATUS and SYS_ERR (0x35-0x3A) in a single burst and decodes them.
+ * 
+ * @param health Reference to a sensorHealth struct to store the decoded health block.
+ * @return True if the registers were read, false if the transfer failed and health was left unchanged.
+ */
+bool BNO055::readHealth(sensorHealth& health) {
+    BNO055_TRACE_SCOPE(TRACE_READ_HEALTH);
+    uint8_t raw[RAW_HEALTH_SIZE];
+    selectPage(0x00);
+    if(!readBytes(RAW_HEALTH_START, raw, RAW_HEALTH_SIZE)) {
+        return false;
+    }
+    BNO055Decode::decodeHealth(raw, health);
+    return true;
 }
 
 /**
  * @brief Gets the system status, self-test results, and system errors from the BNO055 sensor.
  * 
- * This function reads the system status, self-test results, and system errors from the BNO055 sensor and stores them in the provided variables.
+ * This function reads the system status, self-test results, and system errors from the BNO055 sensor in one burst and stores them in the provided variables.
  * 
  * @param system_status Pointer to a uint8_t variable to store the system status.
  * @param self_test_result Pointer to a uint8_t variable to store the self-test results.
  * @param system_error Pointer to a uint8_t variable to store the system errors.
  */
 void BNO055::getSystemStatus(uint8_t *system_status, uint8_t *self_test_result, uint8_t *system_error) {
-    writeByte(PAGE_ID, 0x00);
+    BNO055_TRACE_SCOPE(TRACE_GET_SYSTEM_STATUS);
+    uint8_t raw[RAW_HEALTH_SIZE];
+    selectPage(0x00);
+    readBytes(RAW_HEALTH_START, raw, RAW_HEALTH_SIZE);
       /* System Status
      0 = Idle
      1 = System Error
@@ -912,7 +1417,7 @@ void BNO055::getSystemStatus(uint8_t *system_status, uint8_t *self_test_result,
      6 = System running without fusion algorithms
    */
     if(system_status != 0) {
-        *system_status = readByte(SYS_STATUS);
+        *system_status = raw[SYS_STATUS - RAW_HEALTH_START];
     }
       /* Self Test Results
      1 = test passed, 0 = test failed
@@ -925,7 +1430,7 @@ void BNO055::getSystemStatus(uint8_t *system_status, uint8_t *self_test_result,
      0x0F = all good!
    */
     if(self_test_result != 0) {
-        *self_test_result = readByte(SELFTEST_RESULT);
+        *self_test_result = raw[SELFTEST_RESULT - RAW_HEALTH_START];
     }
       /* System Error (see section 4.3.59)
      0 = No error
@@ -941,11 +1446,11 @@ void BNO055::getSystemStatus(uint8_t *system_status, uint8_t *self_test_result,
      A = Sensor configuration error
    */
     if(system_error != 0) {
-        *system_error = readByte(SYS_ERR);
+        *system_error = raw[SYS_ERR - RAW_HEALTH_START];
     }
-    delay(200);
 }
 
+#if BNO055_ENABLE_CALIBRATION
 /**
  * @brief Checks if the BNO055 sensor is fully calibrated based on the current operation mode.
  * 
@@ -954,7 +1459,7 @@ void BNO055::getSystemStatus(uint8_t *system_status, uint8_t *self_test_result,
  * @return True if the sensor is fully calibrated for the current operation mode, false otherwise.
  */
 bool BNO055::isFullyCalibrated() {
-    setPage(0x00);
+    BNO055_TRACE_SCOPE(TRACE_IS_FULLY_CALIBRATED);
     uint8_t sys, gyro, accel, mag;
     getCalibrationStatus(sys, gyro, accel, mag);
 
@@ -978,6 +1483,7 @@ bool BNO055::isFullyCalibrated() {
         return(sys == 3 && gyro == 3 && accel == 3 && mag == 3);
     }
 }
+#endif
 
 /**
  * @brief Writes a byte of data to a register in the BNO055 sensor.
@@ -989,14 +1495,15 @@ bool BNO055::isFullyCalibrated() {
  * @return True if the data was successfully written to the register, false otherwise.
  */
 bool BNO055::writeByte(uint8_t reg, uint8_t value) {
-    #ifdef I2C
-    Wire.beginTransmission(address);
-    Wire.write(reg);
-    Wire.write(value);
-    return Wire.endTransmission() == 0;
+    BNO055_TRACE_SCOPE(TRACE_WRITE_BYTE);
+    #ifdef BNO055_TRANSPORT_I2C
+    wire->beginTransmission(address);
+    wire->write(reg);
+    wire->write(value);
+    return wire->endTransmission() == 0;
     #endif
 
-    #ifdef UART
+    #ifdef BNO055_TRANSPORT_UART
     uint8_t buffer[5];
     buffer[0] = 0xAA;
     buffer[1] = 0x00;
@@ -1009,16 +1516,73 @@ bool BNO055::writeByte(uint8_t reg, uint8_t value) {
 
     uint8_t response = mySerial.read();
     if (response == 0xEE) {
-        Serial.println("Yazma işlemi başarili.");
+        BNO055_LOG("Write successful.");
     } else {
-        Serial.print("Beklenmeyen yanit: 0x");
-        Serial.println(response, HEX);  // Beklenmeyen yanıtı ekrana yazdır
+        BNO055_LOG_HEX("Unexpected response: 0x", response);
     }
 
     return 1;
     #endif
 }
 
+/**
+ * @brief Writes multiple bytes of data to consecutive registers in the BNO055 sensor.
+ * 
+ * This function writes a block of consecutive registers in as few transactions as possible. On I2C the register address auto-increments and one transmission carries as many bytes as the Wire buffer allows. On UART the length field of the write command carries the whole block.
+ * 
+ * @param reg The starting register address to write the data to.
+ * @param buffer Pointer to the data to write.
+ * @param length The number of bytes to write to consecutive registers.
+ * @return True if all data was successfully written, false otherwise.
+ */
+bool BNO055::writeBytes(uint8_t reg, const uint8_t* buffer, uint8_t length) {
+    BNO055_TRACE_SCOPE(TRACE_WRITE_BYTES);
+    #ifdef BNO055_TRANSPORT_I2C
+    bool success = true;
+    while(length > 0) {
+        uint8_t chunk = (length > BNO055_I2C_BUFFER - 1) ? BNO055_I2C_BUFFER - 1 : length;
+
+        wire->beginTransmission(address);
+        wire->write(reg);
+        for (uint8_t i = 0; i < chunk; i++) {
+            wire->write(buffer[i]);
+        }
+        success = (wire->endTransmission() == 0) && success;
+
+        reg += chunk;
+        buffer += chunk;
+        length -= chunk;
+    }
+    return success;
+    #endif
+
+    #ifdef BNO055_TRANSPORT_UART
+    mySerial.write(0xAA);
+    mySerial.write(0x00);
+    mySerial.write(reg);
+    mySerial.write(length);
+    for (uint8_t i = 0; i < length; i++) {
+        mySerial.write(buffer[i]);
+    }
+
+    unsigned long startMillis = millis();
+    while (mySerial.available() < 2) {
+        if (millis() - startMillis > 1000) {
+            BNO055_LOG("Response cannot received.");
+            return false;
+        }
+    }
+
+    uint8_t response = mySerial.read();
+    uint8_t status = mySerial.read();
+    if (response != 0xEE || status != 0x01) {
+        BNO055_LOG_HEX("Unexpected response: 0x", status);
+        return false;
+    }
+    return true;
+    #endif
+}
+
 /**
  * @brief Reads a byte of data from a register in the BNO055 sensor.
  * 
@@ -1028,22 +1592,23 @@ bool BNO055::writeByte(uint8_t reg, uint8_t value) {
  * @return The byte of data read from the register.
  */
 uint8_t BNO055::readByte(uint8_t reg) {
-    #ifdef I2C
+    BNO055_TRACE_SCOPE(TRACE_READ_BYTE);
+    #ifdef BNO055_TRANSPORT_I2C
     uint8_t value = 0;
 
-    Wire.beginTransmission(address);
-    Wire.write(reg);
-    Wire.endTransmission();
+    wire->beginTransmission(address);
+    wire->write(reg);
+    wire->endTransmission();
 
-    Wire.requestFrom(address, 1);
-    if(Wire.available()) {
-        value = Wire.read();
+    wire->requestFrom(address, 1);
+    if(wire->available()) {
+        value = wire->read();
     }
 
     return value;
     #endif
 
-    #ifdef UART
+    #ifdef BNO055_TRANSPORT_UART
     uint8_t buffer[4];
     uint8_t response = 0;
     uint8_t count = 0;
@@ -1061,7 +1626,7 @@ uint8_t BNO055::readByte(uint8_t reg) {
     unsigned long startMillis = millis();
     while (mySerial.available() < 1) {
         if (millis() - startMillis > 1000) {
-        Serial.println("Response cannot received.");
+        BNO055_LOG("Response cannot received.");
         return 0;
         }
     }
@@ -1077,40 +1642,52 @@ uint8_t BNO055::readByte(uint8_t reg) {
         }
     if (response==0xEE)
         {
-        Serial.print(mySerial.read(), HEX);    
+        BNO055_LOG_HEX("Error response: 0x", mySerial.read());
         }  
     return value;
     #endif
 }
 
-uint8_t rx_buffer[255];
-
 /**
  * @brief Reads multiple bytes of data from consecutive registers in the BNO055 sensor.
  * 
- * This function starts a transmission with the BNO055 sensor, requests multiple bytes of data starting from the specified register, and stores the read data in the provided buffer.
+ * This function starts a transmission with the BNO055 sensor, requests multiple bytes of data starting from the specified register, and stores the read data in the provided buffer. On I2C, reads longer than the Wire buffer are split into several transfers.
  * 
  * @param reg The starting register address to read the data from.
  * @param buffer Pointer to a uint8_t array to store the read data.
  * @param length The number of bytes to read from consecutive registers.
- * @return True if the data was successfully read and stored in the buffer, false otherwise.
- */
-void BNO055::readBytes(uint8_t reg, uint8_t* buffer, uint8_t length) {
-    #ifdef I2C
-    Wire.beginTransmission(address);
-    Wire.write(reg);
-    Wire.endTransmission();
-
-    Wire.requestFrom(address, length);
-    for (uint8_t i = 0; i < length; i++)
-    {
-        if(Wire.available()) {
-            buffer[i] = Wire.read();
+ * @return True if all bytes were received, false otherwise.
+ */
+bool BNO055::readBytes(uint8_t reg, uint8_t* buffer, uint8_t length) {
+    BNO055_TRACE_SCOPE(TRACE_READ_BYTES);
+    #ifdef BNO055_TRANSPORT_I2C
+    bool success = true;
+    while(length > 0) {
+        uint8_t chunk = (length > BNO055_I2C_BUFFER) ? BNO055_I2C_BUFFER : length;
+
+        wire->beginTransmission(address);
+        wire->write(reg);
+        if(wire->endTransmission() != 0) {
+            success = false;
+        }
+
+        if(wire->requestFrom(address, chunk) != chunk) {
+            success = false;
         }
+        for (uint8_t i = 0; i < chunk; i++)
+        {
+            if(wire->available()) {
+                buffer[i] = wire->read();
+            }
+        }
+        reg += chunk;
+        buffer += chunk;
+        length -= chunk;
     }
+    return success;
     #endif
 
-    #ifdef UART
+    #ifdef BNO055_TRANSPORT_UART
     uint8_t array[4];
     uint8_t response = 0;
     uint8_t count = 0;
@@ -1124,30 +1701,41 @@ void BNO055::readBytes(uint8_t reg, uint8_t* buffer, uint8_t length) {
         mySerial.write(array[i]);
     }
 
+    // response header: 0xBB and the length, or 0xEE and a status byte
     unsigned long startMillis = millis();
-    while (mySerial.available() < length) {
+    while (mySerial.available() < 2) {
         if (millis() - startMillis > 1000) {
-        Serial.println("Response cannot received.");
+            BNO055_LOG("Response cannot received.");
+            return false;
         }
     }
 
     response = mySerial.read();
-    if (response == 0xBB);
-        {
-        count = mySerial.read();
-        for(int i = 0; i < count ; i++){
-            buffer[i]=mySerial.read();
-        }
+    count = mySerial.read();
+    if (response == 0xEE) {
+        BNO055_LOG_HEX("Error response: 0x", count);
+        return false;
+    }
+    if (response != 0xBB || count != length) {
+        return false;
+    }
 
+    while (mySerial.available() < length) {
+        if (millis() - startMillis > 1000) {
+            BNO055_LOG("Response cannot received.");
+            return false;
         }
-    if (response == 0xEE)
-        {
-        Serial.print(mySerial.read(), HEX);    
-        }  
+    }
+    for (int i = 0; i < length; i++) {
+        buffer[i] = mySerial.read();
+    }
+    return true;
     #endif
 }
 
+#ifdef BNO055_TRANSPORT_UART
 bool BNO055::writeByteUART(uint8_t reg, uint8_t value) {
+    BNO055_TRACE_SCOPE(TRACE_WRITE_BYTE_UART);
     Serial.write(0xAA);
     Serial.write(0x00);
     Serial.write(reg);
@@ -1159,6 +1747,7 @@ bool BNO055::writeByteUART(uint8_t reg, uint8_t value) {
 }
 
 uint8_t BNO055::readByteUART(uint8_t reg) {
+    BNO055_TRACE_SCOPE(TRACE_READ_BYTE_UART);
     Serial.write(0xAA);
     Serial.write(0x01);
     Serial.write(reg);
@@ -1167,4 +1756,5 @@ uint8_t BNO055::readByteUART(uint8_t reg) {
     Serial.write(0x01);
     uint8_t data = Serial.read();
     return data;
-}
\ No newline at end of file
+}
+#endif
@@ -2,7 +2,26 @@
 #define BNO055_h
 
 #include <Arduino.h>
+#include "BNO055Config.h"
 #include <Wire.h>
+#include "BNO055Registers.h"
+#include "BNO055Decode.h"
+#include "BNO055RegisterMap.h"
+#include "BNO055AxisRemap.h"
+#include "BNO055Trace.h"
+
+//I2C TRANSFER LIMIT
+#if defined(BUFFER_LENGTH)
+#define BNO055_I2C_BUFFER BUFFER_LENGTH
+#elif defined(I2C_BUFFER_LENGTH)
+#define BNO055_I2C_BUFFER I2C_BUFFER_LENGTH
+#else
+#define BNO055_I2C_BUFFER 32
+#endif
+
+//OPERATION MODE SWITCHING TIME (us)
+#define BNO055_MODE_FROM_CONFIG 7000
+#define BNO055_MODE_TO_CONFIG 19000
 
 //PAGE 0 DESCRIPTION
 #define CHIP_ID 0x00
@@ -181,6 +200,50 @@ typedef struct {
   uint8_t bl_rev;
 } revInfo;
 
+typedef struct {
+  int16_t accX;
+  int16_t accY;
+  int16_t accZ;
+  int16_t magX;
+  int16_t magY;
+  int16_t magZ;
+  int16_t gyrX;
+  int16_t gyrY;
+  int16_t gyrZ;
+  int16_t accRadius;
+  int16_t magRadius;
+} calibOffsets;
+
+// Register image of INT_MSK..GYR_AM_SET (page 1, 0x0F-0x1F) in address order.
+typedef struct {
+  uint8_t intMask;
+  uint8_t intEnable;
+  uint8_t accAmThres;
+  uint8_t accIntSettings;
+  uint8_t accHgDuration;
+  uint8_t accHgThres;
+  uint8_t accNmThres;
+  uint8_t accNmSet;
+  uint8_t gyrIntSetting;
+  uint8_t gyrHrXSet;
+  uint8_t gyrDurX;
+  uint8_t gyrHrYSet;
+  uint8_t gyrDurY;
+  uint8_t gyrHrZSet;
+  uint8_t gyrDurZ;
+  uint8_t gyrAmThres;
+  uint8_t gyrAmSet;
+} interruptConfig;
+
+// Register image of the configuration that survives an MCU-only reset: UNIT_SEL..AXIS_MAP_SIGN
+// (page 0, 0x3B-0x42), ACC_OFFSET_X_LSB..MAG_RADIUS_MSB (page 0, 0x55-0x6A) and
+// ACC_CONFIG..GYR_AM_SET (page 1, 0x08-0x1F), each in address order.
+typedef struct {
+  uint8_t system[8];
+  uint8_t offsets[22];
+  uint8_t sensor[24];
+} configImage;
+
 enum axisRemapSign {
   REMAP_SIGN_P0 = 0x04,
   REMAP_SIGN_P1 = 0x00, // default
@@ -274,14 +337,22 @@ enum MagOPMode {
 class BNO055 {
   public:
       BNO055();
+      BNO055(uint8_t address, TwoWire& wire = Wire);
       bool begin();
+      bool warmStart(uint32_t configHash);
       void reset();
       bool isReady();
       void setPowerMode(PowerMode powermode);
-      void setOperationMode(OperationMode mode);
+      uint32_t setOperationMode(OperationMode mode);
       OperationMode getMode();
+      bool isModeReady();
+      void waitModeReady();
+      PowerMode getPowerMode();
       void setPage(uint8_t page);
       void getPage();
+      uint8_t getAddress();
+      TwoWire& getWire();
+#if BNO055_ENABLE_INTERRUPTS
       void interruptReset();
       void interruptMask(uint8_t mask);
       void interruptEnable(uint8_t regVal);
@@ -301,12 +372,14 @@ class BNO055 {
       void gyrDurationZ(uint8_t duration);
       void gyrAmThresh(uint8_t threshold);
       void gyrAmSet(uint8_t duration, uint8_t samples);
+#endif
       void setUnit(uint8_t unitValue);
       void setAccConfig(AccRange accRange, AccBW accBW, AccOPMode accOPmode);
       void setGyroConfig(GyrRange gyrRange, GyrBW gyrBW, GyrOPMode gyrOPmode);
       void setMagConfig(MagRate rate, MagPMode Pmode, MagOPMode magOPmode);
       void setAccSleepConfig(uint8_t duration, bool mode);
       void setGyrSleepConfig(uint8_t autoSleepDuration, uint8_t sleepDuration);
+#if BNO055_ENABLE_CALIBRATION
       void accOffsetX(uint16_t offset);
       void accOffsetY(uint16_t offset);
       void accOffsetZ(uint16_t offset);
@@ -316,29 +389,66 @@ class BNO055 {
       void gyrOffsetX(uint16_t offset);
       void gyrOffsetY(uint16_t offset);
       void gyrOffsetZ(uint16_t offset);
-      void getAcceleration(float& x, float& y, float& z);
+      bool setCalibrationOffsets(const calibOffsets *offsets);
+      void getCalibrationOffsets(calibOffsets *offsets);
+#endif
+#if BNO055_ENABLE_INTERRUPTS
+      bool setInterruptConfig(const interruptConfig *config);
+      void getInterruptConfig(interruptConfig *config);
+#endif
       void setAxisRemap(axisRemapConfig remapconfig);
       void setAxisSign(axisRemapSign remapsign);
+      void setAxisPlacement(AxisPlacement placement);
       void getrevInfo(revInfo *);
+      bool readConfigImage(configImage *image);
+      uint32_t getConfigHash();
+      static uint32_t hashConfigImage(const configImage *image);
+      void dumpRegisters(registerImage *image);
+      bool restoreRegisters(const registerImage *image);
+      static void printRegisterImage(const registerImage *image, Print& out);
+#if BNO055_ENABLE_FLOAT
+      void getAcceleration(float& x, float& y, float& z);
       void getGravity(float& x, float& y, float& z);
       void getLinearAcceleration(float& x, float& y, float& z);
       void getEulerAngles(float& heading, float& roll, float& pitch);
       void getQuaternions(float& w, float& x, float& y, float& z);
-      void getCalibrationStatus(uint8_t& sys, uint8_t& gyro, uint8_t& accel, uint8_t& mag);
       void getMagnetometer(float& x, float& y, float& z);
       void getGyroscope(float &x, float &y, float &z);
       void getTemperature(float& temperature);
       void getQuaternionAccuracy(float& w, float& x, float& y, float& z);
       void getAngularVelocity(float& x, float& y, float& z);
-      void getSystemStatus(uint8_t *system_status, uint8_t *self_test_result, uint8_t *system_error);
+      bool readSnapshot(imuSnapshot& snapshot);
+      bool readSnapshot(imuSnapshot& snapshot, sensorHealth& health);
+#endif
+      bool readRawVector(uint8_t reg, int16_t* values, uint8_t count);
+      bool readRawSnapshot(uint8_t* raw);
+#if BNO055_ENABLE_CALIBRATION
+      void getCalibrationStatus(uint8_t& sys, uint8_t& gyro, uint8_t& accel, uint8_t& mag);
       bool isFullyCalibrated();
+#endif
+      bool readHealth(sensorHealth& health);
+      void getSystemStatus(uint8_t *system_status, uint8_t *self_test_result, uint8_t *system_error);
       bool writeByte(uint8_t reg, uint8_t value);
+      bool writeBytes(uint8_t reg, const uint8_t* buffer, uint8_t length);
       uint8_t readByte(uint8_t reg);
-      void readBytes(uint8_t reg, uint8_t* buffer, uint8_t length);
+      bool readBytes(uint8_t reg, uint8_t* buffer, uint8_t length);
+#ifdef BNO055_TRANSPORT_UART
       bool writeByteUART(uint8_t reg, uint8_t value);
       uint8_t readByteUART(uint8_t reg);
+#endif
+      template<typename Field> uint16_t read();
+      template<typename... Fields, typename... Values> bool write(Values... values);
   private:
+      void selectPage(uint8_t page);
+      bool modeSwitched();
+
+      TwoWire* wire;
       uint8_t address;
+      uint8_t page;
+      uint8_t unitSel;
+      uint32_t modeReadyAt;
+      bool modeKnown;
+      bool modePending;
 
       OperationMode mode;
       PowerMode powermode;
@@ -354,4 +464,70 @@ class BNO055 {
       axisRemapConfig remapconfig;
       axisRemapSign remapsign;
 };
+
+/**
+ * @brief Reads a field of a typed register.
+ * 
+ * This function selects the register page if necessary, reads the register and extracts the field. 16-bit registers are read LSB first.
+ * 
+ * @tparam Field The field to read, e.g. BNO055Reg::CalibStatSys.
+ * @return The value of the field.
+ */
+template<typename Field>
+uint16_t BNO055::read() {
+    BNO055_TRACE_SCOPE(TRACE_READ_FIELD);
+    typedef typename Field::reg Reg;
+    static_assert(Reg::readable, "register is write-only");
+    selectPage(Reg::page);
+
+    uint16_t raw;
+    if(Reg::width == 2) {
+        uint8_t buffer[2];
+        readBytes(Reg::address, buffer, 2);
+        raw = (uint16_t)buffer[0] | ((uint16_t)buffer[1] << 8);
+    }
+    else {
+        raw = readByte(Reg::address);
+    }
+    return Field::unpack(raw);
+}
+
+/**
+ * @brief Writes one or more fields of a typed register in a single transaction.
+ * 
+ * This function selects the register page if necessary and packs all values into one register value at compile time. If the fields do not cover the whole register, the other bits are preserved by a read-modify-write; on write-only registers they are written as zero. All fields must belong to the same register.
+ * 
+ * @tparam Fields The fields to write, e.g. BNO055Reg::AccConfigRange, BNO055Reg::AccConfigBW.
+ * @param values One value per field, in the same order.
+ * @return True if the register was successfully written, false otherwise.
+ */
+template<typename... Fields, typename... Values>
+bool BNO055::write(Values... values) {
+    BNO055_TRACE_SCOPE(TRACE_WRITE_FIELDS);
+    typedef BNO055Reg::FieldSet<Fields...> Set;
+    typedef typename Set::reg Reg;
+    static_assert(sizeof...(Fields) == sizeof...(Values), "one value per field is required");
+    static_assert(Reg::writable, "register is read-only");
+    selectPage(Reg::page);
+
+    uint16_t value = Set::pack((uint16_t)values...);
+    if(Set::mask != Reg::fullMask && Reg::readable) {
+        uint16_t raw;
+        if(Reg::width == 2) {
+            uint8_t buffer[2];
+            readBytes(Reg::address, buffer, 2);
+            raw = (uint16_t)buffer[0] | ((uint16_t)buffer[1] << 8);
+        }
+        else {
+            raw = readByte(Reg::address);
+        }
+        value |= raw & ~Set::mask;
+    }
+
+    if(Reg::width == 2) {
+        uint8_t buffer[2] = { (uint8_t)(value & 0x00FF), (uint8_t)(value >> 8) };
+        return writeBytes(Reg::address, buffer, 2);
+    }
+    return writeByte(Reg::address, (uint8_t)value);
+}
 #endif
\ No newline at end of file
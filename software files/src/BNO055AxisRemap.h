@@ -0,0 +1,205 @@
+#ifndef BNO055AxisRemap_h
+#define BNO055AxisRemap_h
+
+#include <stdint.h>
+#include "BNO055Decode.h"
+
+// Datasheet mounting placements. Unlike the axisRemapConfig/axisRemapSign register values,
+// which repeat between placements, each placement has its own value.
+enum AxisPlacement {
+  AXIS_PLACEMENT_P0 = 0x00,
+  AXIS_PLACEMENT_P1 = 0x01, // default
+  AXIS_PLACEMENT_P2 = 0x02,
+  AXIS_PLACEMENT_P3 = 0x03,
+  AXIS_PLACEMENT_P4 = 0x04,
+  AXIS_PLACEMENT_P5 = 0x05,
+  AXIS_PLACEMENT_P6 = 0x06,
+  AXIS_PLACEMENT_P7 = 0x07
+};
+
+// Host-side axis remapping. A remap is described like the AXIS_MAP_CONFIG/AXIS_MAP_SIGN
+// registers: two bits per output axis select the source axis (X=0, Y=1, Z=2), one sign bit
+// per output axis (X=bit 2, Y=bit 1, Z=bit 0) negates it. Vectors are remapped as
+// v' = M v, quaternions as q' = q ⊗ conj(r) with r the rotation of M, so the sensor
+// stays in its operation mode. Everything is constexpr: FixedRemap<> resolves the source
+// indices, signs and the rotation quaternion at compile time, AxisRemap handles remaps
+// chosen at run time.
+namespace BNO055Remap {
+
+constexpr uint8_t placementConfig(AxisPlacement placement) {
+    return (placement == AXIS_PLACEMENT_P0 || placement == AXIS_PLACEMENT_P3 ||
+            placement == AXIS_PLACEMENT_P5 || placement == AXIS_PLACEMENT_P6) ? 0x21 : 0x24;
+}
+
+constexpr uint8_t placementSign(AxisPlacement placement) {
+    return placement == AXIS_PLACEMENT_P0 ? 0x04 :
+           placement == AXIS_PLACEMENT_P1 ? 0x00 :
+           placement == AXIS_PLACEMENT_P2 ? 0x06 :
+           placement == AXIS_PLACEMENT_P3 ? 0x02 :
+           placement == AXIS_PLACEMENT_P4 ? 0x03 :
+           placement == AXIS_PLACEMENT_P5 ? 0x01 :
+           placement == AXIS_PLACEMENT_P6 ? 0x07 : 0x05;
+}
+
+constexpr uint8_t source(uint8_t config, uint8_t axis) {
+    return (config >> (2 * axis)) & 0x03;
+}
+
+constexpr int8_t axisSign(uint8_t sign, uint8_t axis) {
+    return ((sign >> (2 - axis)) & 0x01) ? -1 : 1;
+}
+
+constexpr int8_t element(uint8_t config, uint8_t sign, uint8_t row, uint8_t col) {
+    return source(config, row) == col ? axisSign(sign, row) : 0;
+}
+
+constexpr bool isPermutation(uint8_t config) {
+    return source(config, 0) < 3 && source(config, 1) < 3 && source(config, 2) < 3 &&
+           source(config, 0) != source(config, 1) && source(config, 0) != source(config, 2) &&
+           source(config, 1) != source(config, 2) && (config & 0xC0) == 0;
+}
+
+constexpr int8_t determinant(uint8_t config, uint8_t sign) {
+    return element(config, sign, 0, 0) * (element(config, sign, 1, 1) * element(config, sign, 2, 2) - element(config, sign, 1, 2) * element(config, sign, 2, 1))
+         - element(config, sign, 0, 1) * (element(config, sign, 1, 0) * element(config, sign, 2, 2) - element(config, sign, 1, 2) * element(config, sign, 2, 0))
+         + element(config, sign, 0, 2) * (element(config, sign, 1, 0) * element(config, sign, 2, 1) - element(config, sign, 1, 1) * element(config, sign, 2, 0));
+}
+
+// Only proper rotations (determinant +1) have a quaternion; mirrored remaps can still be applied to vectors.
+constexpr bool isRotation(uint8_t config, uint8_t sign) {
+    return isPermutation(config) && determinant(config, sign) == 1;
+}
+
+constexpr float sqrtStep(float x, float guess, uint8_t steps) {
+    return steps == 0 ? guess : sqrtStep(x, 0.5f * (guess + x / guess), steps - 1);
+}
+
+// Newton iteration; the arguments here are 1..4, for which 8 steps are exact in float.
+constexpr float constSqrt(float x) {
+    return x <= 0 ? 0 : sqrtStep(x, 0.5f * (x + 1.0f), 8);
+}
+
+constexpr float diagonal(uint8_t config, uint8_t sign, uint8_t axis) {
+    return (float)element(config, sign, axis, axis);
+}
+
+// Shepperd's method: 0 = trace, 1..3 = largest diagonal element
+constexpr uint8_t pivot(uint8_t config, uint8_t sign) {
+    return (diagonal(config, sign, 0) + diagonal(config, sign, 1) + diagonal(config, sign, 2) > 0) ? 0 :
+           (diagonal(config, sign, 0) >= diagonal(config, sign, 1) && diagonal(config, sign, 0) >= diagonal(config, sign, 2)) ? 1 :
+           (diagonal(config, sign, 1) >= diagonal(config, sign, 2)) ? 2 : 3;
+}
+
+constexpr float pivotScale(uint8_t config, uint8_t sign, uint8_t p) {
+    return 2.0f * constSqrt(1.0f + (p == 0 ? diagonal(config, sign, 0) + diagonal(config, sign, 1) + diagonal(config, sign, 2) :
+                                   2.0f * diagonal(config, sign, p - 1) - diagonal(config, sign, 0) - diagonal(config, sign, 1) - diagonal(config, sign, 2)));
+}
+
+// Off-diagonal combination for quaternion component k (w, x, y, z) relative to pivot p.
+constexpr float offDiagonal(uint8_t config, uint8_t sign, uint8_t p, uint8_t k) {
+    return (p == 0 && k == 1) || (p == 1 && k == 0) ? (float)(element(config, sign, 2, 1) - element(config, sign, 1, 2)) :
+           (p == 0 && k == 2) || (p == 2 && k == 0) ? (float)(element(config, sign, 0, 2) - element(config, sign, 2, 0)) :
+           (p == 0 && k == 3) || (p == 3 && k == 0) ? (float)(element(config, sign, 1, 0) - element(config, sign, 0, 1)) :
+           (p == 1 && k == 2) || (p == 2 && k == 1) ? (float)(element(config, sign, 0, 1) + element(config, sign, 1, 0)) :
+           (p == 1 && k == 3) || (p == 3 && k == 1) ? (float)(element(config, sign, 0, 2) + element(config, sign, 2, 0)) :
+                                                      (float)(element(config, sign, 1, 2) + element(config, sign, 2, 1));
+}
+
+constexpr float rotationComponent(uint8_t config, uint8_t sign, uint8_t p, uint8_t k) {
+    return p == k ? 0.25f * pivotScale(config, sign, p) : offDiagonal(config, sign, p, k) / pivotScale(config, sign, p);
+}
+
+// Component k (w, x, y, z) of the rotation quaternion r of a remap.
+constexpr float rotation(uint8_t config, uint8_t sign, uint8_t k) {
+    return rotationComponent(config, sign, pivot(config, sign), k);
+}
+
+inline void multiplyConjugate(const float* q, float rw, float rx, float ry, float rz, float* out) {
+    float w = q[0] * rw + q[1] * rx + q[2] * ry + q[3] * rz;
+    float x = -q[0] * rx + q[1] * rw - q[2] * rz + q[3] * ry;
+    float y = -q[0] * ry + q[1] * rz + q[2] * rw - q[3] * rx;
+    float z = -q[0] * rz - q[1] * ry + q[2] * rx + q[3] * rw;
+    out[0] = w;
+    out[1] = x;
+    out[2] = y;
+    out[3] = z;
+}
+
+// Remap chosen at run time, e.g. from a stored mounting setting.
+struct AxisRemap {
+    uint8_t config;
+    uint8_t sign;
+    float r[4];
+
+    constexpr AxisRemap(uint8_t config, uint8_t sign)
+        : config(config), sign(sign),
+          r{ rotation(config, sign, 0), rotation(config, sign, 1), rotation(config, sign, 2), rotation(config, sign, 3) } {}
+    constexpr AxisRemap(AxisPlacement placement)
+        : AxisRemap(placementConfig(placement), placementSign(placement)) {}
+
+    constexpr bool isRotation() const {
+        return BNO055Remap::isRotation(config, sign);
+    }
+
+    template<typename T> void vector(const T* in, T* out) const {
+        T x = in[source(config, 0)];
+        T y = in[source(config, 1)];
+        T z = in[source(config, 2)];
+        out[0] = (sign & 0x04) ? -x : x;
+        out[1] = (sign & 0x02) ? -y : y;
+        out[2] = (sign & 0x01) ? -z : z;
+    }
+
+    // Returns false, leaving out unchanged, if the remap is mirrored.
+    bool quaternion(const float* in, float* out) const {
+        if(!isRotation()) {
+            return false;
+        }
+        multiplyConjugate(in, r[0], r[1], r[2], r[3], out);
+        return true;
+    }
+
+    // Euler angles are left unchanged; derive them from the remapped quaternion.
+    void snapshot(imuSnapshot& s) const {
+        vector(s.acc, s.acc);
+        vector(s.mag, s.mag);
+        vector(s.gyr, s.gyr);
+        vector(s.lia, s.lia);
+        vector(s.grv, s.grv);
+        quaternion(s.qua, s.qua);
+    }
+};
+
+// Remap fixed at compile time: source indices, signs and the quaternion are constants.
+template<uint8_t Config, uint8_t Sign> struct FixedRemap {
+    static_assert(isPermutation(Config), "AXIS_MAP_CONFIG value must select every axis once");
+
+    template<typename T> static inline void vector(const T* in, T* out) {
+        T x = in[source(Config, 0)];
+        T y = in[source(Config, 1)];
+        T z = in[source(Config, 2)];
+        out[0] = (Sign & 0x04) ? -x : x;
+        out[1] = (Sign & 0x02) ? -y : y;
+        out[2] = (Sign & 0x01) ? -z : z;
+    }
+
+    static inline void quaternion(const float* in, float* out) {
+        static_assert(isRotation(Config, Sign), "mirrored remaps have no quaternion");
+        multiplyConjugate(in, rotation(Config, Sign, 0), rotation(Config, Sign, 1), rotation(Config, Sign, 2), rotation(Config, Sign, 3), out);
+    }
+
+    // Euler angles are left unchanged; derive them from the remapped quaternion.
+    static inline void snapshot(imuSnapshot& s) {
+        vector(s.acc, s.acc);
+        vector(s.mag, s.mag);
+        vector(s.gyr, s.gyr);
+        vector(s.lia, s.lia);
+        vector(s.grv, s.grv);
+        quaternion(s.qua, s.qua);
+    }
+};
+
+template<AxisPlacement Placement> struct PlacementRemap : FixedRemap<placementConfig(Placement), placementSign(Placement)> {};
+
+}
+#endif
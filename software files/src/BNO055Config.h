@@ -0,0 +1,72 @@
+#ifndef BNO055Config_h
+#define BNO055Config_h
+
+// Compile-time feature selection. Edit the defaults below or pass the macros as build
+// flags (e.g. PlatformIO build_flags = -DBNO055_ENABLE_FLOAT=0). Disabled features are
+// not compiled at all, so they cost neither flash nor RAM. extras/size_report prints the
+// footprint of each feature set.
+
+// Transport: BNO055_TRANSPORT_I2C (default) or BNO055_TRANSPORT_UART.
+#if !defined(BNO055_TRANSPORT_I2C) && !defined(BNO055_TRANSPORT_UART)
+#define BNO055_TRANSPORT_I2C
+#endif
+#if defined(BNO055_TRANSPORT_I2C) && defined(BNO055_TRANSPORT_UART)
+#error "Select only one of BNO055_TRANSPORT_I2C and BNO055_TRANSPORT_UART"
+#endif
+
+// SoftwareSerial pins used by the UART transport.
+#ifndef BNO055_UART_RX_PIN
+#define BNO055_UART_RX_PIN 21
+#endif
+#ifndef BNO055_UART_TX_PIN
+#define BNO055_UART_TX_PIN 22
+#endif
+
+// Serial diagnostic messages of the UART transport.
+#ifndef BNO055_ENABLE_DIAGNOSTICS
+#define BNO055_ENABLE_DIAGNOSTICS 0
+#endif
+
+// Interrupt configuration setters (INT_MSK..GYR_AM_SET).
+#ifndef BNO055_ENABLE_INTERRUPTS
+#define BNO055_ENABLE_INTERRUPTS 1
+#endif
+
+// Calibration status and offset helpers.
+#ifndef BNO055_ENABLE_CALIBRATION
+#define BNO055_ENABLE_CALIBRATION 1
+#endif
+
+// Float getters and snapshot decoding; raw integer reads stay available.
+#ifndef BNO055_ENABLE_FLOAT
+#define BNO055_ENABLE_FLOAT 1
+#endif
+
+// BNO055FastRead drives the AVR TWI registers directly instead of going through the Wire
+// buffers. Only used on AVR with the I2C transport; Wire.begin() must still be called.
+#ifndef BNO055_ENABLE_DIRECT_TWI
+#define BNO055_ENABLE_DIRECT_TWI 0
+#endif
+
+// Tracepoints at every transport operation and public API entry/exit (BNO055Trace.h),
+// recorded with the cycle counter into a ring of BNO055_TRACE_SIZE events.
+#ifndef BNO055_ENABLE_TRACE
+#define BNO055_ENABLE_TRACE 0
+#endif
+#ifndef BNO055_TRACE_SIZE
+#if defined(__AVR__)
+#define BNO055_TRACE_SIZE 32
+#else
+#define BNO055_TRACE_SIZE 512
+#endif
+#endif
+
+#if BNO055_ENABLE_DIAGNOSTICS
+#define BNO055_LOG(message) Serial.println(F(message))
+#define BNO055_LOG_HEX(message, value) do { Serial.print(F(message)); Serial.println(value, HEX); } while(0)
+#else
+#define BNO055_LOG(message) do {} while(0)
+#define BNO055_LOG_HEX(message, value) do {} while(0)
+#endif
+
+#endif
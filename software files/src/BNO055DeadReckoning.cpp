@@ -0,0 +1,239 @@
+#include "BNO055DeadReckoning.h"
+#include <string.h>
+#include <math.h>
+
+#define DR_VARIANCE_ALPHA 0.3f   // weight of a new sample in the stance variance
+#define DR_BIAS_ALPHA 0.02f      // weight of a stationary sample in the bias estimate
+
+/**
+ * @brief Constructor for BNO055DeadReckoning class.
+ *
+ * Loads the default stance thresholds: gyro rate below 15 dps and acceleration variance below 0.05 (m/s²)² for 100 ms, and a maximum gap of 100 ms.
+ */
+BNO055DeadReckoning::BNO055DeadReckoning() {
+    setStance(15.0f, 0.05f, 100000);
+    setMaxGap(100000);
+    reset();
+}
+
+/**
+ * @brief Discards the state, the bias estimate and the statistics. The position restarts at the origin.
+ */
+void BNO055DeadReckoning::reset() {
+    started = false;
+    stationary = false;
+    lastTime = 0;
+    quietTime = 0;
+    movingSince = 0;
+    variance = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        mean[i] = 0;
+        lastAcc[i] = 0;
+        bias[i] = 0;
+        velocity[i] = 0;
+        position[i] = 0;
+    }
+    resetStats();
+}
+
+/**
+ * @brief Sets the stance detection thresholds.
+ *
+ * A sample is quiet when the gyro rate and the variance of the acceleration vector are below the thresholds; the sensor is stationary after duration us of quiet samples.
+ *
+ * @param gyroRate The maximum angular rate in dps.
+ * @param accVariance The maximum variance of the acceleration vector (sum over the axes) in (m/s²)².
+ * @param duration The time the thresholds have to hold in us, 0 for a single sample.
+ */
+void BNO055DeadReckoning::setStance(float gyroRate, float accVariance, uint32_t duration) {
+    gyroRateSq = gyroRate * gyroRate;
+    stanceVariance = accVariance;
+    stanceDuration = duration;
+}
+
+/**
+ * @brief Sets the longest time between two samples that is still integrated.
+ *
+ * After a longer gap, e.g. a failed read, integration restarts at the next sample and the velocity is kept.
+ *
+ * @param gap The maximum gap in us.
+ */
+void BNO055DeadReckoning::setMaxGap(uint32_t gap) {
+    maxGap = gap;
+}
+
+/**
+ * @brief Sets the position, e.g. from an external fix.
+ *
+ * @param position The position in m (x, y, z in the world frame).
+ */
+void BNO055DeadReckoning::setPosition(const float* position) {
+    memcpy(this->position, position, sizeof(this->position));
+}
+
+/**
+ * @brief Processes a snapshot.
+ *
+ * Uses the quaternion, the linear acceleration, the acceleration and the gyro rate of the snapshot, so the sensor has to run in a fusion mode.
+ *
+ * @param snapshot The decoded snapshot.
+ * @return True if the sensor is stationary.
+ */
+bool BNO055DeadReckoning::update(const imuSnapshot& snapshot) {
+    // rotate the linear acceleration into the world frame: a' = a + 2w(u x a) + 2u x (u x a)
+    const float* q = snapshot.qua;
+    const float* l = snapshot.lia;
+    float t[3] = {
+        2.0f * (q[2] * l[2] - q[3] * l[1]),
+        2.0f * (q[3] * l[0] - q[1] * l[2]),
+        2.0f * (q[1] * l[1] - q[2] * l[0])
+    };
+    float acc[3] = {
+        l[0] + q[0] * t[0] + q[2] * t[2] - q[3] * t[1] - bias[0],
+        l[1] + q[0] * t[1] + q[3] * t[0] - q[1] * t[2] - bias[1],
+        l[2] + q[0] * t[2] + q[1] * t[1] - q[2] * t[0] - bias[2]
+    };
+
+    if(!started) {
+        started = true;
+        lastTime = snapshot.timestamp;
+        movingSince = snapshot.timestamp;
+        memcpy(mean, snapshot.acc, sizeof(mean));
+        memcpy(lastAcc, acc, sizeof(lastAcc));
+        stats.samples++;
+        return stationary;
+    }
+
+    uint32_t dt = snapshot.timestamp - lastTime;
+    lastTime = snapshot.timestamp;
+    stats.samples++;
+    if(dt > maxGap) {
+        stats.gaps++;
+        quietTime = 0;
+        memcpy(lastAcc, acc, sizeof(lastAcc));
+        return stationary;
+    }
+
+    bool stance = detectStance(snapshot, dt);
+    if(stance && !stationary) {
+        zeroVelocityUpdate(snapshot.timestamp);
+    }
+    else if(!stance && stationary) {
+        movingSince = snapshot.timestamp;
+    }
+    stationary = stance;
+
+    if(stationary) {
+        stats.stanceSamples++;
+        for (uint8_t i = 0; i < 3; i++) {
+            bias[i] += DR_BIAS_ALPHA * acc[i];
+            lastAcc[i] = 0;
+            velocity[i] = 0;
+        }
+        return true;
+    }
+
+    float h = dt * 0.5e-6f;
+    for (uint8_t i = 0; i < 3; i++) {
+        float v = velocity[i] + (lastAcc[i] + acc[i]) * h;
+        position[i] += (velocity[i] + v) * h;
+        velocity[i] = v;
+        lastAcc[i] = acc[i];
+    }
+    return false;
+}
+
+/**
+ * @brief Updates the stance detector.
+ *
+ * @param snapshot The decoded snapshot.
+ * @param dt The time since the previous sample in us.
+ * @return True if the thresholds held for the stance duration.
+ */
+bool BNO055DeadReckoning::detectStance(const imuSnapshot& snapshot, uint32_t dt) {
+    float distance = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        float delta = snapshot.acc[i] - mean[i];
+        mean[i] += DR_VARIANCE_ALPHA * delta;
+        distance += delta * delta;
+    }
+    variance = (1.0f - DR_VARIANCE_ALPHA) * (variance + DR_VARIANCE_ALPHA * distance);
+
+    const float* g = snapshot.gyr;
+    float rateSq = g[0] * g[0] + g[1] * g[1] + g[2] * g[2];
+    if(rateSq >= gyroRateSq || variance >= stanceVariance) {
+        quietTime = 0;
+        return false;
+    }
+    if(quietTime < stanceDuration) {
+        quietTime += dt;
+    }
+    return quietTime >= stanceDuration;
+}
+
+/**
+ * @brief Removes the velocity error at the start of a stationary phase.
+ *
+ * The velocity at this point is pure error. Assuming it grew linearly since the end of the previous stationary phase, the position error is half the velocity error times that interval.
+ *
+ * @param timestamp The timestamp of the current sample in us.
+ */
+void BNO055DeadReckoning::zeroVelocityUpdate(uint32_t timestamp) {
+    float interval = (timestamp - movingSince) * 1e-6f;
+    float errorSq = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        position[i] -= 0.5f * velocity[i] * interval;
+        errorSq += velocity[i] * velocity[i];
+        velocity[i] = 0;
+    }
+    stats.stances++;
+    stats.lastVelocityError = sqrtf(errorSq);
+    if(stats.lastVelocityError > stats.maxVelocityError) {
+        stats.maxVelocityError = stats.lastVelocityError;
+    }
+}
+
+/**
+ * @brief Gets the position.
+ *
+ * @param position Array of 3 floats to store the position in m (x, y, z in the world frame).
+ */
+void BNO055DeadReckoning::getPosition(float* position) {
+    memcpy(position, this->position, sizeof(this->position));
+}
+
+/**
+ * @brief Gets the velocity.
+ *
+ * @param velocity Array of 3 floats to store the velocity in m/s (x, y, z in the world frame).
+ */
+void BNO055DeadReckoning::getVelocity(float* velocity) {
+    memcpy(velocity, this->velocity, sizeof(this->velocity));
+}
+
+/**
+ * @brief Checks whether the sensor is in a stationary phase.
+ *
+ * @return True if stationary.
+ */
+bool BNO055DeadReckoning::isStationary() {
+    return stationary;
+}
+
+/**
+ * @brief Gets the dead-reckoning statistics.
+ *
+ * This function copies the number of samples, stationary phases, stationary samples and gaps and the last and maximum velocity error removed by a zero-velocity update in m/s into the provided struct.
+ *
+ * @param stats Pointer to a deadReckoningStats struct to store the statistics.
+ */
+void BNO055DeadReckoning::getStats(deadReckoningStats *stats) {
+    memcpy(stats, &this->stats, sizeof(deadReckoningStats));
+}
+
+/**
+ * @brief Resets the dead-reckoning statistics.
+ */
+void BNO055DeadReckoning::resetStats() {
+    memset(&stats, 0, sizeof(deadReckoningStats));
+}
@@ -0,0 +1,61 @@
+#ifndef BNO055DeadReckoning_h
+#define BNO055DeadReckoning_h
+
+#include <stdint.h>
+#include "BNO055Decode.h"
+
+typedef struct {
+  uint32_t samples;
+  uint32_t stances;
+  uint32_t stanceSamples;
+  uint32_t gaps;
+  float lastVelocityError;
+  float maxVelocityError;
+} deadReckoningStats;
+
+// Integrates the linear acceleration of the fusion output to velocity and position in the
+// world frame. Each sample is rotated with the quaternion and integrated with the
+// trapezoidal rule. Stationary phases (foot stance, vehicle stops) are detected from the
+// gyro rate and an exponentially weighted variance of the acceleration vector; on entry the
+// accumulated velocity error is removed (zero-velocity update) and, assuming it grew
+// linearly since the last stance, the position is corrected by the error integrated over
+// that interval. While stationary the world-frame acceleration bias is estimated and
+// subtracted afterwards. Constant time and memory per sample, units follow the default
+// UNIT_SEL (m/s², dps, timestamps in us). No Arduino dependency.
+class BNO055DeadReckoning {
+  public:
+      BNO055DeadReckoning();
+      void reset();
+      void setStance(float gyroRate, float accVariance, uint32_t duration);
+      void setMaxGap(uint32_t gap);
+      void setPosition(const float* position);
+      bool update(const imuSnapshot& snapshot);
+      void getPosition(float* position);
+      void getVelocity(float* velocity);
+      bool isStationary();
+      void getStats(deadReckoningStats *stats);
+      void resetStats();
+  private:
+      bool detectStance(const imuSnapshot& snapshot, uint32_t dt);
+      void zeroVelocityUpdate(uint32_t timestamp);
+
+      float gyroRateSq;
+      float stanceVariance;
+      uint32_t stanceDuration;
+      uint32_t maxGap;
+
+      bool started;
+      bool stationary;
+      uint32_t lastTime;
+      uint32_t quietTime;
+      uint32_t movingSince;
+      float mean[3];
+      float variance;
+      float lastAcc[3];
+      float bias[3];
+      float velocity[3];
+      float position[3];
+
+      deadReckoningStats stats;
+};
+#endif
@@ -0,0 +1,197 @@
+#include "BNO055Decode.h"
+
+#if !defined(BNO055_DECODE_SCALAR) && defined(__AVX2__)
+#include <immintrin.h>
+#define DECODE_KERNEL_AVX2
+#elif !defined(BNO055_DECODE_SCALAR) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define DECODE_KERNEL_SSE2
+#elif !defined(BNO055_DECODE_SCALAR) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DECODE_KERNEL_NEON
+#endif
+
+#if defined(__AVR__)
+#define DECODE_TILE 8
+#else
+#define DECODE_TILE 64
+#endif
+
+namespace BNO055Decode {
+
+/**
+ * @brief Gets the scale factor of a snapshot channel.
+ *
+ * This function returns the factor that converts the raw register value of a channel into its physical unit, taking the UNIT_SEL register into account (m/s² or mg, dps or rps, degrees or radians, Celsius or Fahrenheit).
+ *
+ * @param channel The snapshot channel (CHANNEL_ACC_X..CHANNEL_TEMP).
+ * @param unitSel The value of the UNIT_SEL register.
+ * @return The scale factor for the channel.
+ */
+float channelScale(uint8_t channel, uint8_t unitSel) {
+    if(channel <= CHANNEL_ACC_Z || (channel >= CHANNEL_LIA_X && channel <= CHANNEL_GRV_Z)) {
+        return (unitSel & 0x01) ? 1.0f : 1.0f / 100.0f;
+    }
+    if(channel <= CHANNEL_MAG_Z) {
+        return 1.0f / 16.0f;
+    }
+    if(channel <= CHANNEL_GYR_Z) {
+        return (unitSel & 0x02) ? 1.0f / 900.0f : 1.0f / 16.0f;
+    }
+    if(channel <= CHANNEL_EUL_PITCH) {
+        return (unitSel & 0x04) ? 1.0f / 900.0f : 1.0f / 16.0f;
+    }
+    if(channel <= CHANNEL_QUA_Z) {
+        return 1.0f / 16384.0f;
+    }
+    return (unitSel & 0x10) ? 2.0f : 1.0f;
+}
+
+/**
+ * @brief Decodes one raw snapshot into scaled values.
+ *
+ * This function assembles every 16-bit value from its LSB and MSB byte, so the result does not depend on the byte order of the host. The timestamp of the output is left untouched.
+ *
+ * @param raw Pointer to RAW_SNAPSHOT_SIZE bytes read from ACC_X_LSB..TEMP.
+ * @param unitSel The value of the UNIT_SEL register.
+ * @param out Reference to an imuSnapshot struct to store the decoded values.
+ */
+void decodeSnapshot(const uint8_t* raw, uint8_t unitSel, imuSnapshot& out) {
+    float* values[RAW_SNAPSHOT_WORDS] = {
+        &out.acc[0], &out.acc[1], &out.acc[2],
+        &out.mag[0], &out.mag[1], &out.mag[2],
+        &out.gyr[0], &out.gyr[1], &out.gyr[2],
+        &out.eul[0], &out.eul[1], &out.eul[2],
+        &out.qua[0], &out.qua[1], &out.qua[2], &out.qua[3],
+        &out.lia[0], &out.lia[1], &out.lia[2],
+        &out.grv[0], &out.grv[1], &out.grv[2]
+    };
+    for (uint8_t i = 0; i < RAW_SNAPSHOT_WORDS; i++) {
+        *values[i] = readInt16LE(&raw[2 * i]) * channelScale(i, unitSel);
+    }
+    out.temp = (int8_t)raw[2 * RAW_SNAPSHOT_WORDS] * channelScale(CHANNEL_TEMP, unitSel);
+}
+
+/**
+ * @brief Decodes the health block CALIB_STAT..SYS_ERR.
+ *
+ * This function splits the calibration status into its four 2-bit fields, checks the four self-test bits (accelerometer, magnetometer, gyroscope, MCU) and converts the system status and error codes into their enums.
+ *
+ * @param raw Pointer to RAW_HEALTH_SIZE bytes read from CALIB_STAT..SYS_ERR.
+ * @param out Reference to a sensorHealth struct to store the decoded values.
+ */
+void decodeHealth(const uint8_t* raw, sensorHealth& out) {
+    out.calSys = (raw[0] >> 6) & 0x03;
+    out.calGyro = (raw[0] >> 4) & 0x03;
+    out.calAccel = (raw[0] >> 2) & 0x03;
+    out.calMag = raw[0] & 0x03;
+    out.selfTest = raw[1] & 0x0F;
+    out.selfTestPassed = (out.selfTest == 0x0F);
+    out.intStatus = raw[2];
+    out.clockConfiguring = (raw[3] & 0x01) != 0;
+    out.status = (SystemStatus)raw[4];
+    out.error = (SystemError)raw[5];
+}
+
+/**
+ * @brief Converts an array of 16-bit integers into scaled floats.
+ *
+ * This is the inner kernel of decodeBatch. It processes 16 (AVX2) or 8 (SSE2, NEON) values per iteration and finishes the remainder with scalar code.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output array.
+ * @param count The number of values to convert.
+ * @param scale The factor applied to every value.
+ */
+void convertInt16(const int16_t* in, float* out, size_t count, float scale) {
+    size_t i = 0;
+
+    #if defined(DECODE_KERNEL_AVX2)
+    const __m256 factor = _mm256_set1_ps(scale);
+    for (; i + 16 <= count; i += 16) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(in + i + 8));
+        __m256 flo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(lo));
+        __m256 fhi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(hi));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(flo, factor));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(fhi, factor));
+    }
+    #elif defined(DECODE_KERNEL_SSE2)
+    const __m128 factor = _mm_set1_ps(scale);
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), factor));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), factor));
+    }
+    #elif defined(DECODE_KERNEL_NEON)
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vld1q_s16(in + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+        vst1q_f32(out + i, vmulq_n_f32(lo, scale));
+        vst1q_f32(out + i + 4, vmulq_n_f32(hi, scale));
+    }
+    #endif
+
+    for (; i < count; i++) {
+        out[i] = in[i] * scale;
+    }
+}
+
+/**
+ * @brief Decodes an array of raw snapshots into per-channel float columns.
+ *
+ * This function works in tiles of DECODE_TILE snapshots: the raw bytes of a tile are first transposed into one 16-bit row per channel, then every row is scaled with the vector kernel into its output column. Row i of the input starts at raw + i * stride, so records with extra header bytes can be decoded in place.
+ *
+ * @param raw Pointer to the first raw snapshot.
+ * @param stride Distance in bytes between consecutive raw snapshots, at least RAW_SNAPSHOT_SIZE.
+ * @param count The number of snapshots to decode.
+ * @param unitSel The value of the UNIT_SEL register the data was recorded with.
+ * @param columns CHANNEL_COUNT pointers to output arrays of at least count floats; null columns are skipped.
+ */
+void decodeBatch(const uint8_t* raw, size_t stride, size_t count, uint8_t unitSel, float* const* columns) {
+    int16_t tile[CHANNEL_COUNT][DECODE_TILE];
+    float scales[CHANNEL_COUNT];
+    for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+        scales[c] = channelScale(c, unitSel);
+    }
+
+    for (size_t base = 0; base < count; base += DECODE_TILE) {
+        size_t n = (count - base < DECODE_TILE) ? count - base : DECODE_TILE;
+
+        for (size_t i = 0; i < n; i++) {
+            const uint8_t* record = raw + (base + i) * stride;
+            for (uint8_t c = 0; c < RAW_SNAPSHOT_WORDS; c++) {
+                tile[c][i] = readInt16LE(&record[2 * c]);
+            }
+            tile[CHANNEL_TEMP][i] = (int8_t)record[2 * RAW_SNAPSHOT_WORDS];
+        }
+
+        for (uint8_t c = 0; c < CHANNEL_COUNT; c++) {
+            if(columns[c] != 0) {
+                convertInt16(tile[c], columns[c] + base, n, scales[c]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Gets the name of the batch kernel selected at compile time.
+ *
+ * @return "avx2", "sse2", "neon" or "scalar".
+ */
+const char* kernelName() {
+    #if defined(DECODE_KERNEL_AVX2)
+    return "avx2";
+    #elif defined(DECODE_KERNEL_SSE2)
+    return "sse2";
+    #elif defined(DECODE_KERNEL_NEON)
+    return "neon";
+    #else
+    return "scalar";
+    #endif
+}
+
+}
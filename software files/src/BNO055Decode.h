@@ -0,0 +1,127 @@
+#ifndef BNO055Decode_h
+#define BNO055Decode_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Raw snapshot: the output registers ACC_X_LSB..TEMP (page 0, 0x08-0x34) as read in one burst.
+#define RAW_SNAPSHOT_START 0x08
+#define RAW_SNAPSHOT_SIZE 45
+#define RAW_SNAPSHOT_WORDS 22
+
+// Health block: CALIB_STAT..SYS_ERR (page 0, 0x35-0x3A), directly behind the raw snapshot,
+// so a snapshot read of RAW_SNAPSHOT_HEALTH_SIZE bytes carries it in the same burst.
+#define RAW_HEALTH_START 0x35
+#define RAW_HEALTH_SIZE 6
+#define RAW_SNAPSHOT_HEALTH_SIZE (RAW_SNAPSHOT_SIZE + RAW_HEALTH_SIZE)
+
+enum SnapshotChannel {
+  CHANNEL_ACC_X = 0,
+  CHANNEL_ACC_Y,
+  CHANNEL_ACC_Z,
+  CHANNEL_MAG_X,
+  CHANNEL_MAG_Y,
+  CHANNEL_MAG_Z,
+  CHANNEL_GYR_X,
+  CHANNEL_GYR_Y,
+  CHANNEL_GYR_Z,
+  CHANNEL_EUL_HEADING,
+  CHANNEL_EUL_ROLL,
+  CHANNEL_EUL_PITCH,
+  CHANNEL_QUA_W,
+  CHANNEL_QUA_X,
+  CHANNEL_QUA_Y,
+  CHANNEL_QUA_Z,
+  CHANNEL_LIA_X,
+  CHANNEL_LIA_Y,
+  CHANNEL_LIA_Z,
+  CHANNEL_GRV_X,
+  CHANNEL_GRV_Y,
+  CHANNEL_GRV_Z,
+  CHANNEL_TEMP,
+  CHANNEL_COUNT
+};
+
+enum SystemStatus {
+  SYSTEM_STATUS_IDLE = 0x00,
+  SYSTEM_STATUS_ERROR = 0x01,
+  SYSTEM_STATUS_INIT_PERIPHERALS = 0x02,
+  SYSTEM_STATUS_INITIALIZING = 0x03,
+  SYSTEM_STATUS_SELFTEST = 0x04,
+  SYSTEM_STATUS_FUSION_RUNNING = 0x05,
+  SYSTEM_STATUS_RUNNING_NO_FUSION = 0x06
+};
+
+enum SystemError {
+  SYSTEM_ERROR_NONE = 0x00,
+  SYSTEM_ERROR_PERIPHERAL_INIT = 0x01,
+  SYSTEM_ERROR_SYSTEM_INIT = 0x02,
+  SYSTEM_ERROR_SELFTEST_FAILED = 0x03,
+  SYSTEM_ERROR_REGMAP_VALUE = 0x04,
+  SYSTEM_ERROR_REGMAP_ADDRESS = 0x05,
+  SYSTEM_ERROR_REGMAP_WRITE = 0x06,
+  SYSTEM_ERROR_LOWPOWER_UNAVAILABLE = 0x07,
+  SYSTEM_ERROR_ACC_POWERMODE_UNAVAILABLE = 0x08,
+  SYSTEM_ERROR_FUSION_CONFIG = 0x09,
+  SYSTEM_ERROR_SENSOR_CONFIG = 0x0A
+};
+
+typedef struct {
+  uint8_t calSys;
+  uint8_t calGyro;
+  uint8_t calAccel;
+  uint8_t calMag;
+  uint8_t selfTest;
+  bool selfTestPassed;
+  uint8_t intStatus;
+  bool clockConfiguring;
+  SystemStatus status;
+  SystemError error;
+} sensorHealth;
+
+typedef struct {
+  uint32_t timestamp;
+  float acc[3];
+  float mag[3];
+  float gyr[3];
+  float eul[3];
+  float qua[4];
+  float lia[3];
+  float grv[3];
+  float temp;
+} imuSnapshot;
+
+// Endian-independent conversion of raw register bytes into scaled values. Works on a
+// single snapshot or on arrays of snapshots (SoA output, one float column per channel).
+// The batch kernel is selected at compile time: AVX2, SSE2, NEON or scalar; define
+// BNO055_DECODE_SCALAR to force the scalar kernel.
+namespace BNO055Decode {
+
+inline int16_t readInt16LE(const uint8_t* bytes) {
+  return (int16_t)((uint16_t)bytes[0] | ((uint16_t)bytes[1] << 8));
+}
+
+inline void writeInt16LE(uint8_t* bytes, int16_t value) {
+  bytes[0] = (uint8_t)((uint16_t)value & 0x00FF);
+  bytes[1] = (uint8_t)((uint16_t)value >> 8);
+}
+
+inline float channelValue(const imuSnapshot& s, uint8_t channel) {
+  return channel < CHANNEL_MAG_X ? s.acc[channel] :
+         channel < CHANNEL_GYR_X ? s.mag[channel - CHANNEL_MAG_X] :
+         channel < CHANNEL_EUL_HEADING ? s.gyr[channel - CHANNEL_GYR_X] :
+         channel < CHANNEL_QUA_W ? s.eul[channel - CHANNEL_EUL_HEADING] :
+         channel < CHANNEL_LIA_X ? s.qua[channel - CHANNEL_QUA_W] :
+         channel < CHANNEL_GRV_X ? s.lia[channel - CHANNEL_LIA_X] :
+         channel < CHANNEL_TEMP ? s.grv[channel - CHANNEL_GRV_X] : s.temp;
+}
+
+float channelScale(uint8_t channel, uint8_t unitSel);
+void decodeSnapshot(const uint8_t* raw, uint8_t unitSel, imuSnapshot& out);
+void decodeHealth(const uint8_t* raw, sensorHealth& out);
+void convertInt16(const int16_t* in, float* out, size_t count, float scale);
+void decodeBatch(const uint8_t* raw, size_t stride, size_t count, uint8_t unitSel, float* const* columns);
+const char* kernelName();
+
+}
+#endif
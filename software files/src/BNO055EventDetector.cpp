@@ -0,0 +1,216 @@
+#include "BNO055EventDetector.h"
+#include <math.h>
+
+#define EVENT_FACE_THRESHOLD 0.7071f   // cos(45°): gravity direction that counts as face up/down
+#define EVENT_STILL_ALPHA 0.1f         // weight of a new sample in the stillness variance
+#define EVENT_MOVING_FACTOR 4.0f       // variance above stillVariance * factor ends a still period
+
+/**
+ * @brief Constructor for BNO055EventDetector class.
+ *
+ * Loads the default thresholds: tilt 30° with 5° hysteresis, taps above 1500 m/s³ at most every 150 ms, stillness below 0.01 (m/s²)² for 1 s.
+ */
+BNO055EventDetector::BNO055EventDetector() {
+    setTilt(30.0f, 5.0f);
+    setTap(1500.0f, 150000);
+    setStill(0.01f, 1000000);
+    reset();
+}
+
+/**
+ * @brief Discards the detector state and all queued events.
+ */
+void BNO055EventDetector::reset() {
+    started = false;
+    tilted = false;
+    face = 0;
+    still = false;
+    lastTime = 0;
+    lastTap = 0;
+    quietSince = 0;
+    variance = 0;
+    head = 0;
+    count = 0;
+    dropped = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        lastAcc[i] = 0;
+        mean[i] = 0;
+    }
+}
+
+/**
+ * @brief Sets the tilt threshold.
+ *
+ * The tilt is the angle between the gravity vector and the sensor z-axis. EVENT_TILT_ENTER is emitted when it exceeds angle, EVENT_TILT_EXIT when it falls below angle - hysteresis.
+ *
+ * @param angle The tilt angle in degrees.
+ * @param hysteresis The hysteresis in degrees.
+ */
+void BNO055EventDetector::setTilt(float angle, float hysteresis) {
+    const float toRad = 3.14159265f / 180.0f;
+    tiltEnter = cosf(angle * toRad);
+    tiltExit = cosf((angle - hysteresis) * toRad);
+}
+
+/**
+ * @brief Sets the tap threshold.
+ *
+ * @param jerk The minimum rate of change of the acceleration in m/s³.
+ * @param refractory The minimum time between two taps in us.
+ */
+void BNO055EventDetector::setTap(float jerk, uint32_t refractory) {
+    tapJerkSq = jerk * jerk;
+    tapRefractory = refractory;
+}
+
+/**
+ * @brief Sets the stillness threshold.
+ *
+ * @param variance The maximum variance of the acceleration vector (sum over the axes) in (m/s²)².
+ * @param duration The time the variance has to stay below the threshold in us.
+ */
+void BNO055EventDetector::setStill(float variance, uint32_t duration) {
+    stillVariance = variance;
+    stillDuration = duration;
+}
+
+/**
+ * @brief Processes a snapshot.
+ *
+ * The gravity vector is taken from the fusion output; in non-fusion modes, where it is zero, the acceleration is used instead.
+ *
+ * @param snapshot The decoded snapshot, its timestamp in us.
+ * @return The number of events emitted for this snapshot.
+ */
+uint8_t BNO055EventDetector::update(const imuSnapshot& snapshot) {
+    uint8_t before = count;
+    uint32_t dropBefore = dropped;
+    uint32_t now = snapshot.timestamp;
+
+    const float* g = snapshot.grv;
+    float gSq = g[0] * g[0] + g[1] * g[1] + g[2] * g[2];
+    if(gSq == 0) {
+        g = snapshot.acc;
+        gSq = g[0] * g[0] + g[1] * g[1] + g[2] * g[2];
+    }
+    if(gSq > 0) {
+        float up = g[2] / sqrtf(gSq);
+        if(!tilted && up < tiltEnter) {
+            tilted = true;
+            emit(now, EVENT_TILT_ENTER, acosf(up) * (180.0f / 3.14159265f));
+        }
+        else if(tilted && up > tiltExit) {
+            tilted = false;
+            emit(now, EVENT_TILT_EXIT, acosf(up) * (180.0f / 3.14159265f));
+        }
+        if(face != 1 && up > EVENT_FACE_THRESHOLD) {
+            face = 1;
+            emit(now, EVENT_FACE_UP, up);
+        }
+        else if(face != -1 && up < -EVENT_FACE_THRESHOLD) {
+            face = -1;
+            emit(now, EVENT_FACE_DOWN, up);
+        }
+    }
+
+    const float* a = snapshot.acc;
+    if(!started) {
+        started = true;
+        for (uint8_t i = 0; i < 3; i++) {
+            mean[i] = a[i];
+        }
+        quietSince = now;
+    }
+    else {
+        uint32_t dt = now - lastTime;
+        if(dt > 0) {
+            float dx = a[0] - lastAcc[0];
+            float dy = a[1] - lastAcc[1];
+            float dz = a[2] - lastAcc[2];
+            float scale = 1e6f / (float)dt;
+            float jerkSq = (dx * dx + dy * dy + dz * dz) * scale * scale;
+            if(jerkSq > tapJerkSq && now - lastTap >= tapRefractory) {
+                lastTap = now;
+                emit(now, EVENT_TAP, sqrtf(jerkSq));
+            }
+        }
+
+        float spread = 0;
+        for (uint8_t i = 0; i < 3; i++) {
+            float d = a[i] - mean[i];
+            mean[i] += EVENT_STILL_ALPHA * d;
+            spread += d * d;
+        }
+        variance = (1.0f - EVENT_STILL_ALPHA) * (variance + EVENT_STILL_ALPHA * spread);
+        if(variance >= stillVariance) {
+            quietSince = now;
+        }
+        if(!still && now - quietSince >= stillDuration) {
+            still = true;
+            emit(now, EVENT_STILL, variance);
+        }
+        else if(still && variance > stillVariance * EVENT_MOVING_FACTOR) {
+            still = false;
+            emit(now, EVENT_MOVING, variance);
+        }
+    }
+
+    for (uint8_t i = 0; i < 3; i++) {
+        lastAcc[i] = a[i];
+    }
+    lastTime = now;
+    return (uint8_t)((count - before) + (dropped - dropBefore));
+}
+
+/**
+ * @brief Takes the oldest event from the queue.
+ *
+ * @param event Reference to a motionEvent struct to store the event.
+ * @return True if an event was available, false otherwise.
+ */
+bool BNO055EventDetector::pop(motionEvent& event) {
+    if(count == 0) {
+        return false;
+    }
+    event = queue[(uint8_t)(head + EVENT_QUEUE_SIZE - count) % EVENT_QUEUE_SIZE];
+    count--;
+    return true;
+}
+
+/**
+ * @brief Gets the number of queued events.
+ *
+ * @return The number of events.
+ */
+uint8_t BNO055EventDetector::available() {
+    return count;
+}
+
+/**
+ * @brief Gets the number of events lost because the queue was full.
+ *
+ * @return The number of dropped events.
+ */
+uint32_t BNO055EventDetector::getDropped() {
+    return dropped;
+}
+
+/**
+ * @brief Adds an event to the queue, dropping it if the queue is full.
+ *
+ * @param timestamp The time of the event in us.
+ * @param type The event type.
+ * @param value The value that triggered the event (angle, cosine, jerk or variance).
+ */
+void BNO055EventDetector::emit(uint32_t timestamp, MotionEventType type, float value) {
+    if(count == EVENT_QUEUE_SIZE) {
+        dropped++;
+        return;
+    }
+    motionEvent& event = queue[head];
+    event.timestamp = timestamp;
+    event.type = type;
+    event.value = value;
+    head = (head + 1) % EVENT_QUEUE_SIZE;
+    count++;
+}
@@ -0,0 +1,68 @@
+#ifndef BNO055EventDetector_h
+#define BNO055EventDetector_h
+
+#include <stdint.h>
+#include "BNO055Decode.h"
+
+#define EVENT_QUEUE_SIZE 8
+
+enum MotionEventType {
+  EVENT_TILT_ENTER = 0x00,
+  EVENT_TILT_EXIT = 0x01,
+  EVENT_FACE_UP = 0x02,
+  EVENT_FACE_DOWN = 0x03,
+  EVENT_TAP = 0x04,
+  EVENT_STILL = 0x05,
+  EVENT_MOVING = 0x06
+};
+
+typedef struct {
+  uint32_t timestamp;
+  MotionEventType type;
+  float value;
+} motionEvent;
+
+// Detects tilt, flips, taps and stationary periods on a stream of decoded snapshots.
+// Every sample costs O(1) time and the state is a fixed set of scalars plus a small
+// event queue: tilt and flip use hysteresis thresholds on the direction of the gravity
+// vector, taps the jerk of the acceleration with a refractory time, stillness an
+// exponentially weighted variance of the acceleration vector. Units follow the
+// default UNIT_SEL (m/s², timestamps in us). No Arduino dependency.
+class BNO055EventDetector {
+  public:
+      BNO055EventDetector();
+      void reset();
+      void setTilt(float angle, float hysteresis);
+      void setTap(float jerk, uint32_t refractory);
+      void setStill(float variance, uint32_t duration);
+      uint8_t update(const imuSnapshot& snapshot);
+      bool pop(motionEvent& event);
+      uint8_t available();
+      uint32_t getDropped();
+  private:
+      void emit(uint32_t timestamp, MotionEventType type, float value);
+
+      float tiltEnter;
+      float tiltExit;
+      float tapJerkSq;
+      uint32_t tapRefractory;
+      float stillVariance;
+      uint32_t stillDuration;
+
+      bool started;
+      bool tilted;
+      int8_t face;
+      bool still;
+      float lastAcc[3];
+      uint32_t lastTime;
+      uint32_t lastTap;
+      uint32_t quietSince;
+      float mean[3];
+      float variance;
+
+      motionEvent queue[EVENT_QUEUE_SIZE];
+      uint8_t head;
+      uint8_t count;
+      uint32_t dropped;
+};
+#endif
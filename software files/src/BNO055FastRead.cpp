@@ -0,0 +1,259 @@
+#include "BNO055FastRead.h"
+
+#if BNO055_ENABLE_DIRECT_TWI && defined(__AVR__) && defined(BNO055_TRANSPORT_I2C)
+#define FAST_READ_DIRECT_TWI 1
+#else
+#define FAST_READ_DIRECT_TWI 0
+#endif
+
+#if FAST_READ_DIRECT_TWI
+#include <util/twi.h>
+
+#define TWI_TIMEOUT 2000 // polls of TWINT before a transfer is abandoned
+
+static bool twiWait() {
+    uint16_t polls = TWI_TIMEOUT;
+    while (!(TWCR & _BV(TWINT))) {
+        if(--polls == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool twiCommand(uint8_t control, uint8_t status) {
+    TWCR = control;
+    return twiWait() && TW_STATUS == status;
+}
+
+// Leaves the bus and the TWI unit the way the Wire library expects them.
+static void twiRelease() {
+    TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWSTO);
+    uint16_t polls = TWI_TIMEOUT;
+    while ((TWCR & _BV(TWSTO)) && --polls) {
+    }
+    TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWEA);
+}
+#endif
+
+/**
+ * @brief Constructor for BNO055FastRead class.
+ *
+ * @param sensor Reference to the BNO055 sensor to read.
+ * @param reg The LSB register of the first value, e.g. QUA_W_LSB.
+ * @param count The number of 16-bit values to read, at most 11.
+ */
+BNO055FastRead::BNO055FastRead(BNO055& sensor, uint8_t reg, uint8_t count) : sensor(sensor) {
+    this->reg = reg;
+    length = 2 * (count > 11 ? 11 : count);
+    address = 0;
+    wire = &sensor.getWire();
+    ready = false;
+    readyAt = 0;
+    binWidth = 16;
+    resetLatency();
+}
+
+/**
+ * @brief Resolves the transaction and puts the sensor into the state the hot path assumes.
+ *
+ * This function waits for a pending operation mode switch and selects page 0. Call it once before the control loop starts and again after anything that changes the page.
+ */
+void BNO055FastRead::prepare() {
+    address = sensor.getAddress();
+    sensor.waitModeReady();
+    sensor.setPage(0x00);
+}
+
+/**
+ * @brief Transfers the register block into the internal buffer.
+ *
+ * @return True if all bytes were received.
+ */
+bool BNO055FastRead::transfer() {
+    BNO055_TRACE_SCOPE(TRACE_FAST_READ);
+#if FAST_READ_DIRECT_TWI
+    bool success = twiCommand(_BV(TWINT) | _BV(TWSTA) | _BV(TWEN), TW_START);
+    if(success) {
+        TWDR = address << 1;
+        success = twiCommand(_BV(TWINT) | _BV(TWEN), TW_MT_SLA_ACK);
+    }
+    if(success) {
+        TWDR = reg;
+        success = twiCommand(_BV(TWINT) | _BV(TWEN), TW_MT_DATA_ACK);
+    }
+    if(success) {
+        success = twiCommand(_BV(TWINT) | _BV(TWSTA) | _BV(TWEN), TW_REP_START);
+    }
+    if(success) {
+        TWDR = (address << 1) | 0x01;
+        success = twiCommand(_BV(TWINT) | _BV(TWEN), TW_MR_SLA_ACK);
+    }
+    for (uint8_t i = 0; success && i < length; i++) {
+        bool last = i == length - 1;
+        success = twiCommand(_BV(TWINT) | _BV(TWEN) | (last ? 0 : _BV(TWEA)), last ? TW_MR_DATA_NACK : TW_MR_DATA_ACK);
+        buffer[i] = TWDR;
+    }
+    twiRelease();
+    return success;
+#elif defined(BNO055_TRANSPORT_I2C)
+    wire->beginTransmission(address);
+    wire->write(reg);
+    wire->endTransmission(false);
+    uint8_t received = wire->requestFrom(address, length);
+    for (uint8_t i = 0; i < length; i++) {
+        buffer[i] = wire->read();
+    }
+    return received == length;
+#else
+    return sensor.readBytes(reg, buffer, length);
+#endif
+}
+
+/**
+ * @brief Reads the register block.
+ *
+ * @param values Pointer to an int16_t array of count elements to store the raw values.
+ * @return True if all bytes were received.
+ */
+bool BNO055FastRead::read(int16_t* values) {
+    bool success = transfer();
+    for (uint8_t i = 0; i < length; i += 2) {
+        values[i >> 1] = BNO055Decode::readInt16LE(&buffer[i]);
+    }
+    return success;
+}
+
+/**
+ * @brief Records the data-ready time for the next readMeasured().
+ *
+ * This function is safe to call from an interrupt handler.
+ */
+void BNO055FastRead::markReady() {
+    readyAt = micros();
+    ready = true;
+}
+
+/**
+ * @brief Reads the register block and records its timing.
+ *
+ * The end-to-end latency is measured from the last markReady() call, or from the transfer start if there was none since the previous read.
+ *
+ * @param values Pointer to an int16_t array of count elements to store the raw values.
+ * @return True if all bytes were received.
+ */
+bool BNO055FastRead::readMeasured(int16_t* values) {
+    uint32_t start = micros();
+    bool success = read(values);
+    uint32_t end = micros();
+
+    noInterrupts();
+    uint32_t readyTime = ready ? readyAt : start;
+    ready = false;
+    interrupts();
+
+    uint32_t transferTime = end - start;
+    uint32_t latency = end - readyTime;
+    record(transferHistogram, transferTime);
+    record(latencyHistogram, latency);
+    if(transferTime > transferMax) {
+        transferMax = transferTime;
+    }
+    if(latency > latencyMax) {
+        latencyMax = latency;
+    }
+    samples++;
+    return success;
+}
+
+/**
+ * @brief Adds a value to a histogram.
+ *
+ * @param histogram The histogram to update.
+ * @param value The value in us.
+ */
+void BNO055FastRead::record(uint16_t* histogram, uint32_t value) {
+    uint32_t bin = value / binWidth;
+    if(bin >= LATENCY_HISTOGRAM_BINS) {
+        bin = LATENCY_HISTOGRAM_BINS - 1;
+    }
+    if(histogram[bin] == 0xFFFF) {
+        for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BINS; i++) {
+            histogram[i] >>= 1;
+        }
+    }
+    histogram[bin]++;
+}
+
+/**
+ * @brief Gets a percentile from a histogram.
+ *
+ * @param histogram The histogram to evaluate.
+ * @param total The sum of all bins.
+ * @param percent The percentile, 1..100.
+ * @param maximum The largest recorded value in us.
+ * @return The upper edge of the bin holding the percentile in us, at most maximum; maximum if it falls into the last bin, which holds all larger values.
+ */
+uint32_t BNO055FastRead::percentile(const uint16_t* histogram, uint32_t total, uint8_t percent, uint32_t maximum) {
+    uint32_t target = (total * percent + 99) / 100;
+    uint32_t sum = 0;
+    uint8_t bin = 0;
+    while (bin < LATENCY_HISTOGRAM_BINS - 1) {
+        sum += histogram[bin];
+        if(sum >= target) {
+            break;
+        }
+        bin++;
+    }
+    uint32_t edge = (uint32_t)(bin + 1) * binWidth;
+    if(bin == LATENCY_HISTOGRAM_BINS - 1 || edge > maximum) {
+        return maximum;
+    }
+    return edge;
+}
+
+/**
+ * @brief Sets the histogram bin width.
+ *
+ * The histograms cover LATENCY_HISTOGRAM_BINS * width us; larger values fall into the last bin. The histograms are cleared.
+ *
+ * @param width The bin width in us, e.g. 16 for 400 kHz I2C or 64 for 100 kHz.
+ */
+void BNO055FastRead::setBinWidth(uint16_t width) {
+    binWidth = width > 0 ? width : 1;
+    resetLatency();
+}
+
+/**
+ * @brief Gets the latency statistics.
+ *
+ * This function copies the number of measured reads and the p50, p99 and maximum of the transfer time and of the end-to-end latency in us into the provided struct. The percentiles are rounded up to the bin width and never exceed the maximum.
+ *
+ * @param stats Pointer to a latencyStats struct to store the statistics.
+ */
+void BNO055FastRead::getLatency(latencyStats *stats) {
+    uint32_t transferTotal = 0;
+    uint32_t latencyTotal = 0;
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BINS; i++) {
+        transferTotal += transferHistogram[i];
+        latencyTotal += latencyHistogram[i];
+    }
+    stats->samples = samples;
+    stats->transferMax = transferMax;
+    stats->latencyMax = latencyMax;
+    stats->transferP50 = percentile(transferHistogram, transferTotal, 50, transferMax);
+    stats->transferP99 = percentile(transferHistogram, transferTotal, 99, transferMax);
+    stats->latencyP50 = percentile(latencyHistogram, latencyTotal, 50, latencyMax);
+    stats->latencyP99 = percentile(latencyHistogram, latencyTotal, 99, latencyMax);
+}
+
+/**
+ * @brief Clears the latency histograms and statistics.
+ */
+void BNO055FastRead::resetLatency() {
+    samples = 0;
+    transferMax = 0;
+    latencyMax = 0;
+    memset(transferHistogram, 0, sizeof(transferHistogram));
+    memset(latencyHistogram, 0, sizeof(latencyHistogram));
+}
@@ -0,0 +1,62 @@
+#ifndef BNO055FastRead_h
+#define BNO055FastRead_h
+
+#include <Arduino.h>
+#include "BNO055.h"
+
+#define LATENCY_HISTOGRAM_BINS 48
+
+typedef struct {
+  uint32_t samples;
+  uint32_t transferP50;
+  uint32_t transferP99;
+  uint32_t transferMax;
+  uint32_t latencyP50;
+  uint32_t latencyP99;
+  uint32_t latencyMax;
+} latencyStats;
+
+// Minimal-latency read of a fixed block of output registers for control loops. The
+// register, length and address are resolved once in prepare(), which also selects page 0
+// and waits for a pending mode switch; read() is then a single combined write/read
+// transaction (repeated start, no STOP between address and data) with no page check,
+// no mode check and no decoding beyond the little-endian assembly. Call prepare() again
+// after anything that changes the page, e.g. interrupt configuration. The direct TWI path
+// (BNO055_ENABLE_DIRECT_TWI) drives the hardware TWI unit and so only applies to Wire.
+//
+// readMeasured() additionally timestamps the transfer start and end and, if markReady()
+// was called since the previous read (e.g. from the interrupt handler of a data-ready or
+// sync signal), the data-ready time. Transfer time and end-to-end latency go into
+// histograms of LATENCY_HISTOGRAM_BINS bins, from which the p50/p99 values are taken;
+// counts are halved when one saturates, which keeps the percentiles valid.
+class BNO055FastRead {
+  public:
+      BNO055FastRead(BNO055& sensor, uint8_t reg, uint8_t count);
+      void prepare();
+      bool read(int16_t* values);
+      void markReady();
+      bool readMeasured(int16_t* values);
+      void setBinWidth(uint16_t width);
+      void getLatency(latencyStats *stats);
+      void resetLatency();
+  private:
+      bool transfer();
+      void record(uint16_t* histogram, uint32_t value);
+      uint32_t percentile(const uint16_t* histogram, uint32_t total, uint8_t percent, uint32_t maximum);
+
+      BNO055& sensor;
+      TwoWire* wire;
+      uint8_t reg;
+      uint8_t length;
+      uint8_t address;
+      uint8_t buffer[22];
+      volatile uint32_t readyAt;
+      volatile bool ready;
+      uint16_t binWidth;
+      uint32_t samples;
+      uint16_t transferHistogram[LATENCY_HISTOGRAM_BINS];
+      uint16_t latencyHistogram[LATENCY_HISTOGRAM_BINS];
+      uint32_t transferMax;
+      uint32_t latencyMax;
+};
+#endif
@@ -0,0 +1,252 @@
+#include "BNO055GyroBias.h"
+#include <math.h>
+
+#define GYRO_BIAS_ALPHA 0.1f        // weight of a new sample in the stillness variances
+#define GYRO_BIAS_MAX_WEIGHT 255.0f // saturation of the running mean of a node
+#define GYRO_BIAS_MIN_WEIGHT 16.0f  // samples before a node is used
+#define GYRO_BIAS_LSB_PER_DPS 16.0f
+
+/**
+ * @brief Constructor for BNO055GyroBias class.
+ *
+ * Loads the default stillness thresholds: gyro variance below 0.1 dps², acceleration variance below 0.05 (m/s²)² for 500 ms.
+ */
+BNO055GyroBias::BNO055GyroBias() {
+    setStill(0.1f, 0.05f, 500000);
+    reset();
+}
+
+/**
+ * @brief Discards the learned table and the stillness state.
+ */
+void BNO055GyroBias::reset() {
+    started = false;
+    lastTime = 0;
+    quietTime = 0;
+    gyroVar = 0;
+    accVar = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        gyroMean[i] = 0;
+        accMean[i] = 0;
+    }
+    for (uint8_t n = 0; n < GYRO_BIAS_NODES; n++) {
+        weight[n] = 0;
+        temperature[n] = 0;
+        for (uint8_t i = 0; i < 3; i++) {
+            bias[n][i] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Sets the stillness thresholds.
+ *
+ * @param gyroVariance The maximum variance of the gyro vector (sum over the axes) in dps².
+ * @param accVariance The maximum variance of the acceleration vector (sum over the axes) in (m/s²)².
+ * @param duration The time both variances have to stay below the thresholds before samples are learned, in us.
+ */
+void BNO055GyroBias::setStill(float gyroVariance, float accVariance, uint32_t duration) {
+    this->gyroVariance = gyroVariance;
+    this->accVariance = accVariance;
+    stillDuration = duration;
+}
+
+/**
+ * @brief Processes a snapshot and learns its gyro rate if the sensor is stationary.
+ *
+ * The gyro rate must not be compensated by a bias that changes with the temperature; see BNO055GyroCompensation for the GYR_OFFSET registers.
+ *
+ * @param snapshot The decoded snapshot.
+ * @return True if the sample was learned.
+ */
+bool BNO055GyroBias::update(const imuSnapshot& snapshot) {
+    if(!started) {
+        started = true;
+        lastTime = snapshot.timestamp;
+        for (uint8_t i = 0; i < 3; i++) {
+            gyroMean[i] = snapshot.gyr[i];
+            accMean[i] = snapshot.acc[i];
+        }
+        return false;
+    }
+
+    float gyroDistance = 0;
+    float accDistance = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        float delta = snapshot.gyr[i] - gyroMean[i];
+        gyroMean[i] += GYRO_BIAS_ALPHA * delta;
+        gyroDistance += delta * delta;
+        delta = snapshot.acc[i] - accMean[i];
+        accMean[i] += GYRO_BIAS_ALPHA * delta;
+        accDistance += delta * delta;
+    }
+    gyroVar = (1.0f - GYRO_BIAS_ALPHA) * (gyroVar + GYRO_BIAS_ALPHA * gyroDistance);
+    accVar = (1.0f - GYRO_BIAS_ALPHA) * (accVar + GYRO_BIAS_ALPHA * accDistance);
+
+    uint32_t dt = snapshot.timestamp - lastTime;
+    lastTime = snapshot.timestamp;
+    if(gyroVar >= gyroVariance || accVar >= accVariance) {
+        quietTime = 0;
+        return false;
+    }
+    if(quietTime < stillDuration) {
+        quietTime += dt;
+        return false;
+    }
+    learn(snapshot.temp, snapshot.gyr);
+    return true;
+}
+
+/**
+ * @brief Learns a gyro rate measured while the sensor is stationary.
+ *
+ * Use this function instead of update() when stationary periods are detected elsewhere, e.g. by BNO055DeadReckoning.
+ *
+ * @param temperature The temperature in °C.
+ * @param rate Array of 3 floats holding the gyro rate in dps.
+ */
+void BNO055GyroBias::learn(float temperature, const float* rate) {
+    float position = (temperature - GYRO_BIAS_TEMP_MIN) / (float)GYRO_BIAS_TEMP_STEP;
+    if(position <= 0) {
+        position = 0;
+    }
+    else if(position >= GYRO_BIAS_NODES - 1) {
+        position = GYRO_BIAS_NODES - 1;
+    }
+    uint8_t node = (uint8_t)position;
+    if(node == GYRO_BIAS_NODES - 1) {
+        node--;
+    }
+    float fraction = position - node;
+
+    for (uint8_t k = 0; k < 2; k++) {
+        uint8_t n = node + k;
+        float share = k ? fraction : 1.0f - fraction;
+        if(share <= 0) {
+            continue;
+        }
+        weight[n] += share;
+        if(weight[n] > GYRO_BIAS_MAX_WEIGHT) {
+            weight[n] = GYRO_BIAS_MAX_WEIGHT;
+        }
+        float gain = share / weight[n];
+        this->temperature[n] += gain * (temperature - this->temperature[n]);
+        for (uint8_t i = 0; i < 3; i++) {
+            bias[n][i] += gain * (rate[i] - bias[n][i]);
+        }
+    }
+}
+
+/**
+ * @brief Checks if a node has learned enough samples to be used.
+ *
+ * @param node The node index.
+ * @return True if the node is trained.
+ */
+bool BNO055GyroBias::isTrained(uint8_t node) {
+    return weight[node] >= GYRO_BIAS_MIN_WEIGHT;
+}
+
+/**
+ * @brief Gets the gyro bias at a temperature.
+ *
+ * @param temperature The temperature in °C.
+ * @param bias Array of 3 floats to store the bias in dps.
+ * @return True if the bias is known, false if no node is trained yet.
+ */
+bool BNO055GyroBias::getBias(float temperature, float* bias) {
+    int8_t lower = -1;
+    int8_t upper = -1;
+    for (uint8_t n = 0; n < GYRO_BIAS_NODES; n++) {
+        if(!isTrained(n)) {
+            continue;
+        }
+        if(this->temperature[n] <= temperature) {
+            if(lower < 0 || this->temperature[n] > this->temperature[lower]) {
+                lower = n;
+            }
+        }
+        else if(upper < 0 || this->temperature[n] < this->temperature[upper]) {
+            upper = n;
+        }
+    }
+    if(lower < 0 && upper < 0) {
+        return false;
+    }
+    if(lower < 0 || upper < 0) {
+        uint8_t n = lower < 0 ? upper : lower;
+        for (uint8_t i = 0; i < 3; i++) {
+            bias[i] = this->bias[n][i];
+        }
+        return true;
+    }
+    float fraction = (temperature - this->temperature[lower]) / (this->temperature[upper] - this->temperature[lower]);
+    for (uint8_t i = 0; i < 3; i++) {
+        bias[i] = this->bias[lower][i] + fraction * (this->bias[upper][i] - this->bias[lower][i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Subtracts the bias at the snapshot temperature from its gyro rate.
+ *
+ * @param snapshot The decoded snapshot, corrected in place.
+ * @return True if the snapshot was corrected, false if no node is trained yet.
+ */
+bool BNO055GyroBias::correct(imuSnapshot& snapshot) {
+    float offset[3];
+    if(!getBias(snapshot.temp, offset)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        snapshot.gyr[i] -= offset[i];
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the number of trained nodes.
+ *
+ * @return The number of nodes with enough samples to be used.
+ */
+uint8_t BNO055GyroBias::getTrainedNodes() {
+    uint8_t trained = 0;
+    for (uint8_t n = 0; n < GYRO_BIAS_NODES; n++) {
+        if(isTrained(n)) {
+            trained++;
+        }
+    }
+    return trained;
+}
+
+/**
+ * @brief Gets the table in its persistent form.
+ *
+ * @param table Pointer to a gyroBiasTable struct to store the table.
+ */
+void BNO055GyroBias::getTable(gyroBiasTable *table) {
+    for (uint8_t n = 0; n < GYRO_BIAS_NODES; n++) {
+        table->weight[n] = (uint8_t)weight[n];
+        table->temperature[n] = (int16_t)lroundf(temperature[n] * 16.0f);
+        for (uint8_t i = 0; i < 3; i++) {
+            table->bias[n][i] = (int16_t)lroundf(bias[n][i] * GYRO_BIAS_LSB_PER_DPS);
+        }
+    }
+}
+
+/**
+ * @brief Loads a table stored with getTable().
+ *
+ * Learning continues from the stored weights.
+ *
+ * @param table Pointer to the gyroBiasTable struct to load.
+ */
+void BNO055GyroBias::setTable(const gyroBiasTable *table) {
+    for (uint8_t n = 0; n < GYRO_BIAS_NODES; n++) {
+        weight[n] = table->weight[n];
+        temperature[n] = table->temperature[n] / 16.0f;
+        for (uint8_t i = 0; i < 3; i++) {
+            bias[n][i] = table->bias[n][i] / GYRO_BIAS_LSB_PER_DPS;
+        }
+    }
+}
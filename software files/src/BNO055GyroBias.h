@@ -0,0 +1,59 @@
+#ifndef BNO055GyroBias_h
+#define BNO055GyroBias_h
+
+#include <stdint.h>
+#include "BNO055Decode.h"
+
+#define GYRO_BIAS_NODES 10
+#define GYRO_BIAS_TEMP_MIN -10   // temperature of the first node in °C
+#define GYRO_BIAS_TEMP_STEP 10   // node spacing in °C
+
+// Persistent form of the table, e.g. for EEPROM: bias in 1/16 dps (the GYR_OFFSET LSB),
+// mean temperature in 1/16 °C and the number of samples behind each node, saturated at 255.
+typedef struct {
+  int16_t bias[GYRO_BIAS_NODES][3];
+  int16_t temperature[GYRO_BIAS_NODES];
+  uint8_t weight[GYRO_BIAS_NODES];
+} gyroBiasTable;
+
+// Learns the gyro bias as a function of the die temperature. Samples are only learned
+// while the sensor is stationary, detected from exponentially weighted variances of the
+// gyro and acceleration vectors, and are split between the two of GYRO_BIAS_NODES evenly
+// spaced nodes around their temperature. Each node keeps a running mean of the bias and
+// of the temperature whose weight saturates, so it keeps following slow changes; the bias
+// is interpolated linearly between these mean points, which stays unbiased while the
+// temperature ramps during warm-up. Untrained nodes are bridged by the nearest trained
+// ones and the ends are held flat. Units follow the default UNIT_SEL (dps, m/s², °C,
+// timestamps in us). No Arduino dependency.
+class BNO055GyroBias {
+  public:
+      BNO055GyroBias();
+      void reset();
+      void setStill(float gyroVariance, float accVariance, uint32_t duration);
+      bool update(const imuSnapshot& snapshot);
+      void learn(float temperature, const float* rate);
+      bool getBias(float temperature, float* bias);
+      bool correct(imuSnapshot& snapshot);
+      uint8_t getTrainedNodes();
+      void getTable(gyroBiasTable *table);
+      void setTable(const gyroBiasTable *table);
+  private:
+      bool isTrained(uint8_t node);
+
+      float gyroVariance;
+      float accVariance;
+      uint32_t stillDuration;
+
+      bool started;
+      uint32_t lastTime;
+      uint32_t quietTime;
+      float gyroMean[3];
+      float accMean[3];
+      float gyroVar;
+      float accVar;
+
+      float bias[GYRO_BIAS_NODES][3];
+      float temperature[GYRO_BIAS_NODES];
+      float weight[GYRO_BIAS_NODES];
+};
+#endif
@@ -0,0 +1,110 @@
+#include "BNO055Config.h"
+
+#if BNO055_ENABLE_FLOAT && BNO055_ENABLE_CALIBRATION
+#include "BNO055GyroCompensation.h"
+#include "BNO055WriteBatch.h"
+
+#define GYR_LSB_PER_DPS 16.0f
+
+/**
+ * @brief Constructor for BNO055GyroCompensation class.
+ *
+ * @param sensor Reference to the BNO055 sensor to be compensated.
+ */
+BNO055GyroCompensation::BNO055GyroCompensation(BNO055& sensor) : sensor(sensor) {
+    for (uint8_t i = 0; i < 3; i++) {
+        applied[i] = 0;
+    }
+    temperature = 0;
+}
+
+/**
+ * @brief Reads the current GYR_OFFSET registers.
+ *
+ * This function should be called once after BNO055::begin() and after loading calibration offsets. It switches to CONFIG mode for the read and restores the previous operation mode afterwards.
+ */
+void BNO055GyroCompensation::begin() {
+    OperationMode mode = sensor.getMode();
+    sensor.setOperationMode(OPERATION_MODE_CONFIG);
+    sensor.waitModeReady();
+
+    calibOffsets offsets;
+    sensor.getCalibrationOffsets(&offsets);
+    applied[0] = offsets.gyrX;
+    applied[1] = offsets.gyrY;
+    applied[2] = offsets.gyrZ;
+
+    sensor.setOperationMode(mode);
+}
+
+/**
+ * @brief Processes a snapshot and learns the uncompensated gyro rate if the sensor is stationary.
+ *
+ * @param snapshot The decoded snapshot.
+ * @return True if the sample was learned.
+ */
+bool BNO055GyroCompensation::update(const imuSnapshot& snapshot) {
+    imuSnapshot raw = snapshot;
+    for (uint8_t i = 0; i < 3; i++) {
+        raw.gyr[i] += applied[i] / GYR_LSB_PER_DPS;
+    }
+    temperature = snapshot.temp;
+    return model.update(raw);
+}
+
+/**
+ * @brief Writes the table bias at the last temperature to the GYR_OFFSET registers if it moved far enough.
+ *
+ * The three offsets are written in one burst in CONFIG mode and the previous operation mode is restored afterwards. Call this function periodically, e.g. once per second, while the unit warms up.
+ *
+ * @param threshold The minimum change of any axis in dps.
+ * @return True if the registers were written, false if the change was too small, the table is still empty or the write failed.
+ */
+bool BNO055GyroCompensation::apply(float threshold) {
+    float bias[3];
+    if(!model.getBias(temperature, bias)) {
+        return false;
+    }
+
+    int16_t target[3];
+    bool changed = false;
+    for (uint8_t i = 0; i < 3; i++) {
+        target[i] = (int16_t)lroundf(bias[i] * GYR_LSB_PER_DPS);
+        if(fabsf((float)(target[i] - applied[i])) >= threshold * GYR_LSB_PER_DPS) {
+            changed = true;
+        }
+    }
+    if(!changed) {
+        return false;
+    }
+
+    OperationMode mode = sensor.getMode();
+    sensor.setOperationMode(OPERATION_MODE_CONFIG);
+    sensor.waitModeReady();
+
+    BNO055WriteBatch batch(sensor, 0x00, GYR_OFFSET_X_LSB);
+    batch.stage16(GYR_OFFSET_X_LSB, (uint16_t)target[0]);
+    batch.stage16(GYR_OFFSET_Y_LSB, (uint16_t)target[1]);
+    batch.stage16(GYR_OFFSET_Z_LSB, (uint16_t)target[2]);
+    bool written = batch.flush();
+
+    sensor.setOperationMode(mode);
+    // a failed run stays dirty: only axes whose offset reached the sensor count as applied
+    for (uint8_t i = 0; i < 3; i++) {
+        uint8_t reg = GYR_OFFSET_X_LSB + 2 * i;
+        if(!batch.isDirty(reg) && !batch.isDirty(reg + 1)) {
+            applied[i] = target[i];
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Gets the underlying bias model.
+ *
+ * @return Reference to the BNO055GyroBias object, e.g. to store or load its table.
+ */
+BNO055GyroBias& BNO055GyroCompensation::getModel() {
+    return model;
+}
+#endif
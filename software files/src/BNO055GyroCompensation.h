@@ -0,0 +1,30 @@
+#ifndef BNO055GyroCompensation_h
+#define BNO055GyroCompensation_h
+
+#include <Arduino.h>
+#include "BNO055.h"
+#include "BNO055GyroBias.h"
+
+#if !BNO055_ENABLE_FLOAT || !BNO055_ENABLE_CALIBRATION
+#error "BNO055GyroCompensation requires BNO055_ENABLE_FLOAT and BNO055_ENABLE_CALIBRATION"
+#endif
+
+// Keeps the GYR_OFFSET registers in line with a BNO055GyroBias table. The gyro output is
+// already compensated by the registers, so the applied offsets are added back before
+// learning. The registers are only rewritten when the table bias at the current
+// temperature differs from them by more than a threshold, since every write needs a
+// round trip through CONFIG mode.
+class BNO055GyroCompensation {
+  public:
+      BNO055GyroCompensation(BNO055& sensor);
+      void begin();
+      bool update(const imuSnapshot& snapshot);
+      bool apply(float threshold);
+      BNO055GyroBias& getModel();
+  private:
+      BNO055& sensor;
+      BNO055GyroBias model;
+      int16_t applied[3];
+      float temperature;
+};
+#endif
@@ -0,0 +1,264 @@
+#include "BNO055HighRateCapture.h"
+
+/**
+ * @brief Constructor for BNO055HighRateCapture class.
+ *
+ * @param sensor Reference to an initialized BNO055 sensor.
+ * @param buffer Caller-owned ring buffer for the captured samples; one slot stays free to tell a full buffer from an empty one.
+ * @param capacity The number of samples the buffer can hold.
+ */
+BNO055HighRateCapture::BNO055HighRateCapture(BNO055& sensor, amgSample* buffer, uint16_t capacity) : sensor(sensor) {
+    this->buffer = buffer;
+    this->capacity = capacity;
+    head = 0;
+    tail = 0;
+    channels = CAPTURE_ACC_GYR;
+    period = 0;
+    next = 0;
+    started = 0;
+    lastSample = 0;
+    triggeredAt = 0;
+    pending = false;
+    triggerOverruns = 0;
+    running = false;
+    triggered = false;
+    jitterSq = 0;
+    memset(&stats, 0, sizeof(captureStats));
+}
+
+/**
+ * @brief Configures the sensor for raw capture.
+ *
+ * This function switches to CONFIG mode, sets the accelerometer to 1000 Hz and the gyroscope to 523 Hz bandwidth in normal power mode and starts the non-fusion mode that runs only the captured sensors. In fusion modes the sensor would override these settings.
+ *
+ * @param channels The sensors to capture (ACC, GYR, ACC_GYR).
+ * @param accRange The accelerometer range.
+ * @param gyrRange The gyroscope range.
+ */
+void BNO055HighRateCapture::configure(CaptureChannels channels, AccRange accRange, GyrRange gyrRange) {
+    this->channels = channels;
+    sensor.setOperationMode(OPERATION_MODE_CONFIG);
+    sensor.waitModeReady();
+    sensor.setAccConfig(accRange, ACC_BW_1000, ACC_MODE_NORMAL);
+    sensor.setGyroConfig(gyrRange, GYRO_BW_523, GYRO_MODE_NORMAL);
+    switch(channels) {
+    case CAPTURE_ACC:
+        sensor.setOperationMode(OPERATION_MODE_ACCONLY);
+        break;
+    case CAPTURE_GYR:
+        sensor.setOperationMode(OPERATION_MODE_GYRONLY);
+        break;
+    default:
+        sensor.setOperationMode(OPERATION_MODE_ACCGYRO);
+        break;
+    }
+}
+
+/**
+ * @brief Starts a capture paced by the micros() schedule.
+ *
+ * This function waits for the pending mode switch, clears the buffer and the statistics and schedules the first sample immediately. poll() must be called in a tight loop afterwards.
+ *
+ * @param period The sample period in us, e.g. 2000 for 500 Hz. Use startTriggered() for a capture without a fixed period.
+ * @return True if the capture was started, false if the period is 0.
+ */
+bool BNO055HighRateCapture::start(uint32_t period) {
+    if(period == 0) {
+        return false;
+    }
+    sensor.waitModeReady();
+    this->period = period;
+    head = 0;
+    tail = 0;
+    triggered = false;
+    pending = false;
+    resetStats();
+    next = started;
+    running = true;
+    return true;
+}
+
+/**
+ * @brief Starts a capture paced by trigger().
+ *
+ * The application calls trigger() from the interrupt handler of its own hardware timer, and poll() reads one sample per trigger.
+ */
+void BNO055HighRateCapture::startTriggered() {
+    sensor.waitModeReady();
+    period = 0;
+    head = 0;
+    tail = 0;
+    triggered = true;
+    pending = false;
+    resetStats();
+    running = true;
+}
+
+/**
+ * @brief Stops the capture. Samples already in the buffer can still be taken with pop().
+ */
+void BNO055HighRateCapture::stop() {
+    running = false;
+}
+
+/**
+ * @brief Requests a sample in triggered capture.
+ *
+ * This function only records the time and sets a flag and is safe to call from an interrupt handler. A trigger that arrives before poll() took the previous one is counted as overrun in a counter of its own, which is added to the statistics with interrupts masked.
+ */
+void BNO055HighRateCapture::trigger() {
+    if(pending) {
+        triggerOverruns++;
+    }
+    triggeredAt = micros();
+    pending = true;
+}
+
+/**
+ * @brief Reads a sample if one is due.
+ *
+ * In scheduled capture a slot that is missed by more than a full period is skipped and counted as overrun, so the schedule does not fall behind permanently.
+ *
+ * @return True if a sample was read and stored, false otherwise.
+ */
+bool BNO055HighRateCapture::poll() {
+    if(!running) {
+        return false;
+    }
+    uint32_t now = micros();
+    if(triggered) {
+        if(!pending) {
+            return false;
+        }
+        noInterrupts();
+        uint32_t scheduled = triggeredAt;
+        pending = false;
+        interrupts();
+        return readSample(scheduled, now);
+    }
+
+    if((int32_t)(now - next) < 0) {
+        return false;
+    }
+    uint32_t scheduled = next;
+    next += period;
+    if((int32_t)(now - next) >= 0) {
+        uint32_t missed = (now - scheduled) / period;
+        stats.overruns += missed;
+        next = scheduled + (missed + 1) * period;
+    }
+    return readSample(scheduled, now);
+}
+
+/**
+ * @brief Takes the oldest captured sample from the buffer.
+ *
+ * @param sample Reference to an amgSample struct to store the sample.
+ * @return True if a sample was available, false otherwise.
+ */
+bool BNO055HighRateCapture::pop(amgSample& sample) {
+    if(tail == head) {
+        return false;
+    }
+    sample = buffer[tail];
+    tail = (tail + 1) % capacity;
+    return true;
+}
+
+/**
+ * @brief Gets the number of samples waiting in the buffer.
+ *
+ * @return The number of samples.
+ */
+uint16_t BNO055HighRateCapture::available() {
+    return (uint16_t)((head + capacity - tail) % capacity);
+}
+
+/**
+ * @brief Gets the capture statistics.
+ *
+ * This function copies the number of captured samples, the samples dropped because the buffer was full, the failed reads, the missed slots or triggers, the maximum lateness of a read in us, the achieved rate in Hz and the RMS lateness in us into the provided struct.
+ *
+ * @param stats Pointer to a captureStats struct to store the statistics.
+ */
+void BNO055HighRateCapture::getStats(captureStats *stats) {
+    foldOverruns();
+    memcpy(stats, &this->stats, sizeof(captureStats));
+    uint32_t elapsed = lastSample - started;
+    stats->rate = (elapsed > 0 && this->stats.samples > 1) ? (this->stats.samples - 1) * 1e6f / elapsed : 0;
+    stats->jitter = sqrtf(jitterSq);
+}
+
+/**
+ * @brief Resets the capture statistics.
+ */
+void BNO055HighRateCapture::resetStats() {
+    noInterrupts();
+    triggerOverruns = 0;
+    interrupts();
+    memset(&stats, 0, sizeof(captureStats));
+    jitterSq = 0;
+    started = micros();
+    lastSample = started;
+}
+
+/**
+ * @brief Adds the overruns counted by trigger() to the statistics.
+ */
+void BNO055HighRateCapture::foldOverruns() {
+    noInterrupts();
+    uint32_t overruns = triggerOverruns;
+    triggerOverruns = 0;
+    interrupts();
+    stats.overruns += overruns;
+}
+
+/**
+ * @brief Reads one sample with a single burst and stores it in the ring buffer.
+ *
+ * A failed read is counted as error and not stored.
+ *
+ * @param scheduled The time the sample was due in us.
+ * @param now The time the read starts in us, stored as the sample timestamp.
+ * @return True if the sample was stored, false if the read failed or the buffer was full.
+ */
+bool BNO055HighRateCapture::readSample(uint32_t scheduled, uint32_t now) {
+    int16_t values[9];
+    bool success;
+    if(channels == CAPTURE_ACC_GYR) {
+        success = sensor.readRawVector(ACC_X_LSB, values, 9);
+    }
+    else {
+        success = sensor.readRawVector((channels == CAPTURE_ACC) ? ACC_X_LSB : GYR_X_LSB, values, 3);
+    }
+    if(!success) {
+        stats.errors++;
+        return false;
+    }
+
+    uint32_t lateness = now - scheduled;
+    if(lateness > stats.maxLateness) {
+        stats.maxLateness = lateness;
+    }
+    uint16_t nextHead = (head + 1) % capacity;
+    if(nextHead == tail) {
+        stats.drops++;
+        return false;
+    }
+
+    if(stats.samples == 0) {
+        started = now;
+    }
+    lastSample = now;
+    stats.samples++;
+    jitterSq += ((float)lateness * lateness - jitterSq) / stats.samples;
+
+    amgSample& sample = buffer[head];
+    sample.timestamp = now;
+    for (uint8_t i = 0; i < 3; i++) {
+        sample.acc[i] = (channels & CAPTURE_ACC) ? values[i] : 0;
+        sample.gyr[i] = (channels == CAPTURE_ACC_GYR) ? values[6 + i] : ((channels == CAPTURE_GYR) ? values[i] : 0);
+    }
+    head = nextHead;
+    return true;
+}
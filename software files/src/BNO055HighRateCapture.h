@@ -0,0 +1,70 @@
+#ifndef BNO055HighRateCapture_h
+#define BNO055HighRateCapture_h
+
+#include <Arduino.h>
+#include "BNO055.h"
+
+enum CaptureChannels {
+  CAPTURE_ACC = 0x01,
+  CAPTURE_GYR = 0x02,
+  CAPTURE_ACC_GYR = 0x03
+};
+
+typedef struct {
+  uint32_t timestamp;
+  int16_t acc[3];
+  int16_t gyr[3];
+} amgSample;
+
+typedef struct {
+  uint32_t samples;
+  uint32_t drops;
+  uint32_t errors;
+  uint32_t overruns;
+  uint32_t maxLateness;
+  float rate;
+  float jitter;
+} captureStats;
+
+// Raw accelerometer/gyroscope capture at rates the fusion output cannot reach. The sensor
+// runs in a non-fusion mode with the widest filter bandwidths, and every sample is a single
+// burst read of 6 bytes (one sensor) or 18 bytes (ACC_X_LSB..GYR_Z_MSB) into a ring buffer
+// supplied by the caller. Pacing follows an absolute micros() schedule so errors do not
+// accumulate; where the application owns a hardware timer, its interrupt handler can pace
+// the capture with trigger() instead. Use Wire.setClock(400000) for rates above ~300 Hz.
+class BNO055HighRateCapture {
+  public:
+      BNO055HighRateCapture(BNO055& sensor, amgSample* buffer, uint16_t capacity);
+      void configure(CaptureChannels channels, AccRange accRange, GyrRange gyrRange);
+      bool start(uint32_t period);
+      void startTriggered();
+      void stop();
+      void trigger();
+      bool poll();
+      bool pop(amgSample& sample);
+      uint16_t available();
+      void getStats(captureStats *stats);
+      void resetStats();
+  private:
+      bool readSample(uint32_t scheduled, uint32_t now);
+      void foldOverruns();
+
+      BNO055& sensor;
+      amgSample* buffer;
+      uint16_t capacity;
+      volatile uint16_t head;
+      volatile uint16_t tail;
+      CaptureChannels channels;
+      uint32_t period;
+      uint32_t next;
+      uint32_t started;
+      uint32_t lastSample;
+      volatile uint32_t triggeredAt;
+      volatile bool pending;
+      volatile uint32_t triggerOverruns;
+      bool running;
+      bool triggered;
+      float jitterSq;
+      captureStats stats;
+};
+#endif
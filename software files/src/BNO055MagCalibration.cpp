@@ -0,0 +1,104 @@
+#include "BNO055Config.h"
+
+#if BNO055_ENABLE_FLOAT && BNO055_ENABLE_CALIBRATION
+#include "BNO055MagCalibration.h"
+
+#define MAG_LSB_PER_UT 16.0f
+
+/**
+ * @brief Constructor for BNO055MagCalibration class.
+ * 
+ * @param sensor Reference to the BNO055 sensor to be calibrated.
+ * @param buffer Caller-owned storage for the most recent samples, used to evaluate the fit quality.
+ * @param capacity The number of samples the buffer can hold.
+ */
+BNO055MagCalibration::BNO055MagCalibration(BNO055& sensor, float (*buffer)[3], uint16_t capacity) : sensor(sensor), magFit(buffer, capacity) {
+}
+
+/**
+ * @brief Discards all collected samples.
+ */
+void BNO055MagCalibration::reset() {
+    magFit.reset();
+}
+
+/**
+ * @brief Reads one magnetometer sample and adds it to the fit.
+ * 
+ * This function should be called at the magnetometer output rate while the unit is rotated through as many orientations as possible.
+ * 
+ * @return True if the sample was accepted, false if it was too close to the previous one.
+ */
+bool BNO055MagCalibration::collect() {
+    float x, y, z;
+    sensor.getMagnetometer(x, y, z);
+    return magFit.addSample(x, y, z);
+}
+
+/**
+ * @brief Fits the ellipsoid to the collected samples.
+ * 
+ * @param result Pointer to a magFitResult struct to store the fit.
+ * @return True if the samples describe a valid ellipsoid, false otherwise.
+ */
+bool BNO055MagCalibration::fit(magFitResult *result) {
+    return magFit.fit(result);
+}
+
+/**
+ * @brief Checks if a fit is good enough to be written to the sensor.
+ * 
+ * A fit is accepted when all eight octants around the center were visited, the RMS radius error is below maxRms and the radius lies in the range of the earth magnetic field.
+ * 
+ * @param result Pointer to a magFitResult struct returned by fit().
+ * @param maxRms The maximum RMS radius error relative to the radius, e.g. 0.05.
+ * @return True if the fit is good, false otherwise.
+ */
+bool BNO055MagCalibration::isGoodFit(const magFitResult *result, float maxRms) {
+    return result->valid
+        && result->coverage == 0xFF
+        && result->rms <= maxRms
+        && result->radius >= 20.0f && result->radius <= 80.0f;
+}
+
+/**
+ * @brief Writes the hard-iron offsets and the radius of a fit to the sensor.
+ * 
+ * The magnetometer data is already compensated by the current MAG_OFFSET registers, so the fitted center is added to them. The offsets are written in one burst in CONFIG mode and the previous operation mode is restored afterwards. The soft-iron scale factors have no register on the BNO055; apply them on the host with BNO055MagFit::correct().
+ * 
+ * @param result Pointer to a valid magFitResult struct.
+ * @return True if the registers were successfully written, false otherwise.
+ */
+bool BNO055MagCalibration::apply(const magFitResult *result) {
+    if(!result->valid) {
+        return false;
+    }
+
+    OperationMode mode = sensor.getMode();
+    sensor.setOperationMode(OPERATION_MODE_CONFIG);
+    sensor.waitModeReady();
+
+    calibOffsets offsets;
+    sensor.getCalibrationOffsets(&offsets);
+    offsets.magX += (int16_t)lroundf(result->offset[0] * MAG_LSB_PER_UT);
+    offsets.magY += (int16_t)lroundf(result->offset[1] * MAG_LSB_PER_UT);
+    offsets.magZ += (int16_t)lroundf(result->offset[2] * MAG_LSB_PER_UT);
+    offsets.magRadius = (int16_t)lroundf(result->radius * MAG_LSB_PER_UT);
+    bool success = sensor.setCalibrationOffsets(&offsets);
+
+    sensor.setOperationMode(mode);
+    if(success) {
+        magFit.reset();
+    }
+    return success;
+}
+
+/**
+ * @brief Gets the underlying ellipsoid fit.
+ * 
+ * @return Reference to the BNO055MagFit object, e.g. to set the minimum sample spacing.
+ */
+BNO055MagFit& BNO055MagCalibration::getFit() {
+    return magFit;
+}
+#endif
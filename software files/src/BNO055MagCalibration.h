@@ -0,0 +1,25 @@
+#ifndef BNO055MagCalibration_h
+#define BNO055MagCalibration_h
+
+#include <Arduino.h>
+#include "BNO055.h"
+#include "BNO055MagFit.h"
+
+#if !BNO055_ENABLE_FLOAT || !BNO055_ENABLE_CALIBRATION
+#error "BNO055MagCalibration requires BNO055_ENABLE_FLOAT and BNO055_ENABLE_CALIBRATION"
+#endif
+
+class BNO055MagCalibration {
+  public:
+      BNO055MagCalibration(BNO055& sensor, float (*buffer)[3], uint16_t capacity);
+      void reset();
+      bool collect();
+      bool fit(magFitResult *result);
+      bool isGoodFit(const magFitResult *result, float maxRms);
+      bool apply(const magFitResult *result);
+      BNO055MagFit& getFit();
+  private:
+      BNO055& sensor;
+      BNO055MagFit magFit;
+};
+#endif
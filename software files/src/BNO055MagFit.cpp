@@ -0,0 +1,236 @@
+#include "BNO055MagFit.h"
+#include <math.h>
+
+#define MAG_FIT_NORM 50.0   // nominal field strength in uT, keeps the normal equations well conditioned
+
+/**
+ * @brief Constructor for BNO055MagFit class.
+ *
+ * @param buffer Caller-owned storage for the most recent samples, used to evaluate the fit quality.
+ * @param capacity The number of samples the buffer can hold.
+ */
+BNO055MagFit::BNO055MagFit(float (*buffer)[3], uint16_t capacity) {
+    this->buffer = buffer;
+    this->capacity = capacity;
+    minSpacing = 1.0f;
+    reset();
+}
+
+/**
+ * @brief Discards all samples and the accumulated normal equations.
+ */
+void BNO055MagFit::reset() {
+    head = 0;
+    stored = 0;
+    count = 0;
+    for (uint8_t i = 0; i < 6; i++) {
+        rhs[i] = 0;
+        for (uint8_t j = 0; j < 6; j++) {
+            normal[i][j] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Sets the minimum distance between accepted samples.
+ *
+ * Samples closer than this to the previously accepted sample are dropped, so a sensor resting in one orientation does not dominate the fit.
+ *
+ * @param spacing The minimum distance in uT.
+ */
+void BNO055MagFit::setMinSpacing(float spacing) {
+    minSpacing = spacing;
+}
+
+/**
+ * @brief Adds a magnetometer sample to the fit.
+ *
+ * This function updates the normal equations and stores the sample in the ring buffer, overwriting the oldest one when the buffer is full.
+ *
+ * @param x Magnetic field along the x-axis in uT.
+ * @param y Magnetic field along the y-axis in uT.
+ * @param z Magnetic field along the z-axis in uT.
+ * @return True if the sample was accepted, false if it was too close to the previous one.
+ */
+bool BNO055MagFit::addSample(float x, float y, float z) {
+    if(count > 0) {
+        float dx = x - last[0];
+        float dy = y - last[1];
+        float dz = z - last[2];
+        if(dx * dx + dy * dy + dz * dz < minSpacing * minSpacing) {
+            return false;
+        }
+    }
+    else {
+        reference[0] = x;
+        reference[1] = y;
+        reference[2] = z;
+    }
+    last[0] = x;
+    last[1] = y;
+    last[2] = z;
+
+    double u = (x - reference[0]) / MAG_FIT_NORM;
+    double v = (y - reference[1]) / MAG_FIT_NORM;
+    double w = (z - reference[2]) / MAG_FIT_NORM;
+    double phi[6] = { v * v, w * w, u, v, w, 1.0 };
+    double target = -u * u;
+    for (uint8_t i = 0; i < 6; i++) {
+        rhs[i] += phi[i] * target;
+        for (uint8_t j = i; j < 6; j++) {
+            normal[i][j] += phi[i] * phi[j];
+        }
+    }
+    count++;
+
+    if(capacity > 0) {
+        buffer[head][0] = x;
+        buffer[head][1] = y;
+        buffer[head][2] = z;
+        head = (head + 1) % capacity;
+        if(stored < capacity) {
+            stored++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Solves the ellipsoid fit for all samples added so far.
+ *
+ * This function solves the normal equations, converts the ellipsoid coefficients into hard-iron offsets, per-axis soft-iron scale factors and the mean field radius, and evaluates the RMS radius error and the octant coverage over the buffered samples.
+ *
+ * @param result Pointer to a magFitResult struct to store the fit.
+ * @return True if the samples describe a valid ellipsoid, false otherwise.
+ */
+bool BNO055MagFit::fit(magFitResult *result) {
+    result->valid = false;
+    result->samples = count;
+    result->rms = 0;
+    result->coverage = 0;
+    if(count < 6) {
+        return false;
+    }
+
+    double m[6][7];
+    for (uint8_t i = 0; i < 6; i++) {
+        for (uint8_t j = 0; j < 6; j++) {
+            m[i][j] = (j >= i) ? normal[i][j] : normal[j][i];
+        }
+        m[i][6] = rhs[i];
+    }
+    double p[6];
+    if(!solve(m, p)) {
+        return false;
+    }
+    if(p[0] <= 0 || p[1] <= 0) {
+        return false;
+    }
+
+    double a[3] = { 1.0, p[0], p[1] };
+    double center[3];
+    double g = -p[5];
+    for (uint8_t i = 0; i < 3; i++) {
+        center[i] = -p[i + 2] / (2.0 * a[i]);
+        g += p[i + 2] * p[i + 2] / (4.0 * a[i]);
+    }
+    if(g <= 0) {
+        return false;
+    }
+    double radii[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        radii[i] = sqrt(g / a[i]) * MAG_FIT_NORM;
+        result->offset[i] = (float)(center[i] * MAG_FIT_NORM + reference[i]);
+    }
+    double radius = cbrt(radii[0] * radii[1] * radii[2]);
+    for (uint8_t i = 0; i < 3; i++) {
+        result->scale[i] = (float)(radius / radii[i]);
+    }
+    result->radius = (float)radius;
+
+    double sum = 0;
+    for (uint16_t k = 0; k < stored; k++) {
+        double r2 = 0;
+        uint8_t octant = 0;
+        for (uint8_t i = 0; i < 3; i++) {
+            double d = buffer[k][i] - result->offset[i];
+            r2 += (d / radii[i]) * (d / radii[i]);
+            octant |= (d >= 0) << i;
+        }
+        double e = sqrt(r2) - 1.0;
+        sum += e * e;
+        result->coverage |= 1 << octant;
+    }
+    result->rms = (stored > 0) ? (float)sqrt(sum / stored) : 0;
+    result->valid = true;
+    return true;
+}
+
+/**
+ * @brief Applies a fit result to a magnetometer sample.
+ *
+ * This function removes the hard-iron offset and equalizes the axes with the soft-iron scale factors, which the BNO055 cannot apply itself.
+ *
+ * @param result Pointer to a valid magFitResult struct.
+ * @param x Reference to the x-axis value in uT, corrected in place.
+ * @param y Reference to the y-axis value in uT, corrected in place.
+ * @param z Reference to the z-axis value in uT, corrected in place.
+ */
+void BNO055MagFit::correct(const magFitResult *result, float& x, float& y, float& z) {
+    x = (x - result->offset[0]) * result->scale[0];
+    y = (y - result->offset[1]) * result->scale[1];
+    z = (z - result->offset[2]) * result->scale[2];
+}
+
+/**
+ * @brief Gets the number of samples accepted since the last reset.
+ *
+ * @return The number of accepted samples.
+ */
+uint32_t BNO055MagFit::getSampleCount() {
+    return count;
+}
+
+/**
+ * @brief Solves a 6x6 linear system given as augmented matrix.
+ *
+ * Gaussian elimination with partial pivoting.
+ *
+ * @param m The augmented matrix, destroyed by the call.
+ * @param x Array to store the solution.
+ * @return True if the system has a unique solution, false otherwise.
+ */
+bool BNO055MagFit::solve(double m[6][7], double x[6]) {
+    for (uint8_t col = 0; col < 6; col++) {
+        uint8_t pivot = col;
+        for (uint8_t row = col + 1; row < 6; row++) {
+            if(fabs(m[row][col]) > fabs(m[pivot][col])) {
+                pivot = row;
+            }
+        }
+        if(fabs(m[pivot][col]) < 1e-12) {
+            return false;
+        }
+        if(pivot != col) {
+            for (uint8_t k = 0; k < 7; k++) {
+                double t = m[col][k];
+                m[col][k] = m[pivot][k];
+                m[pivot][k] = t;
+            }
+        }
+        for (uint8_t row = col + 1; row < 6; row++) {
+            double f = m[row][col] / m[col][col];
+            for (uint8_t k = col; k < 7; k++) {
+                m[row][k] -= f * m[col][k];
+            }
+        }
+    }
+    for (int8_t row = 5; row >= 0; row--) {
+        double s = m[row][6];
+        for (uint8_t k = row + 1; k < 6; k++) {
+            s -= m[row][k] * x[k];
+        }
+        x[row] = s / m[row][row];
+    }
+    return true;
+}
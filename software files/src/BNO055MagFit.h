@@ -0,0 +1,45 @@
+#ifndef BNO055MagFit_h
+#define BNO055MagFit_h
+
+#include <stdint.h>
+
+typedef struct {
+  float offset[3];
+  float scale[3];
+  float radius;
+  float rms;
+  uint8_t coverage;
+  uint32_t samples;
+  bool valid;
+} magFitResult;
+
+// Incremental hard/soft-iron fit of an axis-aligned ellipsoid
+//   x² + b y² + c z² + d x + e y + f z + g = 0
+// to magnetometer samples. Every sample updates the 6x6 normal equations in O(1), so
+// the fit does not depend on the buffer size; the bounded sample buffer supplied by the
+// caller is only used to evaluate the fit quality. No dynamic allocation; no Arduino
+// dependency, so the same code runs in the batch tool on the host.
+class BNO055MagFit {
+  public:
+      BNO055MagFit(float (*buffer)[3], uint16_t capacity);
+      void reset();
+      void setMinSpacing(float spacing);
+      bool addSample(float x, float y, float z);
+      bool fit(magFitResult *result);
+      void correct(const magFitResult *result, float& x, float& y, float& z);
+      uint32_t getSampleCount();
+  private:
+      bool solve(double m[6][7], double x[6]);
+
+      float (*buffer)[3];
+      uint16_t capacity;
+      uint16_t head;
+      uint16_t stored;
+      uint32_t count;
+      float minSpacing;
+      float last[3];
+      float reference[3];
+      double normal[6][6];
+      double rhs[6];
+};
+#endif
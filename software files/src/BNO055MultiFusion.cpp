@@ -0,0 +1,503 @@
+#include "BNO055MultiFusion.h"
+#include <string.h>
+#include <math.h>
+
+#define MULTI_FUSION_RAD_TO_DEG 57.2957795f
+#define MULTI_FUSION_ITERATIONS 8     // power iterations per average
+#define MULTI_FUSION_REWEIGHTS 2      // residual reweighting passes per consensus
+
+static void multiply(const float* a, const float* b, float* out) {
+    float w = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+    float x = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+    float y = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+    float z = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+    out[0] = w;
+    out[1] = x;
+    out[2] = y;
+    out[3] = z;
+}
+
+static void conjugate(const float* q, float* out) {
+    out[0] = q[0];
+    out[1] = -q[1];
+    out[2] = -q[2];
+    out[3] = -q[3];
+}
+
+static float dot(const float* a, const float* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+}
+
+// The BNO055 reports a zero quaternion outside the fusion modes and unit ones otherwise.
+static bool plausible(const float* q) {
+    float n = dot(q, q);
+    return n > 0.81f && n < 1.21f;
+}
+
+static void normalize(float* q) {
+    float n = sqrtf(dot(q, q));
+    for (uint8_t k = 0; k < 4; k++) {
+        q[k] /= n;
+    }
+}
+
+static uint8_t countBits(uint8_t mask) {
+    uint8_t n = 0;
+    for (; mask; mask &= mask - 1) {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Constructor for BNO055MultiFusion class.
+ *
+ * Loads the defaults: fault angle 10° for 3 updates, recovery after 100 updates, residual scale 2°, maximum skew 5 ms, identity mountings.
+ */
+BNO055MultiFusion::BNO055MultiFusion() {
+    setFault(10.0f, 3, 100);
+    setResidualScale(2.0f);
+    setMaxSkew(5000);
+    for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+        for (uint8_t k = 0; k < 4; k++) {
+            mounting[i][k] = k == 0 ? 1.0f : 0.0f;
+        }
+    }
+    clearAlignment();
+    reset();
+}
+
+/**
+ * @brief Readmits all excluded sensors and clears the statistics. Mountings and alignment are kept.
+ */
+void BNO055MultiFusion::reset() {
+    excluded = 0;
+    present = 0;
+    for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+        suspect[i] = 0;
+        agree[i] = 0;
+    }
+    resetStats();
+}
+
+/**
+ * @brief Sets the fault detection thresholds.
+ *
+ * @param angle The angle between a sensor and the consensus of the others above which it is suspected, in degrees.
+ * @param faultSamples The number of consecutive suspected updates before the sensor is excluded.
+ * @param recoverSamples The number of consecutive updates within half the angle before an excluded sensor is readmitted.
+ */
+void BNO055MultiFusion::setFault(float angle, uint8_t faultSamples, uint16_t recoverSamples) {
+    faultAngle = angle;
+    this->faultSamples = faultSamples > 0 ? faultSamples : 1;
+    this->recoverSamples = recoverSamples > 0 ? recoverSamples : 1;
+}
+
+/**
+ * @brief Sets the scale of the residual weight.
+ *
+ * A sensor at this angle from the consensus has half its calibration weight, at twice the angle a fifth.
+ *
+ * @param angle The residual scale in degrees, about the disagreement of healthy sensors.
+ */
+void BNO055MultiFusion::setResidualScale(float angle) {
+    residualScale = angle > 0 ? angle : 0.1f;
+}
+
+/**
+ * @brief Sets the maximum timestamp skew between the snapshots of one update.
+ *
+ * @param skew The maximum difference to the timestamp of the first plausible snapshot in us.
+ */
+void BNO055MultiFusion::setMaxSkew(uint32_t skew) {
+    maxSkew = skew;
+}
+
+/**
+ * @brief Sets the mounting of a sensor from its axis remap.
+ *
+ * @param sensor The sensor index.
+ * @param remap The remap that takes the sensor axes to the rig axes.
+ * @return False, leaving the mounting unchanged, if the remap is mirrored or the index out of range.
+ */
+bool BNO055MultiFusion::setMounting(uint8_t sensor, const BNO055Remap::AxisRemap& remap) {
+    if(sensor >= MULTI_FUSION_MAX_SENSORS || !remap.isRotation()) {
+        return false;
+    }
+    setMounting(sensor, remap.r);
+    return true;
+}
+
+/**
+ * @brief Sets the mounting of a sensor as a rotation quaternion.
+ *
+ * @param sensor The sensor index.
+ * @param rotation The unit quaternion (w, x, y, z) of the rig axes in the sensor frame, as AxisRemap::r.
+ */
+void BNO055MultiFusion::setMounting(uint8_t sensor, const float* rotation) {
+    if(sensor >= MULTI_FUSION_MAX_SENSORS) {
+        return;
+    }
+    for (uint8_t k = 0; k < 4; k++) {
+        mounting[sensor][k] = rotation[k];
+    }
+    normalize(mounting[sensor]);
+}
+
+/**
+ * @brief Aligns the world frames of the sensors to the first one.
+ *
+ * This function sets the world offset of every sensor so that all of them report the attitude of the first plausible one. Call it with the rig at rest, after the mountings are set, in fusion modes whose heading is relative (IMU, NDOF_FMC_OFF before the magnetometer is calibrated). It also absorbs small mounting errors.
+ *
+ * @param snapshots Array of count simultaneous snapshots.
+ * @param count The number of sensors.
+ * @return True if at least two sensors were aligned.
+ */
+bool BNO055MultiFusion::align(const imuSnapshot* snapshots, uint8_t count) {
+    if(count > MULTI_FUSION_MAX_SENSORS) {
+        count = MULTI_FUSION_MAX_SENSORS;
+    }
+    float reference[4];
+    float body[4];
+    float inverse[4];
+    int8_t first = -1;
+    uint8_t sensors = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if(!plausible(snapshots[i].qua)) {
+            continue;
+        }
+        conjugate(mounting[i], inverse);
+        multiply(snapshots[i].qua, inverse, body);
+        normalize(body);
+        if(first < 0) {
+            first = i;
+            multiply(world[i], body, reference);
+        }
+        else {
+            conjugate(body, inverse);
+            multiply(reference, inverse, world[i]);
+            normalize(world[i]);
+        }
+        sensors++;
+    }
+    return sensors >= 2;
+}
+
+/**
+ * @brief Resets the world offsets of all sensors to identity.
+ */
+void BNO055MultiFusion::clearAlignment() {
+    for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+        for (uint8_t k = 0; k < 4; k++) {
+            world[i][k] = k == 0 ? 1.0f : 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Checks the snapshots and brings their quaternions into the rig frame.
+ *
+ * @param snapshots Array of count snapshots.
+ * @param health Array of count health readings, or NULL.
+ * @param count The number of sensors.
+ * @return True if at least one snapshot is plausible.
+ */
+bool BNO055MultiFusion::prepare(const imuSnapshot* snapshots, const sensorHealth* health, uint8_t count) {
+    present = 0;
+    bool haveReference = false;
+    uint32_t reference = 0;
+    float inverse[4];
+    float body[4];
+    for (uint8_t i = 0; i < count; i++) {
+        const imuSnapshot& s = snapshots[i];
+        bool ok = plausible(s.qua) && (health == NULL || health[i].status != SYSTEM_STATUS_ERROR);
+        if(ok && haveReference) {
+            int32_t skew = (int32_t)(s.timestamp - reference);
+            ok = (uint32_t)(skew < 0 ? -skew : skew) <= maxSkew;
+        }
+        if(!ok) {
+            stats.dropped++;
+            continue;
+        }
+        if(!haveReference) {
+            reference = s.timestamp;
+            haveReference = true;
+        }
+        conjugate(mounting[i], inverse);
+        multiply(s.qua, inverse, body);
+        multiply(world[i], body, aligned[i]);
+        normalize(aligned[i]);
+        calibration[i] = health == NULL ? 1.0f : (1 + health[i].calSys) * (1 + health[i].calGyro) / 16.0f;
+        present |= 1 << i;
+    }
+    return present != 0;
+}
+
+/**
+ * @brief Computes the weighted quaternion average of a set of sensors.
+ *
+ * @param mask Bit i set if sensor i is averaged.
+ * @param weights The weight of every sensor.
+ * @param q Array of 4 floats to store the average (w >= 0).
+ * @return False if the total weight is zero.
+ */
+bool BNO055MultiFusion::average(uint8_t mask, const float* weights, float* q) {
+    int8_t pivot = -1;
+    for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+        if(((mask >> i) & 0x01) && weights[i] > 0 && (pivot < 0 || weights[i] > weights[pivot])) {
+            pivot = i;
+        }
+    }
+    if(pivot < 0) {
+        return false;
+    }
+
+    // M = Σ wᵢ qᵢ qᵢᵀ, upper triangle, and the sign-aligned weighted sum as the start vector
+    float m[4][4] = { { 0 } };
+    float v[4] = { 0, 0, 0, 0 };
+    for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+        if(!((mask >> i) & 0x01) || weights[i] <= 0) {
+            continue;
+        }
+        const float* a = aligned[i];
+        float w = weights[i];
+        float signedWeight = dot(a, aligned[pivot]) < 0 ? -w : w;
+        for (uint8_t r = 0; r < 4; r++) {
+            v[r] += signedWeight * a[r];
+            for (uint8_t c = r; c < 4; c++) {
+                m[r][c] += w * a[r] * a[c];
+            }
+        }
+    }
+    normalize(v);
+
+    for (uint8_t n = 0; n < MULTI_FUSION_ITERATIONS; n++) {
+        float next[4];
+        for (uint8_t r = 0; r < 4; r++) {
+            next[r] = 0;
+            for (uint8_t c = 0; c < 4; c++) {
+                next[r] += (r <= c ? m[r][c] : m[c][r]) * v[c];
+            }
+        }
+        normalize(next);
+        float change = 0;
+        for (uint8_t k = 0; k < 4; k++) {
+            change += (next[k] - v[k]) * (next[k] - v[k]);
+            v[k] = next[k];
+        }
+        if(change < 1e-12f) {
+            break;
+        }
+    }
+
+    float sign = v[0] < 0 ? -1.0f : 1.0f;
+    for (uint8_t k = 0; k < 4; k++) {
+        q[k] = sign * v[k];
+    }
+    return true;
+}
+
+/**
+ * @brief Computes the residual-weighted consensus of a set of sensors.
+ *
+ * @param mask Bit i set if sensor i takes part.
+ * @param q Array of 4 floats to store the consensus.
+ * @return False if no sensor has weight.
+ */
+bool BNO055MultiFusion::consensus(uint8_t mask, float* q) {
+    if(!average(mask, calibration, q)) {
+        return false;
+    }
+    float weights[MULTI_FUSION_MAX_SENSORS];
+    for (uint8_t pass = 0; pass < MULTI_FUSION_REWEIGHTS; pass++) {
+        for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+            float r = ((mask >> i) & 0x01) ? angle(aligned[i], q) / residualScale : 0;
+            weights[i] = ((mask >> i) & 0x01) ? calibration[i] / (1 + r * r) : 0;
+        }
+        average(mask, weights, q);
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the rotation angle between two unit quaternions.
+ *
+ * @return The angle in degrees, 0..180.
+ */
+float BNO055MultiFusion::angle(const float* a, const float* b) {
+    float d = fabsf(dot(a, b));
+    return 2 * acosf(d < 1 ? d : 1) * MULTI_FUSION_RAD_TO_DEG;
+}
+
+/**
+ * @brief Fuses one set of simultaneous snapshots.
+ *
+ * @param snapshots Array of count snapshots, sensor i at index i.
+ * @param health Array of count health readings for the calibration weights and error status, or NULL for equal weights.
+ * @param count The number of sensors, at most MULTI_FUSION_MAX_SENSORS.
+ * @param out The fused attitude. The quaternion is left unchanged if no sensor is usable.
+ * @return True if the output is valid.
+ */
+bool BNO055MultiFusion::update(const imuSnapshot* snapshots, const sensorHealth* health, uint8_t count, fusedAttitude& out) {
+    if(count > MULTI_FUSION_MAX_SENSORS) {
+        count = MULTI_FUSION_MAX_SENSORS;
+    }
+    stats.updates++;
+    out.valid = false;
+    out.disagree = false;
+    out.used = 0;
+    out.spread = 0;
+
+    float q[4];
+    uint8_t used = 0;
+    if(prepare(snapshots, health, count)) {
+        used = present & ~excluded;
+    }
+    if(used == 0 || !consensus(used, q)) {
+        for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+            suspect[i] = 0;
+            agree[i] = 0;
+        }
+        out.excluded = excluded;
+        stats.invalid++;
+        return false;
+    }
+
+    // attribute a disagreement to one sensor
+    int8_t candidate = -1;
+    bool disagree = false;
+    uint8_t n = countBits(used);
+    if(n >= 3) {
+        int8_t worst = -1;
+        float worstResidual = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            float r = ((used >> i) & 0x01) ? angle(aligned[i], q) : 0;
+            if(r > worstResidual) {
+                worstResidual = r;
+                worst = i;
+            }
+        }
+        if(worstResidual > faultAngle) {
+            float others[4];
+            uint8_t rest = used & ~(1 << worst);
+            consensus(rest, others);
+            bool consistent = angle(aligned[worst], others) > faultAngle;
+            for (uint8_t i = 0; i < count && consistent; i++) {
+                consistent = !((rest >> i) & 0x01) || angle(aligned[i], others) <= faultAngle;
+            }
+            if(consistent) {
+                candidate = worst;
+                for (uint8_t k = 0; k < 4; k++) {
+                    q[k] = others[k];
+                }
+            }
+            else {
+                disagree = true;
+            }
+        }
+    }
+    else if(n == 2) {
+        uint8_t a = 0;
+        while (!((used >> a) & 0x01)) {
+            a++;
+        }
+        uint8_t b = a + 1;
+        while (!((used >> b) & 0x01)) {
+            b++;
+        }
+        if(angle(aligned[a], aligned[b]) > faultAngle) {
+            if(calibration[a] != calibration[b]) {
+                candidate = calibration[a] < calibration[b] ? a : b;
+                uint8_t keep = candidate == a ? b : a;
+                for (uint8_t k = 0; k < 4; k++) {
+                    q[k] = aligned[keep][k];
+                }
+            }
+            else {
+                disagree = true;
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+        if(i == candidate) {
+            if(suspect[i] < 0xFF) {
+                suspect[i]++;
+            }
+        }
+        else {
+            suspect[i] = 0;
+        }
+    }
+    if(candidate >= 0) {
+        used &= ~(1 << candidate);
+        if(suspect[candidate] >= faultSamples) {
+            excluded |= 1 << candidate;
+            suspect[candidate] = 0;
+            agree[candidate] = 0;
+            stats.exclusions++;
+        }
+    }
+
+    // readmit excluded sensors that follow the output again
+    for (uint8_t i = 0; i < MULTI_FUSION_MAX_SENSORS; i++) {
+        if(!((excluded >> i) & 0x01)) {
+            continue;
+        }
+        if(disagree || !((present >> i) & 0x01) || angle(aligned[i], q) >= faultAngle / 2) {
+            agree[i] = 0;
+        }
+        else if(++agree[i] >= recoverSamples) {
+            excluded &= ~(1 << i);
+            agree[i] = 0;
+            stats.recoveries++;
+        }
+    }
+
+    uint8_t first = 0;
+    while (!((used >> first) & 0x01)) {
+        first++;
+    }
+    int32_t offset = 0;
+    float spread = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if((used >> i) & 0x01) {
+            offset += (int32_t)(snapshots[i].timestamp - snapshots[first].timestamp);
+            float r = angle(aligned[i], q);
+            spread = r > spread ? r : spread;
+        }
+    }
+
+    out.timestamp = snapshots[first].timestamp + offset / countBits(used);
+    for (uint8_t k = 0; k < 4; k++) {
+        out.qua[k] = q[k];
+    }
+    out.spread = spread;
+    out.used = used;
+    out.excluded = excluded;
+    out.disagree = disagree;
+    out.valid = !disagree;
+    if(disagree) {
+        stats.disagreements++;
+        stats.invalid++;
+    }
+    return out.valid;
+}
+
+/**
+ * @brief Gets the fusion statistics.
+ *
+ * This function copies the number of updates, invalid outputs, unattributed disagreements, exclusions, readmissions and dropped samples into the provided struct.
+ *
+ * @param stats Pointer to a multiFusionStats struct to store the statistics.
+ */
+void BNO055MultiFusion::getStats(multiFusionStats *stats) {
+    memcpy(stats, &this->stats, sizeof(multiFusionStats));
+}
+
+/**
+ * @brief Clears the fusion statistics.
+ */
+void BNO055MultiFusion::resetStats() {
+    memset(&stats, 0, sizeof(multiFusionStats));
+}
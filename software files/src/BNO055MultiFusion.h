@@ -0,0 +1,90 @@
+#ifndef BNO055MultiFusion_h
+#define BNO055MultiFusion_h
+
+#include <stdint.h>
+#include "BNO055Decode.h"
+#include "BNO055AxisRemap.h"
+
+#define MULTI_FUSION_MAX_SENSORS 8
+
+typedef struct {
+  uint32_t timestamp;
+  float qua[4];
+  float spread;     // largest angle between a used sensor and the output, degrees
+  uint8_t used;     // bit i set if sensor i contributed
+  uint8_t excluded; // bit i set if sensor i is excluded as faulty
+  bool disagree;    // the sensors disagree and the fault cannot be attributed
+  bool valid;
+} fusedAttitude;
+
+typedef struct {
+  uint32_t updates;
+  uint32_t invalid;
+  uint32_t disagreements;
+  uint32_t exclusions;
+  uint32_t recoveries;
+  uint32_t dropped;  // samples rejected as implausible (zero quaternion, error status, skew)
+} multiFusionStats;
+
+// Fuses the orientation of up to MULTI_FUSION_MAX_SENSORS redundant sensors on one rig.
+// Every snapshot quaternion is first brought into the rig frame, q' = w ⊗ q ⊗ conj(m):
+// m is the mounting rotation of the sensor on the rig (same convention as AxisRemap) and
+// w the offset between the world frames, which align() estimates for fusion modes
+// without the magnetometer, where every sensor starts at its own heading.
+//
+// The quaternions are averaged with the eigenvector method (Markley et al.): the output
+// is the dominant eigenvector of M = Σ wᵢ qᵢ qᵢᵀ, which is insensitive to the sign of
+// each qᵢ. It is found by power iteration from the sign-aligned weighted sum, which is
+// already close, so a few iterations on the 4x4 matrix suffice. The weights combine the
+// calibration status, (1 + calSys)(1 + calGyro) / 16, with a Cauchy weight on the angle
+// to the consensus, which is refined twice (iteratively reweighted).
+//
+// A used sensor further than the fault angle from the consensus of the others for
+// faultSamples consecutive updates is excluded, and readmitted after recoverSamples
+// updates within half the fault angle. With three or more sensors the outlier is found by
+// leave-one-out; with two a disagreement can only be attributed by the calibration
+// status, otherwise the output is marked disagree and not valid. Samples with a zero or
+// non-unit quaternion, error status or more than the maximum skew from the first
+// sensor's timestamp are dropped for that update. Everything is fixed size; no Arduino
+// dependency.
+class BNO055MultiFusion {
+  public:
+      BNO055MultiFusion();
+      void reset();
+      void setFault(float angle, uint8_t faultSamples, uint16_t recoverSamples);
+      void setResidualScale(float angle);
+      void setMaxSkew(uint32_t skew);
+      bool setMounting(uint8_t sensor, const BNO055Remap::AxisRemap& remap);
+      void setMounting(uint8_t sensor, const float* rotation);
+      bool align(const imuSnapshot* snapshots, uint8_t count);
+      void clearAlignment();
+      bool update(const imuSnapshot* snapshots, const sensorHealth* health, uint8_t count, fusedAttitude& out);
+      void getStats(multiFusionStats *stats);
+      void resetStats();
+  private:
+      bool prepare(const imuSnapshot* snapshots, const sensorHealth* health, uint8_t count);
+      bool average(uint8_t mask, const float* weights, float* q);
+      bool consensus(uint8_t mask, float* q);
+      float angle(const float* a, const float* b);
+
+      float faultAngle;
+      float residualScale;
+      uint8_t faultSamples;
+      uint16_t recoverSamples;
+      uint32_t maxSkew;
+
+      float mounting[MULTI_FUSION_MAX_SENSORS][4];
+      float world[MULTI_FUSION_MAX_SENSORS][4];
+      uint8_t suspect[MULTI_FUSION_MAX_SENSORS];
+      uint16_t agree[MULTI_FUSION_MAX_SENSORS];
+      uint8_t excluded;
+
+      // per-update scratch
+      float aligned[MULTI_FUSION_MAX_SENSORS][4];
+      float calibration[MULTI_FUSION_MAX_SENSORS];
+      float residual[MULTI_FUSION_MAX_SENSORS];
+      uint8_t present;
+
+      multiFusionStats stats;
+};
+#endif
@@ -0,0 +1,294 @@
+#include "BNO055Config.h"
+
+#if BNO055_ENABLE_INTERRUPTS
+#include "BNO055PowerManager.h"
+
+#define POWER_WAKE_SETTLE 20     // ms until the first fused sample after a wake
+#define POWER_POLL_WINDOW 200    // ms spent in low power mode on a suspend poll
+
+/**
+ * @brief Constructor for BNO055PowerManager class.
+ *
+ * Binds the power manager to an already constructed BNO055 object and loads the default motion detection settings.
+ *
+ * @param sensor Reference to the BNO055 sensor to be managed.
+ */
+BNO055PowerManager::BNO055PowerManager(BNO055& sensor) : sensor(sensor) {
+    runMode = OPERATION_MODE_NDOF;
+    state = POWER_STATE_NORMAL;
+    lowPowerTimeout = 0;
+    suspendTimeout = 0;
+    suspendPollInterval = 0;
+    lastMotion = 0;
+    stateEntered = 0;
+    lastAccounted = 0;
+    wakeStarted = 0;
+    validAt = 0;
+    waking = false;
+    sampleValid = false;
+    motionPending = false;
+    amThreshold = 0x14;
+    nmThreshold = 0x0A;
+    nmDuration = 0x05;
+    memset(&stats, 0, sizeof(powerStats));
+}
+
+/**
+ * @brief Starts the power manager.
+ *
+ * This function arms the accelerometer any-motion and no-motion interrupts in CONFIG mode, puts the sensor into normal power mode and starts the given operation mode. The sensor is moved to low power mode after lowPowerTimeout ms without motion and to suspend mode after a further suspendTimeout ms.
+ *
+ * @param runMode The operation mode used whenever the sensor is not suspended.
+ * @param lowPowerTimeout Idle time in ms before entering low power mode.
+ * @param suspendTimeout Idle time in ms spent in low power mode before entering suspend mode, 0 disables suspend.
+ */
+void BNO055PowerManager::begin(OperationMode runMode, uint32_t lowPowerTimeout, uint32_t suspendTimeout) {
+    this->runMode = runMode;
+    this->lowPowerTimeout = lowPowerTimeout;
+    this->suspendTimeout = suspendTimeout;
+
+    sensor.setOperationMode(OPERATION_MODE_CONFIG);
+    sensor.waitModeReady();
+    armMotionInterrupts();
+    sensor.setPowerMode(POWERMODE_NORMAL);
+    sensor.setOperationMode(runMode);
+
+    uint32_t now = millis();
+    state = POWER_STATE_NORMAL;
+    lastMotion = now;
+    stateEntered = now;
+    lastAccounted = now;
+    wakeStarted = now;
+    validAt = now + POWER_WAKE_SETTLE;
+    waking = true;
+    sampleValid = false;
+    motionPending = false;
+}
+
+/**
+ * @brief Sets the accelerometer motion settings used for automatic wake-up.
+ *
+ * This function stores the any-motion threshold, no-motion threshold and no-motion duration. They are written to the sensor by begin().
+ *
+ * @param amThreshold The ACC_AM_THRES value.
+ * @param nmThreshold The ACC_NM_THRES value.
+ * @param nmDuration The no-motion duration field of ACC_NM_SET.
+ */
+void BNO055PowerManager::setMotionConfig(uint8_t amThreshold, uint8_t nmThreshold, uint8_t nmDuration) {
+    this->amThreshold = amThreshold;
+    this->nmThreshold = nmThreshold;
+    this->nmDuration = nmDuration;
+}
+
+/**
+ * @brief Sets the interval for periodic motion checks while suspended.
+ *
+ * The accelerometer is not running in suspend mode, so motion cannot be detected. When an interval is set the sensor is briefly moved to low power mode every interval ms to look for motion.
+ *
+ * @param interval Poll interval in ms, 0 keeps the sensor suspended until wake() is called.
+ */
+void BNO055PowerManager::setSuspendPollInterval(uint32_t interval) {
+    suspendPollInterval = interval;
+}
+
+/**
+ * @brief Reports a motion event to the power manager.
+ *
+ * This function only sets a flag and is safe to call from the interrupt handler of the INT pin. The state change itself is performed by update().
+ */
+void BNO055PowerManager::notifyMotion() {
+    motionPending = true;
+}
+
+/**
+ * @brief Runs the power state machine.
+ *
+ * This function must be called regularly from the main loop. It accounts the time spent in the current state, polls the interrupt status for any-motion events and moves the sensor between normal, low power and suspend mode according to the configured idle timeouts.
+ */
+void BNO055PowerManager::update() {
+    uint32_t now = millis();
+    accountTime(now);
+
+    bool motion = motionPending;
+    if(!motion && state != POWER_STATE_SUSPEND) {
+        motion = pollMotion();
+    }
+
+    if(motion) {
+        motionPending = false;
+        lastMotion = now;
+        sensor.interruptReset();
+        if(state != POWER_STATE_NORMAL) {
+            wakeStarted = now;
+            enterState(POWER_STATE_NORMAL);
+        }
+        return;
+    }
+
+    uint32_t idle = now - lastMotion;
+    switch(state) {
+    case POWER_STATE_NORMAL:
+        if(idle >= lowPowerTimeout) {
+            enterState(POWER_STATE_LOW);
+        }
+        break;
+    case POWER_STATE_LOW:
+        if(suspendTimeout != 0 && idle >= lowPowerTimeout + suspendTimeout) {
+            enterState(POWER_STATE_SUSPEND);
+        }
+        break;
+    case POWER_STATE_SUSPEND:
+        if(suspendPollInterval != 0 && now - stateEntered >= suspendPollInterval) {
+            uint32_t window = suspendTimeout < POWER_POLL_WINDOW ? suspendTimeout : POWER_POLL_WINDOW;
+            lastMotion = now - lowPowerTimeout - suspendTimeout + window;
+            enterState(POWER_STATE_LOW);
+        }
+        break;
+    }
+}
+
+/**
+ * @brief Wakes the sensor up on request of the application.
+ *
+ * This function moves the sensor to normal power mode immediately and restarts the idle timers. The wake-up latency is measured from this call until isSampleValid() first returns true.
+ */
+void BNO055PowerManager::wake() {
+    uint32_t now = millis();
+    accountTime(now);
+    motionPending = false;
+    lastMotion = now;
+    if(state != POWER_STATE_NORMAL) {
+        wakeStarted = now;
+        enterState(POWER_STATE_NORMAL);
+    }
+}
+
+/**
+ * @brief Checks if the sensor delivers valid samples.
+ *
+ * After a wake-up the output registers still hold stale values until the run mode has started and produced a new sample. This function returns false until the mode switch and the settle time have passed and SYS_STATUS reports the run mode as running.
+ *
+ * @return True if a sample read now is valid, false otherwise.
+ */
+bool BNO055PowerManager::isSampleValid() {
+    if(sampleValid) {
+        return true;
+    }
+    if(state != POWER_STATE_NORMAL || (int32_t)(millis() - validAt) < 0 || !sensor.isModeReady()) {
+        return false;
+    }
+
+    uint8_t status = sensor.read<BNO055Reg::SysStatusValue>();
+    uint8_t expected = (runMode >= OPERATION_MODE_IMUPLUS) ? 0x05 : 0x06;
+    if(status != expected) {
+        return false;
+    }
+
+    sampleValid = true;
+    if(waking) {
+        waking = false;
+        stats.lastWakeLatency = millis() - wakeStarted;
+        if(stats.lastWakeLatency > stats.maxWakeLatency) {
+            stats.maxWakeLatency = stats.lastWakeLatency;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the current power state.
+ *
+ * @return The current power state (NORMAL, LOW, SUSPEND).
+ */
+PowerState BNO055PowerManager::getState() {
+    return state;
+}
+
+/**
+ * @brief Gets the power statistics.
+ *
+ * This function copies the time spent in each state in ms, the number of transitions and wake-ups, and the last and maximum wake-up latency in ms into the provided struct.
+ *
+ * @param stats Pointer to a powerStats struct to store the statistics.
+ */
+void BNO055PowerManager::getStats(powerStats *stats) {
+    accountTime(millis());
+    memcpy(stats, &this->stats, sizeof(powerStats));
+}
+
+/**
+ * @brief Resets the power statistics.
+ */
+void BNO055PowerManager::resetStats() {
+    memset(&stats, 0, sizeof(powerStats));
+    lastAccounted = millis();
+}
+
+/**
+ * @brief Moves the sensor into the given power state.
+ *
+ * The power mode can only be changed in CONFIG mode, so this function switches to CONFIG mode, clears any latched motion interrupt, writes the new power mode and restores the run mode.
+ *
+ * @param state The power state to enter.
+ */
+void BNO055PowerManager::enterState(PowerState state) {
+    uint32_t now = millis();
+    accountTime(now);
+
+    sensor.setOperationMode(OPERATION_MODE_CONFIG);
+    sensor.waitModeReady();
+    sensor.interruptReset();
+    sensor.setPowerMode((PowerMode)state);
+    sensor.setOperationMode(runMode);
+
+    if(state == POWER_STATE_NORMAL) {
+        stats.wakeups++;
+        waking = true;
+        sampleValid = false;
+        validAt = millis() + POWER_WAKE_SETTLE;
+    }
+    else {
+        waking = false;
+        sampleValid = false;
+    }
+
+    stats.transitions++;
+    this->state = state;
+    stateEntered = millis();
+    accountTime(stateEntered);
+}
+
+/**
+ * @brief Configures the any-motion and no-motion interrupts.
+ *
+ * The sensor has to be in CONFIG mode when this function is called. Both interrupts are routed to the INT pin so they can wake the host as well.
+ */
+void BNO055PowerManager::armMotionInterrupts() {
+    sensor.accAMThresh(amThreshold);
+    sensor.accNMThresh(nmThreshold);
+    sensor.accNMSet(nmDuration, false);
+    sensor.accIntSettings(0x00, 0x07, 0x00);
+    sensor.interruptMask(ACC_AM | ACC_NM);
+    sensor.interruptEnable(ACC_AM | ACC_NM);
+    sensor.interruptReset();
+}
+
+/**
+ * @brief Adds the time since the last call to the current state.
+ *
+ * @param now The current time in ms.
+ */
+void BNO055PowerManager::accountTime(uint32_t now) {
+    stats.timeInState[state] += now - lastAccounted;
+    lastAccounted = now;
+}
+
+/**
+ * @brief Polls the interrupt status register for an any-motion event.
+ *
+ * @return True if the any-motion interrupt has fired, false otherwise.
+ */
+bool BNO055PowerManager::pollMotion() {
+    return (sensor.read<BNO055Reg::IntStaAll>() & ACC_AM) != 0;
+}
+#endif
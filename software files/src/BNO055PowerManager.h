@@ -0,0 +1,63 @@
+#ifndef BNO055PowerManager_h
+#define BNO055PowerManager_h
+
+#include <Arduino.h>
+#include "BNO055.h"
+
+#if !BNO055_ENABLE_INTERRUPTS
+#error "BNO055PowerManager requires BNO055_ENABLE_INTERRUPTS"
+#endif
+
+enum PowerState {
+  POWER_STATE_NORMAL = 0x00,
+  POWER_STATE_LOW = 0x01,
+  POWER_STATE_SUSPEND = 0x02
+};
+
+typedef struct {
+  uint32_t timeInState[3];
+  uint32_t transitions;
+  uint32_t wakeups;
+  uint32_t lastWakeLatency;
+  uint32_t maxWakeLatency;
+} powerStats;
+
+class BNO055PowerManager {
+  public:
+      BNO055PowerManager(BNO055& sensor);
+      void begin(OperationMode runMode, uint32_t lowPowerTimeout, uint32_t suspendTimeout);
+      void setMotionConfig(uint8_t amThreshold, uint8_t nmThreshold, uint8_t nmDuration);
+      void setSuspendPollInterval(uint32_t interval);
+      void notifyMotion();
+      void update();
+      void wake();
+      bool isSampleValid();
+      PowerState getState();
+      void getStats(powerStats *stats);
+      void resetStats();
+  private:
+      void enterState(PowerState state);
+      void armMotionInterrupts();
+      void accountTime(uint32_t now);
+      bool pollMotion();
+
+      BNO055& sensor;
+      OperationMode runMode;
+      PowerState state;
+      uint32_t lowPowerTimeout;
+      uint32_t suspendTimeout;
+      uint32_t suspendPollInterval;
+      uint32_t lastMotion;
+      uint32_t stateEntered;
+      uint32_t lastAccounted;
+      uint32_t wakeStarted;
+      uint32_t validAt;
+      bool waking;
+      bool sampleValid;
+      volatile bool motionPending;
+      uint8_t amThreshold;
+      uint8_t nmThreshold;
+      uint8_t nmDuration;
+      powerStats stats;
+};
+#endif
@@ -0,0 +1,322 @@
+#include "BNO055RegisterMap.h"
+#include "BNO055Registers.h"
+#include <string.h>
+#include <stddef.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#define REGISTER_MAP_PROGMEM PROGMEM
+#define REGISTER_MAP_COPY memcpy_P
+#else
+#define REGISTER_MAP_PROGMEM
+#define REGISTER_MAP_COPY memcpy
+#endif
+
+#define REGISTER_FIELD(field, flags, name) { \
+    BNO055Reg::field::reg::page, BNO055Reg::field::reg::address, BNO055Reg::field::reg::width, \
+    (uint8_t)((BNO055Reg::field::reg::writable ? REGISTER_FIELD_WRITABLE : 0) | \
+              (BNO055Reg::field::reg::readable ? 0 : REGISTER_FIELD_WRITE_ONLY) | (flags)), \
+    BNO055Reg::field::mask, name }
+
+#define V REGISTER_FIELD_VOLATILE
+#define S REGISTER_FIELD_SIGNED
+#define N REGISTER_FIELD_NO_RESTORE
+
+namespace BNO055RegisterMap {
+
+// sorted by page and address; PAGE_ID is driver state and left out
+static const registerField fields[] REGISTER_MAP_PROGMEM = {
+    REGISTER_FIELD(ChipIdValue, 0, "CHIP_ID"),
+    REGISTER_FIELD(AccIdValue, 0, "ACC_ID"),
+    REGISTER_FIELD(MagIdValue, 0, "MAG_ID"),
+    REGISTER_FIELD(GyrIdValue, 0, "GYR_ID"),
+    REGISTER_FIELD(SwRevIdValue, 0, "SW_REV_ID"),
+    REGISTER_FIELD(BlRevIdValue, 0, "BL_REV_ID"),
+    REGISTER_FIELD(AccDataXValue, V | S, "ACC_DATA_X"),
+    REGISTER_FIELD(AccDataYValue, V | S, "ACC_DATA_Y"),
+    REGISTER_FIELD(AccDataZValue, V | S, "ACC_DATA_Z"),
+    REGISTER_FIELD(MagDataXValue, V | S, "MAG_DATA_X"),
+    REGISTER_FIELD(MagDataYValue, V | S, "MAG_DATA_Y"),
+    REGISTER_FIELD(MagDataZValue, V | S, "MAG_DATA_Z"),
+    REGISTER_FIELD(GyrDataXValue, V | S, "GYR_DATA_X"),
+    REGISTER_FIELD(GyrDataYValue, V | S, "GYR_DATA_Y"),
+    REGISTER_FIELD(GyrDataZValue, V | S, "GYR_DATA_Z"),
+    REGISTER_FIELD(EulHeadingValue, V | S, "EUL_HEADING"),
+    REGISTER_FIELD(EulRollValue, V | S, "EUL_ROLL"),
+    REGISTER_FIELD(EulPitchValue, V | S, "EUL_PITCH"),
+    REGISTER_FIELD(QuaDataWValue, V | S, "QUA_DATA_W"),
+    REGISTER_FIELD(QuaDataXValue, V | S, "QUA_DATA_X"),
+    REGISTER_FIELD(QuaDataYValue, V | S, "QUA_DATA_Y"),
+    REGISTER_FIELD(QuaDataZValue, V | S, "QUA_DATA_Z"),
+    REGISTER_FIELD(LiaDataXValue, V | S, "LIA_DATA_X"),
+    REGISTER_FIELD(LiaDataYValue, V | S, "LIA_DATA_Y"),
+    REGISTER_FIELD(LiaDataZValue, V | S, "LIA_DATA_Z"),
+    REGISTER_FIELD(GrvDataXValue, V | S, "GRV_DATA_X"),
+    REGISTER_FIELD(GrvDataYValue, V | S, "GRV_DATA_Y"),
+    REGISTER_FIELD(GrvDataZValue, V | S, "GRV_DATA_Z"),
+    REGISTER_FIELD(TempValue, V, "TEMP"),
+    REGISTER_FIELD(CalibStatMag, V, "MAG_CALIB_STAT"),
+    REGISTER_FIELD(CalibStatAcc, V, "ACC_CALIB_STAT"),
+    REGISTER_FIELD(CalibStatGyr, V, "GYR_CALIB_STAT"),
+    REGISTER_FIELD(CalibStatSys, V, "SYS_CALIB_STAT"),
+    REGISTER_FIELD(SelftestResultAll, V, "SELFTEST_RESULT"),
+    REGISTER_FIELD(IntStaAll, V, "INT_STA"),
+    REGISTER_FIELD(SysClkStatusMain, V, "ST_MAIN_CLK"),
+    REGISTER_FIELD(SysStatusValue, V, "SYS_STATUS"),
+    REGISTER_FIELD(SysErrValue, V, "SYS_ERR"),
+    REGISTER_FIELD(UnitSelAcc, 0, "ACC_UNIT"),
+    REGISTER_FIELD(UnitSelGyr, 0, "GYR_UNIT"),
+    REGISTER_FIELD(UnitSelEul, 0, "EUL_UNIT"),
+    REGISTER_FIELD(UnitSelTemp, 0, "TEMP_UNIT"),
+    REGISTER_FIELD(UnitSelOrientation, 0, "ORI_ANDROID_WIN"),
+    REGISTER_FIELD(OprModeMode, N, "OPR_MODE"),
+    REGISTER_FIELD(PwrModeMode, 0, "PWR_MODE"),
+    REGISTER_FIELD(SysTriggerSelfTest, V | N, "SELF_TEST"),
+    REGISTER_FIELD(SysTriggerRstSys, V | N, "RST_SYS"),
+    REGISTER_FIELD(SysTriggerRstInt, V | N, "RST_INT"),
+    REGISTER_FIELD(SysTriggerClkSel, N, "CLK_SEL"),
+    REGISTER_FIELD(TempSourceSelect, 0, "TEMP_SOURCE"),
+    REGISTER_FIELD(AxisMapConfigAll, 0, "AXIS_MAP_CONFIG"),
+    REGISTER_FIELD(AxisMapSignAll, 0, "AXIS_MAP_SIGN"),
+    REGISTER_FIELD(AccOffsetXValue, S, "ACC_OFFSET_X"),
+    REGISTER_FIELD(AccOffsetYValue, S, "ACC_OFFSET_Y"),
+    REGISTER_FIELD(AccOffsetZValue, S, "ACC_OFFSET_Z"),
+    REGISTER_FIELD(MagOffsetXValue, S, "MAG_OFFSET_X"),
+    REGISTER_FIELD(MagOffsetYValue, S, "MAG_OFFSET_Y"),
+    REGISTER_FIELD(MagOffsetZValue, S, "MAG_OFFSET_Z"),
+    REGISTER_FIELD(GyrOffsetXValue, S, "GYR_OFFSET_X"),
+    REGISTER_FIELD(GyrOffsetYValue, S, "GYR_OFFSET_Y"),
+    REGISTER_FIELD(GyrOffsetZValue, S, "GYR_OFFSET_Z"),
+    REGISTER_FIELD(AccRadiusValue, S, "ACC_RADIUS"),
+    REGISTER_FIELD(MagRadiusValue, S, "MAG_RADIUS"),
+
+    REGISTER_FIELD(AccConfigRange, 0, "ACC_RANGE"),
+    REGISTER_FIELD(AccConfigBW, 0, "ACC_BW"),
+    REGISTER_FIELD(AccConfigPwrMode, 0, "ACC_PWR_MODE"),
+    REGISTER_FIELD(MagConfigRate, 0, "MAG_DATA_RATE"),
+    REGISTER_FIELD(MagConfigOprMode, 0, "MAG_OPR_MODE"),
+    REGISTER_FIELD(MagConfigPwrMode, 0, "MAG_PWR_MODE"),
+    REGISTER_FIELD(GyrConfig0Range, 0, "GYR_RANGE"),
+    REGISTER_FIELD(GyrConfig0BW, 0, "GYR_BANDWIDTH"),
+    REGISTER_FIELD(GyrConfig1PwrMode, 0, "GYR_PWR_MODE"),
+    REGISTER_FIELD(AccSleepConfigMode, 0, "ACC_SLP_MODE"),
+    REGISTER_FIELD(AccSleepConfigDuration, 0, "ACC_SLP_DURATION"),
+    REGISTER_FIELD(GyrSleepConfigDuration, 0, "GYR_SLP_DURATION"),
+    REGISTER_FIELD(GyrSleepConfigAutoSleep, 0, "GYR_AUTO_SLP_DUR"),
+    REGISTER_FIELD(IntMskAll, 0, "INT_MSK"),
+    REGISTER_FIELD(IntEnAll, 0, "INT_EN"),
+    REGISTER_FIELD(AccAmThresValue, 0, "ACC_AM_THRES"),
+    REGISTER_FIELD(AccIntSettingsAmDuration, 0, "ACC_AM_DUR"),
+    REGISTER_FIELD(AccIntSettingsAmNmAxis, 0, "ACC_AM_NM_AXES"),
+    REGISTER_FIELD(AccIntSettingsHgAxis, 0, "ACC_HG_AXES"),
+    REGISTER_FIELD(AccHgDurationValue, 0, "ACC_HG_DURATION"),
+    REGISTER_FIELD(AccHgThresValue, 0, "ACC_HG_THRES"),
+    REGISTER_FIELD(AccNmThresValue, 0, "ACC_NM_THRES"),
+    REGISTER_FIELD(AccNmSetSmnm, 0, "ACC_NM_SMNM"),
+    REGISTER_FIELD(AccNmSetDuration, 0, "ACC_NM_DURATION"),
+    REGISTER_FIELD(GyrIntSettingAmAxis, 0, "GYR_AM_AXES"),
+    REGISTER_FIELD(GyrIntSettingHrAxis, 0, "GYR_HR_AXES"),
+    REGISTER_FIELD(GyrIntSettingAmFilter, 0, "GYR_AM_FILT"),
+    REGISTER_FIELD(GyrIntSettingHrFilter, 0, "GYR_HR_FILT"),
+    REGISTER_FIELD(GyrHrXSetThreshold, 0, "GYR_HR_X_THRES"),
+    REGISTER_FIELD(GyrHrXSetHysteresis, 0, "GYR_HR_X_HYST"),
+    REGISTER_FIELD(GyrDurXValue, 0, "GYR_DUR_X"),
+    REGISTER_FIELD(GyrHrYSetThreshold, 0, "GYR_HR_Y_THRES"),
+    REGISTER_FIELD(GyrHrYSetHysteresis, 0, "GYR_HR_Y_HYST"),
+    REGISTER_FIELD(GyrDurYValue, 0, "GYR_DUR_Y"),
+    REGISTER_FIELD(GyrHrZSetThreshold, 0, "GYR_HR_Z_THRES"),
+    REGISTER_FIELD(GyrHrZSetHysteresis, 0, "GYR_HR_Z_HYST"),
+    REGISTER_FIELD(GyrDurZValue, 0, "GYR_DUR_Z"),
+    REGISTER_FIELD(GyrAmThresValue, 0, "GYR_AM_THRES"),
+    REGISTER_FIELD(GyrAmSetSlopeSamples, 0, "GYR_AM_SAMPLES"),
+    REGISTER_FIELD(GyrAmSetAwakeDuration, 0, "GYR_AM_AWAKE_DUR")
+};
+
+#undef V
+#undef S
+#undef N
+
+/**
+ * @brief Gets the number of named fields.
+ *
+ * @return The number of entries in the field table.
+ */
+uint8_t fieldCount() {
+    return sizeof(fields) / sizeof(fields[0]);
+}
+
+/**
+ * @brief Gets an entry of the field table.
+ *
+ * This function copies the entry out of flash on AVR.
+ *
+ * @param index The index of the field, below fieldCount().
+ * @param field Pointer to a registerField struct to store the entry.
+ */
+void getField(uint8_t index, registerField* field) {
+    REGISTER_MAP_COPY(field, &fields[index], sizeof(registerField));
+}
+
+/**
+ * @brief Finds the byte of a register in an image.
+ *
+ * @param image The register image.
+ * @param page The register page, 0 or 1.
+ * @param address The register address.
+ * @return Pointer to the byte, or NULL if the register is not part of the image.
+ */
+uint8_t* locate(registerImage* image, uint8_t page, uint8_t address) {
+    if(page == 0 && address < REGISTER_PAGE0_SIZE) {
+        return &image->page0[address];
+    }
+    if(page == 1 && address >= REGISTER_PAGE1_START && address - REGISTER_PAGE1_START < REGISTER_PAGE1_SIZE) {
+        return &image->page1[address - REGISTER_PAGE1_START];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Finds the byte of a register in a read-only image.
+ *
+ * @param image The register image.
+ * @param page The register page, 0 or 1.
+ * @param address The register address.
+ * @return Pointer to the byte, or NULL if the register is not part of the image.
+ */
+const uint8_t* locate(const registerImage* image, uint8_t page, uint8_t address) {
+    return locate((registerImage*)image, page, address);
+}
+
+/**
+ * @brief Extracts the value of a field from an image.
+ *
+ * 16-bit fields are assembled LSB first. Signed fields are returned as their two's complement bit pattern; cast the result to int16_t.
+ *
+ * @param image The register image.
+ * @param field The field.
+ * @return The value of the field, shifted down to bit 0.
+ */
+uint16_t fieldValue(const registerImage* image, const registerField& field) {
+    const uint8_t* bytes = locate(image, field.page, field.address);
+    if(bytes == NULL) {
+        return 0;
+    }
+    uint16_t raw = bytes[0];
+    if(field.width == 2) {
+        raw |= (uint16_t)bytes[1] << 8;
+    }
+    uint16_t mask = field.mask;
+    raw &= mask;
+    while (mask != 0 && (mask & 0x01) == 0) {
+        mask >>= 1;
+        raw >>= 1;
+    }
+    return raw;
+}
+
+/**
+ * @brief Compares two images field by field.
+ *
+ * Volatile fields (measurements, status and trigger bits) change on their own and are skipped unless all is set.
+ *
+ * @param before The first image.
+ * @param after The second image.
+ * @param changes Array to store up to max changed fields in table order.
+ * @param max The capacity of changes.
+ * @param all True to compare the volatile fields too.
+ * @return The number of changed fields, which may exceed max.
+ */
+uint8_t diff(const registerImage* before, const registerImage* after, registerChange* changes, uint8_t max, bool all) {
+    uint8_t found = 0;
+    registerField field;
+    for (uint8_t i = 0; i < fieldCount(); i++) {
+        getField(i, &field);
+        if(!all && (field.flags & REGISTER_FIELD_VOLATILE)) {
+            continue;
+        }
+        uint16_t a = fieldValue(before, field);
+        uint16_t b = fieldValue(after, field);
+        if(a != b) {
+            if(found < max) {
+                changes[found].field = i;
+                changes[found].before = a;
+                changes[found].after = b;
+            }
+            found++;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Plans the writes that bring the registers from one image to another.
+ *
+ * This function walks both pages in address order. A register is written if one of its restorable fields (writable and not marked REGISTER_FIELD_NO_RESTORE) differs; its other bits keep their current value, or are written as zero on write-only registers. Changed registers are coalesced into bursts of consecutive writable registers, and up to REGISTER_BURST_GAP unchanged ones between them are written along, which is cheaper than the address header of a new transaction. OPR_MODE is not planned; the caller sets the mode last. With the current register map at most 14 bursts result, below REGISTER_MAX_BURSTS.
+ *
+ * @param current The image of the registers as they are.
+ * @param target The image to restore.
+ * @param bursts Array of REGISTER_MAX_BURSTS entries to store the bursts, page 0 first.
+ * @param values Image to store the bytes to write at the burst addresses; may be the same as current.
+ * @return The number of bursts, 0 if nothing needs to be written.
+ */
+uint8_t planRestore(const registerImage* current, const registerImage* target, registerBurst* bursts, registerImage* values) {
+    const uint8_t total = fieldCount();
+    registerField field;
+    uint8_t count = 0;
+    uint8_t cursor = 0;
+    for (uint8_t page = 0; page < 2; page++) {
+        const uint8_t first = (page == 0) ? 0 : REGISTER_PAGE1_START;
+        const uint8_t end = first + ((page == 0) ? REGISTER_PAGE0_SIZE : REGISTER_PAGE1_SIZE);
+        bool open = false;
+        uint8_t start = 0;
+        uint8_t last = 0;
+        // one step past the end closes an open burst
+        for (uint8_t address = first; address <= end; address++) {
+            // the table is sorted, so the fields covering this address follow the cursor
+            uint8_t mask = 0;
+            bool writeOnly = false;
+            while (cursor < total) {
+                getField(cursor, &field);
+                if(field.page > page || (field.page == page && field.address + field.width > address)) {
+                    break;
+                }
+                cursor++;
+            }
+            for (uint8_t i = cursor; address < end && i < total; i++) {
+                getField(i, &field);
+                if(field.page != page || field.address > address) {
+                    break;
+                }
+                if((field.flags & (REGISTER_FIELD_WRITABLE | REGISTER_FIELD_NO_RESTORE)) == REGISTER_FIELD_WRITABLE) {
+                    mask |= (uint8_t)(field.mask >> (8 * (address - field.address)));
+                    writeOnly = writeOnly || (field.flags & REGISTER_FIELD_WRITE_ONLY);
+                }
+            }
+
+            bool changed = false;
+            if(mask != 0) {
+                uint8_t now = *locate(current, page, address);
+                uint8_t wanted = *locate(target, page, address);
+                changed = ((now ^ wanted) & mask) != 0;
+                *locate(values, page, address) = (wanted & mask) | (writeOnly ? 0 : (now & ~mask));
+            }
+            if(changed) {
+                start = open ? start : address;
+                last = address;
+                open = true;
+            }
+            else if(open && (mask == 0 || address - last > REGISTER_BURST_GAP)) {
+                if(count < REGISTER_MAX_BURSTS) {
+                    bursts[count].page = page;
+                    bursts[count].start = start;
+                    bursts[count].length = last - start + 1;
+                    count++;
+                }
+                open = false;
+            }
+        }
+    }
+    return count;
+}
+
+}
@@ -0,0 +1,65 @@
+#ifndef BNO055RegisterMap_h
+#define BNO055RegisterMap_h
+
+#include <stdint.h>
+
+#define REGISTER_PAGE0_SIZE 0x6B    // CHIP_ID..MAG_RADIUS_MSB
+#define REGISTER_PAGE1_START 0x07   // PAGE_ID
+#define REGISTER_PAGE1_SIZE 25      // PAGE_ID..GYR_AM_SET
+#define REGISTER_MAX_BURSTS 16      // worst case of planRestore over the writable registers
+#define REGISTER_BURST_GAP 3        // unchanged registers written along rather than starting a new burst
+
+enum RegisterFieldFlags {
+  REGISTER_FIELD_WRITABLE = 0x01,
+  REGISTER_FIELD_WRITE_ONLY = 0x02,
+  REGISTER_FIELD_VOLATILE = 0x04,    // changes without a write: measurements, status, triggers
+  REGISTER_FIELD_NO_RESTORE = 0x08,  // writable, but not written by a restore
+  REGISTER_FIELD_SIGNED = 0x10
+};
+
+// Image of both register pages as read by BNO055::dumpRegisters(): page 0 from CHIP_ID,
+// page 1 from PAGE_ID, each in address order. The unique ID (page 1, 0x50-0x5F) is left
+// out; it differs between units by design.
+typedef struct {
+  uint8_t page0[REGISTER_PAGE0_SIZE];
+  uint8_t page1[REGISTER_PAGE1_SIZE];
+} registerImage;
+
+typedef struct {
+  uint8_t page;
+  uint8_t address;
+  uint8_t width;
+  uint8_t flags;
+  uint16_t mask;
+  char name[18];
+} registerField;
+
+typedef struct {
+  uint8_t field;
+  uint16_t before;
+  uint16_t after;
+} registerChange;
+
+typedef struct {
+  uint8_t page;
+  uint8_t start;
+  uint8_t length;
+} registerBurst;
+
+// Named fields of the register map for diagnostics, taken from the compile-time
+// description in BNO055Registers.h so the masks cannot diverge. The table is sorted by
+// page and address and lives in flash on AVR. diff() reports changed fields by name;
+// planRestore() finds the writable registers that differ from a target image and
+// coalesces them into as few bursts as possible. No Arduino dependency.
+namespace BNO055RegisterMap {
+
+uint8_t fieldCount();
+void getField(uint8_t index, registerField* field);
+uint8_t* locate(registerImage* image, uint8_t page, uint8_t address);
+const uint8_t* locate(const registerImage* image, uint8_t page, uint8_t address);
+uint16_t fieldValue(const registerImage* image, const registerField& field);
+uint8_t diff(const registerImage* before, const registerImage* after, registerChange* changes, uint8_t max, bool all = false);
+uint8_t planRestore(const registerImage* current, const registerImage* target, registerBurst* bursts, registerImage* values);
+
+}
+#endif
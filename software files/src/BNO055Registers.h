@@ -0,0 +1,249 @@
+#ifndef BNO055Registers_h
+#define BNO055Registers_h
+
+#include <stdint.h>
+
+// Compile-time description of the BNO055 register map. Every register carries its page,
+// address, width and access rights; every field its register, shift and bit count. The
+// templated BNO055::read<Field>() / BNO055::write<Fields...>() accessors use this to
+// select the page, fold the bit packing into constants and reject invalid combinations.
+namespace BNO055Reg {
+
+enum Access {
+  ACCESS_RO = 0x01,
+  ACCESS_WO = 0x02,
+  ACCESS_RW = 0x03
+};
+
+template<typename A, typename B> struct isSame { static constexpr bool value = false; };
+template<typename A> struct isSame<A, A> { static constexpr bool value = true; };
+
+template<uint8_t Page, uint8_t Address, uint8_t Width, Access Rights>
+struct Register {
+  static_assert(Page <= 1, "BNO055 has register pages 0 and 1 only");
+  static_assert(Width == 1 || Width == 2, "registers are 8 or 16 bit wide");
+  static constexpr uint8_t page = Page;
+  static constexpr uint8_t address = Address;
+  static constexpr uint8_t width = Width;
+  static constexpr bool readable = (Rights & ACCESS_RO) != 0;
+  static constexpr bool writable = (Rights & ACCESS_WO) != 0;
+  static constexpr uint16_t fullMask = (Width == 2) ? 0xFFFF : 0x00FF;
+};
+
+template<typename Reg, uint8_t Shift, uint8_t Bits>
+struct Field {
+  static_assert(Bits > 0 && Shift + Bits <= Reg::width * 8, "field does not fit into its register");
+  typedef Reg reg;
+  static constexpr uint8_t shift = Shift;
+  static constexpr uint16_t mask = (uint16_t)(((1UL << Bits) - 1) << Shift);
+  static constexpr uint16_t pack(uint16_t value) { return (uint16_t)((value << Shift) & mask); }
+  static constexpr uint16_t unpack(uint16_t raw) { return (uint16_t)((raw & mask) >> Shift); }
+};
+
+// Combines several fields of one register into a single mask and packed value.
+template<typename... Fields> struct FieldSet;
+
+template<typename F>
+struct FieldSet<F> {
+  typedef typename F::reg reg;
+  static constexpr uint16_t mask = F::mask;
+  static constexpr uint16_t pack(uint16_t value) { return F::pack(value); }
+};
+
+template<typename F, typename G, typename... Rest>
+struct FieldSet<F, G, Rest...> {
+  typedef typename F::reg reg;
+  static_assert(isSame<reg, typename FieldSet<G, Rest...>::reg>::value, "fields written together must belong to the same register");
+  static_assert((F::mask & FieldSet<G, Rest...>::mask) == 0, "fields written together must not overlap");
+  static constexpr uint16_t mask = F::mask | FieldSet<G, Rest...>::mask;
+  template<typename... Values>
+  static constexpr uint16_t pack(uint16_t value, Values... rest) { return F::pack(value) | FieldSet<G, Rest...>::pack(rest...); }
+};
+
+//PAGE 0
+typedef Register<0, 0x00, 1, ACCESS_RO> ChipId;
+typedef Register<0, 0x01, 1, ACCESS_RO> AccId;
+typedef Register<0, 0x02, 1, ACCESS_RO> MagId;
+typedef Register<0, 0x03, 1, ACCESS_RO> GyrId;
+typedef Register<0, 0x04, 2, ACCESS_RO> SwRevId;
+typedef Register<0, 0x06, 1, ACCESS_RO> BlRevId;
+typedef Register<0, 0x08, 2, ACCESS_RO> AccDataX;
+typedef Register<0, 0x0A, 2, ACCESS_RO> AccDataY;
+typedef Register<0, 0x0C, 2, ACCESS_RO> AccDataZ;
+typedef Register<0, 0x0E, 2, ACCESS_RO> MagDataX;
+typedef Register<0, 0x10, 2, ACCESS_RO> MagDataY;
+typedef Register<0, 0x12, 2, ACCESS_RO> MagDataZ;
+typedef Register<0, 0x14, 2, ACCESS_RO> GyrDataX;
+typedef Register<0, 0x16, 2, ACCESS_RO> GyrDataY;
+typedef Register<0, 0x18, 2, ACCESS_RO> GyrDataZ;
+typedef Register<0, 0x1A, 2, ACCESS_RO> EulHeading;
+typedef Register<0, 0x1C, 2, ACCESS_RO> EulRoll;
+typedef Register<0, 0x1E, 2, ACCESS_RO> EulPitch;
+typedef Register<0, 0x20, 2, ACCESS_RO> QuaDataW;
+typedef Register<0, 0x22, 2, ACCESS_RO> QuaDataX;
+typedef Register<0, 0x24, 2, ACCESS_RO> QuaDataY;
+typedef Register<0, 0x26, 2, ACCESS_RO> QuaDataZ;
+typedef Register<0, 0x28, 2, ACCESS_RO> LiaDataX;
+typedef Register<0, 0x2A, 2, ACCESS_RO> LiaDataY;
+typedef Register<0, 0x2C, 2, ACCESS_RO> LiaDataZ;
+typedef Register<0, 0x2E, 2, ACCESS_RO> GrvDataX;
+typedef Register<0, 0x30, 2, ACCESS_RO> GrvDataY;
+typedef Register<0, 0x32, 2, ACCESS_RO> GrvDataZ;
+typedef Register<0, 0x34, 1, ACCESS_RO> Temp;
+typedef Register<0, 0x35, 1, ACCESS_RO> CalibStat;
+typedef Register<0, 0x36, 1, ACCESS_RO> SelftestResult;
+typedef Register<0, 0x37, 1, ACCESS_RO> IntSta;
+typedef Register<0, 0x38, 1, ACCESS_RO> SysClkStatus;
+typedef Register<0, 0x39, 1, ACCESS_RO> SysStatus;
+typedef Register<0, 0x3A, 1, ACCESS_RO> SysErr;
+typedef Register<0, 0x3B, 1, ACCESS_RW> UnitSel;
+typedef Register<0, 0x3D, 1, ACCESS_RW> OprMode;
+typedef Register<0, 0x3E, 1, ACCESS_RW> PwrMode;
+typedef Register<0, 0x3F, 1, ACCESS_WO> SysTrigger;
+typedef Register<0, 0x40, 1, ACCESS_RW> TempSource;
+typedef Register<0, 0x41, 1, ACCESS_RW> AxisMapConfig;
+typedef Register<0, 0x42, 1, ACCESS_RW> AxisMapSign;
+typedef Register<0, 0x55, 2, ACCESS_RW> AccOffsetX;
+typedef Register<0, 0x57, 2, ACCESS_RW> AccOffsetY;
+typedef Register<0, 0x59, 2, ACCESS_RW> AccOffsetZ;
+typedef Register<0, 0x5B, 2, ACCESS_RW> MagOffsetX;
+typedef Register<0, 0x5D, 2, ACCESS_RW> MagOffsetY;
+typedef Register<0, 0x5F, 2, ACCESS_RW> MagOffsetZ;
+typedef Register<0, 0x61, 2, ACCESS_RW> GyrOffsetX;
+typedef Register<0, 0x63, 2, ACCESS_RW> GyrOffsetY;
+typedef Register<0, 0x65, 2, ACCESS_RW> GyrOffsetZ;
+typedef Register<0, 0x67, 2, ACCESS_RW> AccRadius;
+typedef Register<0, 0x69, 2, ACCESS_RW> MagRadius;
+
+typedef Field<ChipId, 0, 8> ChipIdValue;
+typedef Field<AccId, 0, 8> AccIdValue;
+typedef Field<MagId, 0, 8> MagIdValue;
+typedef Field<GyrId, 0, 8> GyrIdValue;
+typedef Field<SwRevId, 0, 16> SwRevIdValue;
+typedef Field<BlRevId, 0, 8> BlRevIdValue;
+typedef Field<AccDataX, 0, 16> AccDataXValue;
+typedef Field<AccDataY, 0, 16> AccDataYValue;
+typedef Field<AccDataZ, 0, 16> AccDataZValue;
+typedef Field<MagDataX, 0, 16> MagDataXValue;
+typedef Field<MagDataY, 0, 16> MagDataYValue;
+typedef Field<MagDataZ, 0, 16> MagDataZValue;
+typedef Field<GyrDataX, 0, 16> GyrDataXValue;
+typedef Field<GyrDataY, 0, 16> GyrDataYValue;
+typedef Field<GyrDataZ, 0, 16> GyrDataZValue;
+typedef Field<EulHeading, 0, 16> EulHeadingValue;
+typedef Field<EulRoll, 0, 16> EulRollValue;
+typedef Field<EulPitch, 0, 16> EulPitchValue;
+typedef Field<QuaDataW, 0, 16> QuaDataWValue;
+typedef Field<QuaDataX, 0, 16> QuaDataXValue;
+typedef Field<QuaDataY, 0, 16> QuaDataYValue;
+typedef Field<QuaDataZ, 0, 16> QuaDataZValue;
+typedef Field<LiaDataX, 0, 16> LiaDataXValue;
+typedef Field<LiaDataY, 0, 16> LiaDataYValue;
+typedef Field<LiaDataZ, 0, 16> LiaDataZValue;
+typedef Field<GrvDataX, 0, 16> GrvDataXValue;
+typedef Field<GrvDataY, 0, 16> GrvDataYValue;
+typedef Field<GrvDataZ, 0, 16> GrvDataZValue;
+typedef Field<Temp, 0, 8> TempValue;
+typedef Field<CalibStat, 0, 2> CalibStatMag;
+typedef Field<CalibStat, 2, 2> CalibStatAcc;
+typedef Field<CalibStat, 4, 2> CalibStatGyr;
+typedef Field<CalibStat, 6, 2> CalibStatSys;
+typedef Field<SelftestResult, 0, 4> SelftestResultAll;
+typedef Field<IntSta, 0, 8> IntStaAll;
+typedef Field<SysClkStatus, 0, 1> SysClkStatusMain;
+typedef Field<SysStatus, 0, 8> SysStatusValue;
+typedef Field<SysErr, 0, 8> SysErrValue;
+typedef Field<UnitSel, 0, 1> UnitSelAcc;
+typedef Field<UnitSel, 1, 1> UnitSelGyr;
+typedef Field<UnitSel, 2, 1> UnitSelEul;
+typedef Field<UnitSel, 4, 1> UnitSelTemp;
+typedef Field<UnitSel, 7, 1> UnitSelOrientation;
+typedef Field<OprMode, 0, 4> OprModeMode;
+typedef Field<PwrMode, 0, 2> PwrModeMode;
+typedef Field<SysTrigger, 0, 1> SysTriggerSelfTest;
+typedef Field<SysTrigger, 5, 1> SysTriggerRstSys;
+typedef Field<SysTrigger, 6, 1> SysTriggerRstInt;
+typedef Field<SysTrigger, 7, 1> SysTriggerClkSel;
+typedef Field<TempSource, 0, 2> TempSourceSelect;
+typedef Field<AxisMapConfig, 0, 6> AxisMapConfigAll;
+typedef Field<AxisMapSign, 0, 3> AxisMapSignAll;
+typedef Field<AccOffsetX, 0, 16> AccOffsetXValue;
+typedef Field<AccOffsetY, 0, 16> AccOffsetYValue;
+typedef Field<AccOffsetZ, 0, 16> AccOffsetZValue;
+typedef Field<MagOffsetX, 0, 16> MagOffsetXValue;
+typedef Field<MagOffsetY, 0, 16> MagOffsetYValue;
+typedef Field<MagOffsetZ, 0, 16> MagOffsetZValue;
+typedef Field<GyrOffsetX, 0, 16> GyrOffsetXValue;
+typedef Field<GyrOffsetY, 0, 16> GyrOffsetYValue;
+typedef Field<GyrOffsetZ, 0, 16> GyrOffsetZValue;
+typedef Field<AccRadius, 0, 16> AccRadiusValue;
+typedef Field<MagRadius, 0, 16> MagRadiusValue;
+
+//PAGE 1
+typedef Register<1, 0x08, 1, ACCESS_RW> AccConfig;
+typedef Register<1, 0x09, 1, ACCESS_RW> MagConfig;
+typedef Register<1, 0x0A, 1, ACCESS_RW> GyrConfig0;
+typedef Register<1, 0x0B, 1, ACCESS_RW> GyrConfig1;
+typedef Register<1, 0x0C, 1, ACCESS_RW> AccSleepConfig;
+typedef Register<1, 0x0D, 1, ACCESS_RW> GyrSleepConfig;
+typedef Register<1, 0x0F, 1, ACCESS_RW> IntMsk;
+typedef Register<1, 0x10, 1, ACCESS_RW> IntEn;
+typedef Register<1, 0x11, 1, ACCESS_RW> AccAmThres;
+typedef Register<1, 0x12, 1, ACCESS_RW> AccIntSettings;
+typedef Register<1, 0x13, 1, ACCESS_RW> AccHgDuration;
+typedef Register<1, 0x14, 1, ACCESS_RW> AccHgThres;
+typedef Register<1, 0x15, 1, ACCESS_RW> AccNmThres;
+typedef Register<1, 0x16, 1, ACCESS_RW> AccNmSet;
+typedef Register<1, 0x17, 1, ACCESS_RW> GyrIntSetting;
+typedef Register<1, 0x18, 1, ACCESS_RW> GyrHrXSet;
+typedef Register<1, 0x19, 1, ACCESS_RW> GyrDurX;
+typedef Register<1, 0x1A, 1, ACCESS_RW> GyrHrYSet;
+typedef Register<1, 0x1B, 1, ACCESS_RW> GyrDurY;
+typedef Register<1, 0x1C, 1, ACCESS_RW> GyrHrZSet;
+typedef Register<1, 0x1D, 1, ACCESS_RW> GyrDurZ;
+typedef Register<1, 0x1E, 1, ACCESS_RW> GyrAmThres;
+typedef Register<1, 0x1F, 1, ACCESS_RW> GyrAmSet;
+
+typedef Field<AccConfig, 0, 2> AccConfigRange;
+typedef Field<AccConfig, 2, 3> AccConfigBW;
+typedef Field<AccConfig, 5, 3> AccConfigPwrMode;
+typedef Field<MagConfig, 0, 3> MagConfigRate;
+typedef Field<MagConfig, 3, 2> MagConfigOprMode;
+typedef Field<MagConfig, 5, 2> MagConfigPwrMode;
+typedef Field<GyrConfig0, 0, 3> GyrConfig0Range;
+typedef Field<GyrConfig0, 3, 3> GyrConfig0BW;
+typedef Field<GyrConfig1, 0, 3> GyrConfig1PwrMode;
+typedef Field<AccSleepConfig, 0, 1> AccSleepConfigMode;
+typedef Field<AccSleepConfig, 1, 4> AccSleepConfigDuration;
+typedef Field<GyrSleepConfig, 0, 3> GyrSleepConfigDuration;
+typedef Field<GyrSleepConfig, 3, 3> GyrSleepConfigAutoSleep;
+typedef Field<IntMsk, 0, 8> IntMskAll;
+typedef Field<IntEn, 0, 8> IntEnAll;
+typedef Field<AccAmThres, 0, 8> AccAmThresValue;
+typedef Field<AccIntSettings, 0, 2> AccIntSettingsAmDuration;
+typedef Field<AccIntSettings, 2, 3> AccIntSettingsAmNmAxis;
+typedef Field<AccIntSettings, 5, 3> AccIntSettingsHgAxis;
+typedef Field<AccHgDuration, 0, 8> AccHgDurationValue;
+typedef Field<AccHgThres, 0, 8> AccHgThresValue;
+typedef Field<AccNmThres, 0, 8> AccNmThresValue;
+typedef Field<AccNmSet, 0, 1> AccNmSetSmnm;
+typedef Field<AccNmSet, 1, 6> AccNmSetDuration;
+typedef Field<GyrIntSetting, 0, 3> GyrIntSettingAmAxis;
+typedef Field<GyrIntSetting, 3, 3> GyrIntSettingHrAxis;
+typedef Field<GyrIntSetting, 6, 1> GyrIntSettingAmFilter;
+typedef Field<GyrIntSetting, 7, 1> GyrIntSettingHrFilter;
+typedef Field<GyrHrXSet, 0, 5> GyrHrXSetThreshold;
+typedef Field<GyrHrXSet, 5, 2> GyrHrXSetHysteresis;
+typedef Field<GyrDurX, 0, 8> GyrDurXValue;
+typedef Field<GyrHrYSet, 0, 5> GyrHrYSetThreshold;
+typedef Field<GyrHrYSet, 5, 2> GyrHrYSetHysteresis;
+typedef Field<GyrDurY, 0, 8> GyrDurYValue;
+typedef Field<GyrHrZSet, 0, 5> GyrHrZSetThreshold;
+typedef Field<GyrHrZSet, 5, 2> GyrHrZSetHysteresis;
+typedef Field<GyrDurZ, 0, 8> GyrDurZValue;
+typedef Field<GyrAmThres, 0, 7> GyrAmThresValue;
+typedef Field<GyrAmSet, 0, 2> GyrAmSetSlopeSamples;
+typedef Field<GyrAmSet, 2, 2> GyrAmSetAwakeDuration;
+
+}
+#endif
@@ -0,0 +1,317 @@
+#include "BNO055Resampler.h"
+#include <math.h>
+#include <string.h>
+
+#define RESAMPLE_SLERP_LINEAR 0.9995f   // quaternion dot product above which SLERP falls back to a normalized lerp
+
+/**
+ * @brief Constructor for BNO055Resampler class.
+ *
+ * @param rateNum Numerator of the output rate in Hz.
+ * @param rateDen Denominator of the output rate, e.g. 1 for integer rates or 1001 for 30000/1001 Hz.
+ * @param mode The interpolation used for the vector channels (LINEAR, CUBIC).
+ */
+BNO055Resampler::BNO055Resampler(uint32_t rateNum, uint32_t rateDen, InterpolationMode mode) {
+    this->rateNum = rateNum;
+    this->rateDen = rateDen;
+    this->mode = mode;
+    maxGap = 0;
+    fullTurn = 360.0f;
+    reset();
+}
+
+/**
+ * @brief Discards all buffered samples, the grid origin and the statistics.
+ */
+void BNO055Resampler::reset() {
+    head = 0;
+    stored = 0;
+    origin = 0;
+    index = 0;
+    originSet = false;
+    memset(&stats, 0, sizeof(resamplerStats));
+}
+
+/**
+ * @brief Sets the time of the first grid point.
+ *
+ * By default the grid starts at the timestamp of the first input sample. Setting the origin explicitly aligns the grid to an external clock, e.g. a video frame, or aligns several resamplers to each other.
+ *
+ * @param origin The time of grid point 0 in us, in the time base of the snapshot timestamps.
+ */
+void BNO055Resampler::setOrigin(uint32_t origin) {
+    this->origin = origin;
+    index = 0;
+    originSet = true;
+}
+
+/**
+ * @brief Sets the longest input interval that is interpolated.
+ *
+ * When two consecutive input samples are further apart, the interval is not bridged: the grid points inside it are skipped and interpolation restarts at the later sample.
+ *
+ * @param maxGap The maximum interval in us, 0 bridges intervals of any length.
+ */
+void BNO055Resampler::setMaxGap(uint32_t maxGap) {
+    this->maxGap = maxGap;
+}
+
+/**
+ * @brief Sets the angle unit of the Euler channels.
+ *
+ * @param fullTurn The value of a full turn, 360 for degrees (default) or 2π for radians.
+ */
+void BNO055Resampler::setAngleUnit(float fullTurn) {
+    this->fullTurn = fullTurn;
+}
+
+/**
+ * @brief Adds an input sample.
+ *
+ * All grid points up to the previous sample should be taken with pop() before the next sample is pushed; grid points the window has moved past are skipped.
+ *
+ * @param sample The snapshot to add, its timestamp in us must be later than that of the previous sample.
+ * @return True if the sample was accepted, false if its timestamp was not increasing.
+ */
+bool BNO055Resampler::push(const imuSnapshot& sample) {
+    if(stored > 0) {
+        int32_t delta = (int32_t)(sample.timestamp - this->sample(0).timestamp);
+        if(delta <= 0) {
+            stats.rejected++;
+            return false;
+        }
+        if(maxGap != 0 && (uint32_t)delta > maxGap) {
+            stored = 0;
+            stats.gaps++;
+        }
+    }
+    if(!originSet) {
+        origin = sample.timestamp;
+        originSet = true;
+    }
+    history[head] = sample;
+    head = (head + 1) & 0x03;
+    if(stored < 4) {
+        stored++;
+    }
+    stats.inputs++;
+    return true;
+}
+
+/**
+ * @brief Takes the next output sample.
+ *
+ * This function should be called until it returns false after every push().
+ *
+ * @param out Reference to an imuSnapshot struct to store the interpolated sample, its timestamp is the grid time.
+ * @return True if a grid point was interpolated, false if more input is needed.
+ */
+bool BNO055Resampler::pop(imuSnapshot& out) {
+    uint8_t need = (mode == INTERPOLATION_CUBIC) ? 3 : 2;
+    if(stored < need) {
+        return false;
+    }
+    const imuSnapshot& a = sample(need - 1);
+    const imuSnapshot& b = sample(need - 2);
+    uint32_t time = gridTime(index);
+    if((int32_t)(time - a.timestamp) < 0) {
+        skipTo(a.timestamp);
+        time = gridTime(index);
+    }
+    if((int32_t)(time - b.timestamp) > 0) {
+        return false;
+    }
+    interpolate(time, out);
+    index++;
+    stats.outputs++;
+    return true;
+}
+
+/**
+ * @brief Resamples a recorded sequence in one call.
+ *
+ * This function resets the resampler, keeping rate, mode, gap and angle settings, and feeds the whole sequence through it. An origin set before the call is kept.
+ *
+ * @param in Array of input snapshots in time order.
+ * @param count The number of input snapshots.
+ * @param out Array to store the output snapshots.
+ * @param capacity The number of snapshots the output array can hold.
+ * @return The number of output snapshots written.
+ */
+size_t BNO055Resampler::resample(const imuSnapshot* in, size_t count, imuSnapshot* out, size_t capacity) {
+    uint32_t keepOrigin = origin;
+    bool keep = originSet;
+    reset();
+    if(keep) {
+        setOrigin(keepOrigin);
+    }
+    size_t written = 0;
+    for (size_t i = 0; i < count; i++) {
+        push(in[i]);
+        while (written < capacity && pop(out[written])) {
+            written++;
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Gets the resampler statistics.
+ *
+ * This function copies the number of accepted inputs, produced outputs, rejected inputs, skipped grid points and gaps into the provided struct.
+ *
+ * @param stats Pointer to a resamplerStats struct to store the statistics.
+ */
+void BNO055Resampler::getStats(resamplerStats *stats) {
+    memcpy(stats, &this->stats, sizeof(resamplerStats));
+}
+
+/**
+ * @brief Gets a buffered input sample.
+ *
+ * @param age 0 for the newest sample, 1 for the one before, and so on.
+ * @return Reference to the sample.
+ */
+const imuSnapshot& BNO055Resampler::sample(uint8_t age) {
+    return history[(head + 3 - age) & 0x03];
+}
+
+/**
+ * @brief Gets the time of a grid point.
+ *
+ * The time is computed from the index instead of being accumulated, so fractional periods do not drift.
+ *
+ * @param index The grid point index.
+ * @return The time of the grid point in us.
+ */
+uint32_t BNO055Resampler::gridTime(uint32_t index) {
+    return origin + (uint32_t)(((uint64_t)index * 1000000UL * rateDen) / rateNum);
+}
+
+/**
+ * @brief Advances the grid to the first point at or after the given time.
+ *
+ * The distance is taken from the current grid point rather than from the origin, so the comparison stays valid however long the stream has been running.
+ *
+ * @param time The time in us.
+ */
+void BNO055Resampler::skipTo(uint32_t time) {
+    uint32_t current = gridTime(index);
+    if((int32_t)(time - current) <= 0) {
+        return;
+    }
+    uint64_t period = 1000000ULL * rateDen;
+    uint32_t skip = (uint32_t)(((uint64_t)(time - current) * rateNum) / period);
+    // the grid times are rounded down, so the estimate can be one point short
+    while ((int32_t)(gridTime(index + skip) - time) < 0) {
+        skip++;
+    }
+    stats.skipped += skip;
+    index += skip;
+}
+
+/**
+ * @brief Interpolates the buffered samples at the given time.
+ *
+ * The cubic Hermite tangents are finite differences over the neighbouring samples with their actual timestamps; at the start of a sequence the missing neighbour is replaced by a one-sided difference.
+ *
+ * @param time The time in us, inside the current input interval.
+ * @param out Reference to an imuSnapshot struct to store the result.
+ */
+void BNO055Resampler::interpolate(uint32_t time, imuSnapshot& out) {
+    bool cubic = (mode == INTERPOLATION_CUBIC);
+    uint8_t ageB = cubic ? 1 : 0;
+    const imuSnapshot& a = sample(ageB + 1);
+    const imuSnapshot& b = sample(ageB);
+    const imuSnapshot& p = (cubic && stored == 4) ? sample(3) : a;
+    const imuSnapshot& n = cubic ? sample(0) : b;
+
+    float h = (float)(b.timestamp - a.timestamp);
+    float u = (float)(time - a.timestamp) / h;
+    float ka = h / (float)(b.timestamp - p.timestamp);
+    float kb = h / (float)(n.timestamp - a.timestamp);
+    float u2 = u * u;
+    float u3 = u2 * u;
+    float h00 = 2 * u3 - 3 * u2 + 1;
+    float h10 = u3 - 2 * u2 + u;
+    float h01 = -2 * u3 + 3 * u2;
+    float h11 = u3 - u2;
+
+    const float* va[5] = { a.acc, a.mag, a.gyr, a.lia, a.grv };
+    const float* vb[5] = { b.acc, b.mag, b.gyr, b.lia, b.grv };
+    const float* vp[5] = { p.acc, p.mag, p.gyr, p.lia, p.grv };
+    const float* vn[5] = { n.acc, n.mag, n.gyr, n.lia, n.grv };
+    float* vo[5] = { out.acc, out.mag, out.gyr, out.lia, out.grv };
+    for (uint8_t v = 0; v < 5; v++) {
+        for (uint8_t i = 0; i < 3; i++) {
+            if(cubic) {
+                float ma = (vb[v][i] - vp[v][i]) * ka;
+                float mb = (vn[v][i] - va[v][i]) * kb;
+                vo[v][i] = h00 * va[v][i] + h10 * ma + h01 * vb[v][i] + h11 * mb;
+            }
+            else {
+                vo[v][i] = va[v][i] + (vb[v][i] - va[v][i]) * u;
+            }
+        }
+    }
+
+    float half = fullTurn * 0.5f;
+    for (uint8_t i = 0; i < 3; i++) {
+        float d = b.eul[i] - a.eul[i];
+        if(d > half) {
+            d -= fullTurn;
+        }
+        else if(d < -half) {
+            d += fullTurn;
+        }
+        float e = a.eul[i] + d * u;
+        if(i == 0) {
+            if(e < 0) {
+                e += fullTurn;
+            }
+            else if(e >= fullTurn) {
+                e -= fullTurn;
+            }
+        }
+        else if(e > half) {
+            e -= fullTurn;
+        }
+        else if(e < -half) {
+            e += fullTurn;
+        }
+        out.eul[i] = e;
+    }
+
+    float dot = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        dot += a.qua[i] * b.qua[i];
+    }
+    float sign = (dot < 0) ? -1.0f : 1.0f;
+    dot *= sign;
+    float wa;
+    float wb;
+    if(dot > RESAMPLE_SLERP_LINEAR) {
+        wa = 1.0f - u;
+        wb = u;
+    }
+    else {
+        float theta = acosf(dot);
+        float s = sinf(theta);
+        wa = sinf((1.0f - u) * theta) / s;
+        wb = sinf(u * theta) / s;
+    }
+    float norm = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        out.qua[i] = wa * a.qua[i] + wb * sign * b.qua[i];
+        norm += out.qua[i] * out.qua[i];
+    }
+    if(norm > 0) {
+        norm = 1.0f / sqrtf(norm);
+        for (uint8_t i = 0; i < 4; i++) {
+            out.qua[i] *= norm;
+        }
+    }
+
+    out.temp = a.temp + (b.temp - a.temp) * u;
+    out.timestamp = time;
+}
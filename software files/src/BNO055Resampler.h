@@ -0,0 +1,58 @@
+#ifndef BNO055Resampler_h
+#define BNO055Resampler_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include "BNO055Decode.h"
+
+enum InterpolationMode {
+  INTERPOLATION_LINEAR = 0x00,
+  INTERPOLATION_CUBIC = 0x01
+};
+
+typedef struct {
+  uint32_t inputs;
+  uint32_t outputs;
+  uint32_t rejected;
+  uint32_t skipped;
+  uint32_t gaps;
+} resamplerStats;
+
+// Resamples timestamped snapshots onto a fixed time grid of rateNum/rateDen Hz (e.g.
+// 30000/1001 for NTSC video). Quaternions use SLERP, Euler angles are interpolated
+// linearly along the shorter way around, vectors linearly or with a cubic Hermite spline
+// that tolerates jittered input timestamps. A grid point is emitted as soon as the input
+// sample after it has arrived (linear) or one input sample later (cubic), so the latency
+// is bounded by one or two input periods. No dynamic allocation; no Arduino dependency,
+// so the same code runs on the host.
+class BNO055Resampler {
+  public:
+      BNO055Resampler(uint32_t rateNum, uint32_t rateDen, InterpolationMode mode);
+      void reset();
+      void setOrigin(uint32_t origin);
+      void setMaxGap(uint32_t maxGap);
+      void setAngleUnit(float fullTurn);
+      bool push(const imuSnapshot& sample);
+      bool pop(imuSnapshot& out);
+      size_t resample(const imuSnapshot* in, size_t count, imuSnapshot* out, size_t capacity);
+      void getStats(resamplerStats *stats);
+  private:
+      const imuSnapshot& sample(uint8_t age);
+      uint32_t gridTime(uint32_t index);
+      void skipTo(uint32_t time);
+      void interpolate(uint32_t time, imuSnapshot& out);
+
+      imuSnapshot history[4];
+      uint8_t head;
+      uint8_t stored;
+      InterpolationMode mode;
+      uint32_t rateNum;
+      uint32_t rateDen;
+      uint32_t origin;
+      uint32_t index;
+      uint32_t maxGap;
+      bool originSet;
+      float fullTurn;
+      resamplerStats stats;
+};
+#endif
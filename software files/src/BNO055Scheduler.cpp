@@ -0,0 +1,164 @@
+#include "BNO055Scheduler.h"
+
+/**
+ * @brief Constructor for BNO055Scheduler class.
+ */
+BNO055Scheduler::BNO055Scheduler() {
+    count = 0;
+    memset(tasks, 0, sizeof(tasks));
+}
+
+/**
+ * @brief Adds a periodic task.
+ *
+ * @param function The function to run, it receives the context pointer.
+ * @param context Pointer passed to the function, e.g. the sensor or a state struct.
+ * @param period The period in us, or 0 for a one-shot task that disables itself after its run.
+ * @param offset Delay of the first run in us, used to spread tasks with the same period.
+ * @return The task number, or -1 if SCHEDULER_MAX_TASKS tasks are already registered.
+ */
+int8_t BNO055Scheduler::addTask(taskFunction function, void* context, uint32_t period, uint32_t offset) {
+    if(count >= SCHEDULER_MAX_TASKS) {
+        return -1;
+    }
+    taskEntry& t = tasks[count];
+    t.function = function;
+    t.context = context;
+    t.period = period;
+    t.next = micros() + offset;
+    t.enabled = true;
+    memset(&t.stats, 0, sizeof(taskStats));
+    return count++;
+}
+
+/**
+ * @brief Changes the period of a task. The new period applies from the next run.
+ *
+ * @param task The task number returned by addTask.
+ * @param period The period in us, or 0 to make the task one-shot.
+ */
+void BNO055Scheduler::setPeriod(uint8_t task, uint32_t period) {
+    if(task < count) {
+        tasks[task].period = period;
+    }
+}
+
+/**
+ * @brief Enables or disables a task. An enabled task is due immediately, which also rearms a one-shot task.
+ *
+ * @param task The task number returned by addTask.
+ * @param enabled True to run the task, false to suspend it.
+ */
+void BNO055Scheduler::setEnabled(uint8_t task, bool enabled) {
+    if(task < count) {
+        if(enabled && !tasks[task].enabled) {
+            tasks[task].next = micros();
+        }
+        tasks[task].enabled = enabled;
+    }
+}
+
+/**
+ * @brief Runs the due task with the earliest deadline.
+ *
+ * @return True if a task was run, false if no task was due.
+ */
+bool BNO055Scheduler::runOnce() {
+    uint32_t now = micros();
+    int8_t selected = -1;
+    int32_t latest = -1;
+    for (uint8_t i = 0; i < count; i++) {
+        int32_t lateness = (int32_t)(now - tasks[i].next);
+        if(tasks[i].enabled && lateness >= 0 && lateness > latest) {
+            selected = i;
+            latest = lateness;
+        }
+    }
+    if(selected < 0) {
+        return false;
+    }
+
+    taskEntry& t = tasks[selected];
+    if((uint32_t)latest > t.stats.maxLateness) {
+        t.stats.maxLateness = latest;
+    }
+    if(t.period == 0) {
+        t.enabled = false;
+    }
+    t.next += t.period;
+    if(t.period != 0 && (int32_t)(now - t.next) >= 0) {
+        uint32_t missed = (now - t.next) / t.period + 1;
+        t.stats.overruns += missed;
+        t.next += missed * t.period;
+    }
+
+    uint32_t start = micros();
+    t.function(t.context);
+    uint32_t runTime = micros() - start;
+
+    t.stats.runs++;
+    t.stats.lastRunTime = runTime;
+    t.stats.totalRunTime += runTime;
+    if(runTime > t.stats.maxRunTime) {
+        t.stats.maxRunTime = runTime;
+    }
+    return true;
+}
+
+/**
+ * @brief Runs all tasks that are due.
+ *
+ * This function is meant to be the only call in loop(). It returns when no task is due any more, so the rest of the sketch and background work of the core (e.g. WiFi) keep running.
+ */
+void BNO055Scheduler::run() {
+    while (runOnce()) {
+    }
+}
+
+/**
+ * @brief Gets the time until the next task is due.
+ *
+ * This can be used to sleep the MCU between tasks.
+ *
+ * @return The time in us, 0 if a task is due, 0xFFFFFFFF if no task is enabled.
+ */
+uint32_t BNO055Scheduler::timeToNext() {
+    uint32_t now = micros();
+    uint32_t shortest = 0xFFFFFFFF;
+    for (uint8_t i = 0; i < count; i++) {
+        if(!tasks[i].enabled) {
+            continue;
+        }
+        int32_t remaining = (int32_t)(tasks[i].next - now);
+        if(remaining <= 0) {
+            return 0;
+        }
+        if((uint32_t)remaining < shortest) {
+            shortest = remaining;
+        }
+    }
+    return shortest;
+}
+
+/**
+ * @brief Gets the statistics of a task.
+ *
+ * This function copies the number of runs, the skipped periods, the last, maximum and total run time in us and the maximum lateness in us into the provided struct.
+ *
+ * @param task The task number returned by addTask.
+ * @param stats Pointer to a taskStats struct to store the statistics.
+ */
+void BNO055Scheduler::getStats(uint8_t task, taskStats *stats) {
+    if(task < count) {
+        memcpy(stats, &tasks[task].stats, sizeof(taskStats));
+    }
+}
+
+/**
+ * @brief Resets the statistics of all tasks.
+ */
+void BNO055Scheduler::resetStats() {
+    for (uint8_t i = 0; i < count; i++) {
+        memset(&tasks[i].stats, 0, sizeof(taskStats));
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef BNO055Scheduler_h
+#define BNO055Scheduler_h
+
+#include <Arduino.h>
+
+#define SCHEDULER_MAX_TASKS 8
+
+typedef void (*taskFunction)(void* context);
+
+typedef struct {
+  uint32_t runs;
+  uint32_t overruns;
+  uint32_t lastRunTime;
+  uint32_t maxRunTime;
+  uint32_t totalRunTime;
+  uint32_t maxLateness;
+} taskStats;
+
+// Cooperative, deadline-driven task runner for acquisition, processing and output loops.
+// Each task has a period and an absolute next deadline that advances by whole periods, so
+// the rate does not drift with the run time of other tasks. Among the due tasks the one
+// with the earliest deadline runs first; a task that falls more than a period behind
+// skips the missed slots and counts them as overruns. A task with period 0 runs once and
+// disables itself. Tasks must return quickly and never call delay(). No dynamic
+// allocation.
+class BNO055Scheduler {
+  public:
+      BNO055Scheduler();
+      int8_t addTask(taskFunction function, void* context, uint32_t period, uint32_t offset = 0);
+      void setPeriod(uint8_t task, uint32_t period);
+      void setEnabled(uint8_t task, bool enabled);
+      bool runOnce();
+      void run();
+      uint32_t timeToNext();
+      void getStats(uint8_t task, taskStats *stats);
+      void resetStats();
+  private:
+      struct taskEntry {
+          taskFunction function;
+          void* context;
+          uint32_t period;
+          uint32_t next;
+          bool enabled;
+          taskStats stats;
+      };
+
+      taskEntry tasks[SCHEDULER_MAX_TASKS];
+      uint8_t count;
+};
+#endif
@@ -0,0 +1,112 @@
+#include "BNO055StateCache.h"
+#include <string.h>
+
+static_assert(sizeof(imuSnapshot) % sizeof(uint32_t) == 0, "imuSnapshot must consist of 32-bit words");
+
+#if defined(__AVR__)
+// Single core: the sequence is a byte and the writer is either the main loop or an
+// interrupt handler, so compiler barriers are sufficient.
+#define CACHE_LOAD_SEQUENCE(p) (*(volatile const cacheSequence*)(p))
+#define CACHE_STORE_SEQUENCE(p, v) (*(volatile cacheSequence*)(p) = (v))
+#define CACHE_LOAD_FLAG(p) (*(volatile const bool*)(p))
+#define CACHE_STORE_FLAG(p, v) (*(volatile bool*)(p) = (v))
+#define CACHE_LOAD_WORD(p) (*(volatile const uint32_t*)(p))
+#define CACHE_STORE_WORD(p, v) (*(volatile uint32_t*)(p) = (v))
+#define CACHE_FENCE_ACQUIRE() __asm__ __volatile__("" ::: "memory")
+#define CACHE_FENCE_RELEASE() __asm__ __volatile__("" ::: "memory")
+#else
+#define CACHE_LOAD_SEQUENCE(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define CACHE_STORE_SEQUENCE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define CACHE_LOAD_FLAG(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define CACHE_STORE_FLAG(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define CACHE_LOAD_WORD(p) __atomic_load_n(p, __ATOMIC_RELAXED)
+#define CACHE_STORE_WORD(p, v) __atomic_store_n(p, v, __ATOMIC_RELAXED)
+#define CACHE_FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define CACHE_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+/**
+ * @brief Constructor for BNO055StateCache class.
+ */
+BNO055StateCache::BNO055StateCache() {
+    sequence = 0;
+    published = false;
+    memset(data, 0, sizeof(data));
+}
+
+/**
+ * @brief Publishes a new snapshot to the readers.
+ *
+ * Only one owner may call this function. The sequence number is odd while the copy is in progress, which makes concurrent readers retry. It is only used to detect torn reads; whether anything has been published is kept in a separate flag, since the sequence wraps to 0 on AVR.
+ *
+ * @param snapshot The snapshot to publish.
+ */
+void BNO055StateCache::publish(const imuSnapshot& snapshot) {
+    uint32_t words[WORDS];
+    memcpy(words, &snapshot, sizeof(imuSnapshot));
+
+    cacheSequence next = sequence + 1;
+    CACHE_STORE_SEQUENCE(&sequence, next);
+    CACHE_FENCE_RELEASE();
+    for (uint8_t i = 0; i < WORDS; i++) {
+        CACHE_STORE_WORD(&data[i], words[i]);
+    }
+    CACHE_STORE_SEQUENCE(&sequence, (cacheSequence)(next + 1));
+    CACHE_STORE_FLAG(&published, true);
+}
+
+/**
+ * @brief Reads the latest published snapshot.
+ *
+ * This function retries until it gets a copy that was not modified by the owner while it was read.
+ *
+ * @param out Reference to an imuSnapshot struct to store the copy, left unchanged if nothing has been published yet.
+ * @return True if a snapshot has been published, false otherwise.
+ */
+bool BNO055StateCache::read(imuSnapshot& out) const {
+    if(!CACHE_LOAD_FLAG(&published)) {
+        return false;
+    }
+    while (!tryRead(out)) {
+    }
+    return true;
+}
+
+/**
+ * @brief Attempts a single read of the latest published snapshot.
+ *
+ * Unlike read() this function never spins, so it can be used from an interrupt handler that may have interrupted the owner.
+ *
+ * @param out Reference to an imuSnapshot struct to store the copy, left unchanged on failure.
+ * @return True if a consistent copy was taken, false if nothing has been published yet or the owner was publishing.
+ */
+bool BNO055StateCache::tryRead(imuSnapshot& out) const {
+    uint32_t words[WORDS];
+    if(!CACHE_LOAD_FLAG(&published)) {
+        return false;
+    }
+    cacheSequence before = CACHE_LOAD_SEQUENCE(&sequence);
+    if(before & 0x01) {
+        return false;
+    }
+    for (uint8_t i = 0; i < WORDS; i++) {
+        words[i] = CACHE_LOAD_WORD(&data[i]);
+    }
+    CACHE_FENCE_ACQUIRE();
+    if(CACHE_LOAD_SEQUENCE(&sequence) != before) {
+        return false;
+    }
+    memcpy(&out, words, sizeof(imuSnapshot));
+    return true;
+}
+
+/**
+ * @brief Gets the number of snapshots published so far.
+ *
+ * Readers can compare the version with the one of their last read to detect new data. The counter wraps at 128 on AVR.
+ *
+ * @return The publication count.
+ */
+uint32_t BNO055StateCache::getVersion() const {
+    return (uint32_t)(CACHE_LOAD_SEQUENCE(&sequence) >> 1);
+}
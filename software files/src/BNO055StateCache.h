@@ -0,0 +1,36 @@
+#ifndef BNO055StateCache_h
+#define BNO055StateCache_h
+
+#include <stdint.h>
+#include "BNO055Decode.h"
+
+#if defined(__AVR__)
+typedef uint8_t cacheSequence;    // single-byte accesses are atomic on AVR
+#else
+typedef uint32_t cacheSequence;
+#endif
+
+// Latest-state cache published through a seqlock. One acquisition owner reads the sensor
+// and calls publish(); any number of readers (tasks, threads, interrupt handlers) take a
+// consistent copy with read() without bus access and without locks: a reader retries
+// only if the owner published while it was copying. The copy is done word by word with
+// relaxed atomic loads, so the cache is also free of formal data races. No Arduino
+// dependency.
+//
+//   owner:   sensor.readSnapshot(snapshot); cache.publish(snapshot);
+//   readers: imuSnapshot state; if(cache.read(state)) { ... }
+class BNO055StateCache {
+  public:
+      BNO055StateCache();
+      void publish(const imuSnapshot& snapshot);
+      bool read(imuSnapshot& out) const;
+      bool tryRead(imuSnapshot& out) const;
+      uint32_t getVersion() const;
+  private:
+      static const uint8_t WORDS = sizeof(imuSnapshot) / sizeof(uint32_t);
+
+      cacheSequence sequence;
+      bool published;
+      uint32_t data[WORDS];
+};
+#endif
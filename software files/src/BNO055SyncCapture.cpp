@@ -0,0 +1,300 @@
+#include "BNO055SyncCapture.h"
+#include <string.h>
+
+/**
+ * @brief Constructor for BNO055SyncCapture class.
+ *
+ * @param clock Function returning the host time in us, e.g. micros.
+ */
+BNO055SyncCapture::BNO055SyncCapture(syncClockFunction clock) {
+    this->clock = clock;
+    count = 0;
+    criticalStart = SYNC_CRITICAL_START;
+    criticalSize = SYNC_CRITICAL_SIZE;
+    bulk = true;
+    reference = 0;
+    spread = 0;
+    triggerAt = 0;
+    triggered = false;
+    resetStats();
+}
+
+/**
+ * @brief Adds a sensor to the capture.
+ *
+ * The read function performs one burst read of the sensor registers starting at page 0 register reg, e.g. a wrapper around BNO055::readBytes. The sensor must already be configured and in a fusion or sensor mode.
+ *
+ * @param read Function reading length bytes starting at register reg into buffer; returns false if the transfer failed.
+ * @param context Pointer passed to read, e.g. the BNO055 object.
+ * @param unitSel Value of the UNIT_SEL register of the sensor, used to scale the decoded values.
+ * @return The index of the sensor, or -1 if SYNC_MAX_SENSORS sensors are already added.
+ */
+int8_t BNO055SyncCapture::addSensor(syncReadFunction read, void* context, uint8_t unitSel) {
+    if(count >= SYNC_MAX_SENSORS || read == NULL) {
+        return -1;
+    }
+    syncSensor& sensor = sensors[count];
+    memset(&sensor, 0, sizeof(syncSensor));
+    sensor.read = read;
+    sensor.context = context;
+    sensor.unitSel = unitSel;
+    return count++;
+}
+
+/**
+ * @brief Selects the registers read in the time-critical pass.
+ *
+ * The critical block should hold only the data that must be sampled together, since its length sets the skew between the sensors. The rest of the snapshot is read in a second pass if bulk is set, otherwise those fields keep their last values.
+ *
+ * @param criticalStart The first register of the critical block, within the snapshot registers 0x08..0x34.
+ * @param criticalSize The number of bytes of the critical block.
+ * @param bulk True to read the rest of the snapshot after the critical pass.
+ * @return True if the block lies within the snapshot registers.
+ */
+bool BNO055SyncCapture::setBlocks(uint8_t criticalStart, uint8_t criticalSize, bool bulk) {
+    if(criticalSize == 0 || criticalStart < RAW_SNAPSHOT_START ||
+       criticalStart + criticalSize > RAW_SNAPSHOT_START + RAW_SNAPSHOT_SIZE) {
+        return false;
+    }
+    this->criticalStart = criticalStart;
+    this->criticalSize = criticalSize;
+    this->bulk = bulk;
+    return true;
+}
+
+/**
+ * @brief Marks a capture as due.
+ *
+ * This function only records the time of the trigger and is safe to call from an interrupt handler, e.g. a timer or an edge of the reference sensor. The capture itself runs in the next call of poll.
+ */
+void BNO055SyncCapture::trigger() {
+    triggerAt = clock();
+    triggered = true;
+}
+
+/**
+ * @brief Runs the capture of a pending trigger.
+ *
+ * @return True if a trigger was pending and all sensors were read.
+ */
+bool BNO055SyncCapture::poll() {
+    if(!triggered) {
+        return false;
+    }
+    // a 32-bit read is not atomic on AVR: repeat until the handler did not interrupt it
+    uint32_t time;
+    do {
+        time = triggerAt;
+    } while (time != triggerAt);
+    triggered = false;
+    return capture(time);
+}
+
+/**
+ * @brief Captures all sensors now.
+ *
+ * @return True if all sensors were read.
+ */
+bool BNO055SyncCapture::capture() {
+    return capture(clock());
+}
+
+/**
+ * @brief Captures all sensors for a trigger.
+ *
+ * This function reads the critical block of every sensor back to back, then the rest of the snapshots, and decodes them. Each snapshot is stamped with the midpoint of its critical transfer; the skew is the difference to the reference time of the capture. A sensor whose critical or bulk transfer failed is marked invalid for this capture and keeps its previous snapshot.
+ *
+ * @param triggerTime The host time of the trigger in us; the delay until the first transfer is reported as latency.
+ * @return True if all sensors were read.
+ */
+bool BNO055SyncCapture::capture(uint32_t triggerTime) {
+    if(count == 0) {
+        return false;
+    }
+    uint8_t sequence[SYNC_MAX_SENSORS];
+    order(sequence);
+
+    uint32_t start = clock();
+    uint8_t valid = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        syncSensor& sensor = sensors[sequence[i]];
+        uint32_t begin = clock();
+        sensor.valid = readBlock(sensor, criticalStart, criticalSize);
+        uint32_t duration = clock() - begin;
+        sensor.midpoint = begin + duration / 2;
+        if(sensor.valid) {
+            sensor.duration = (sensor.duration == 0) ? duration << 3 : sensor.duration - (sensor.duration >> 3) + duration;
+            valid++;
+        }
+        else {
+            stats.failures++;
+        }
+    }
+
+    // reference and spread relative to the first midpoint, so the wrap of the clock does not matter
+    uint32_t first = sensors[sequence[0]].midpoint;
+    int32_t sum = 0;
+    int32_t low = 0;
+    int32_t high = 0;
+    bool found = false;
+    for (uint8_t i = 0; i < count; i++) {
+        if(!sensors[i].valid) {
+            continue;
+        }
+        int32_t offset = (int32_t)(sensors[i].midpoint - first);
+        sum += offset;
+        low = (!found || offset < low) ? offset : low;
+        high = (!found || offset > high) ? offset : high;
+        found = true;
+    }
+    reference = first + (valid > 0 ? sum / valid : 0);
+    spread = (uint32_t)(high - low);
+
+    for (uint8_t i = 0; i < count; i++) {
+        syncSensor& sensor = sensors[sequence[i]];
+        if(!sensor.valid) {
+            continue;
+        }
+        if(bulk) {
+            uint8_t end = criticalStart + criticalSize;
+            bool ok = readBlock(sensor, RAW_SNAPSHOT_START, criticalStart - RAW_SNAPSHOT_START);
+            ok = ok && readBlock(sensor, end, RAW_SNAPSHOT_START + RAW_SNAPSHOT_SIZE - end);
+            if(!ok) {
+                // the raw image now mixes fresh and stale bytes: keep the last snapshot
+                stats.failures++;
+                sensor.valid = false;
+                valid--;
+                continue;
+            }
+        }
+        BNO055Decode::decodeSnapshot(sensor.raw, sensor.unitSel, sensor.snapshot);
+        sensor.snapshot.timestamp = sensor.midpoint;
+        sensor.skew = (int32_t)(sensor.midpoint - reference);
+    }
+
+    stats.captures++;
+    stats.lastSpread = spread;
+    stats.maxSpread = spread > stats.maxSpread ? spread : stats.maxSpread;
+    stats.meanSpread += ((float)spread - stats.meanSpread) / stats.captures;
+    stats.lastLatency = start - triggerTime;
+    stats.maxLatency = stats.lastLatency > stats.maxLatency ? stats.lastLatency : stats.maxLatency;
+    return valid == count;
+}
+
+/**
+ * @brief Gets the number of sensors.
+ *
+ * @return The number of added sensors.
+ */
+uint8_t BNO055SyncCapture::getCount() {
+    return count;
+}
+
+/**
+ * @brief Gets the snapshot of a sensor from the last capture.
+ *
+ * The timestamp is the midpoint of the critical transfer in host time.
+ *
+ * @param sensor The index of the sensor.
+ * @return The decoded snapshot.
+ */
+const imuSnapshot& BNO055SyncCapture::getSnapshot(uint8_t sensor) {
+    return sensors[sensor < count ? sensor : 0].snapshot;
+}
+
+/**
+ * @brief Gets the skew of a sensor in the last capture.
+ *
+ * A positive skew means the sensor was sampled after the reference time. To bring a value to the reference time, subtract its rate of change times the skew, e.g. rotate the quaternion back by the gyro rate.
+ *
+ * @param sensor The index of the sensor.
+ * @return The skew in us.
+ */
+int32_t BNO055SyncCapture::getSkew(uint8_t sensor) {
+    return sensor < count ? sensors[sensor].skew : 0;
+}
+
+/**
+ * @brief Checks whether a sensor was read in the last capture.
+ *
+ * @param sensor The index of the sensor.
+ * @return True if the critical block and, with bulk reads, the rest of the snapshot were read.
+ */
+bool BNO055SyncCapture::isValid(uint8_t sensor) {
+    return sensor < count && sensors[sensor].valid;
+}
+
+/**
+ * @brief Gets the reference time of the last capture.
+ *
+ * @return The mean of the critical transfer midpoints in us.
+ */
+uint32_t BNO055SyncCapture::getReference() {
+    return reference;
+}
+
+/**
+ * @brief Gets the spread of the last capture.
+ *
+ * @return The time between the first and the last critical transfer midpoint in us.
+ */
+uint32_t BNO055SyncCapture::getSpread() {
+    return spread;
+}
+
+/**
+ * @brief Gets the skew statistics.
+ *
+ * @param stats Pointer to a syncStats struct to store the statistics.
+ */
+void BNO055SyncCapture::getStats(syncStats *stats) {
+    memcpy(stats, &this->stats, sizeof(syncStats));
+}
+
+/**
+ * @brief Resets the skew statistics.
+ */
+void BNO055SyncCapture::resetStats() {
+    memset(&stats, 0, sizeof(syncStats));
+}
+
+/**
+ * @brief Reads a block of snapshot registers into the raw image of a sensor.
+ *
+ * @param sensor The sensor.
+ * @param start The first register.
+ * @param size The number of bytes; nothing is read if it is 0.
+ * @return True if the transfer succeeded.
+ */
+bool BNO055SyncCapture::readBlock(syncSensor& sensor, uint8_t start, uint8_t size) {
+    if(size == 0) {
+        return true;
+    }
+    return sensor.read(sensor.context, start, sensor.raw + (start - RAW_SNAPSHOT_START), size);
+}
+
+/**
+ * @brief Orders the sensors for the critical pass.
+ *
+ * The spread of the midpoints is the total transfer time minus half of the first and half of the last transfer, so the two sensors with the longest averaged transfer go to the ends.
+ *
+ * @param sequence Array of count sensor indices to store the order.
+ */
+void BNO055SyncCapture::order(uint8_t* sequence) {
+    uint8_t sorted[SYNC_MAX_SENSORS];
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t j = i;
+        while (j > 0 && sensors[sorted[j - 1]].duration < sensors[i].duration) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = i;
+    }
+    sequence[0] = sorted[0];
+    for (uint8_t i = 2; i < count; i++) {
+        sequence[i - 1] = sorted[i];
+    }
+    if(count > 1) {
+        sequence[count - 1] = sorted[1];
+    }
+}
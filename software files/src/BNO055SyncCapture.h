@@ -0,0 +1,89 @@
+#ifndef BNO055SyncCapture_h
+#define BNO055SyncCapture_h
+
+#include <stdint.h>
+#include "BNO055Decode.h"
+
+#if defined(__AVR__)
+#define SYNC_MAX_SENSORS 4
+#else
+#define SYNC_MAX_SENSORS 8
+#endif
+
+#define SYNC_CRITICAL_START 0x20   // QUA_W_LSB: the quaternion is read first
+#define SYNC_CRITICAL_SIZE 8
+
+typedef bool (*syncReadFunction)(void* context, uint8_t reg, uint8_t* buffer, uint8_t length);
+typedef uint32_t (*syncClockFunction)();
+
+typedef struct {
+  uint32_t captures;
+  uint32_t failures;
+  uint32_t lastSpread;
+  uint32_t maxSpread;
+  float meanSpread;
+  uint32_t lastLatency;
+  uint32_t maxLatency;
+} syncStats;
+
+// Reads several sensors as close to the same instant as one blocking bus allows. On every
+// trigger (a timer tick, or an edge of one sensor chosen as reference) each capture runs
+// in two passes:
+//  - the critical block, by default the 8 quaternion bytes, is read from all sensors back
+//    to back, so the sensors are sampled within a few short transfers of each other;
+//  - the rest of the snapshot is read afterwards, split around the critical block so no
+//    byte is transferred twice.
+// The time of each critical transfer is measured; its midpoint becomes the timestamp of
+// the snapshot and its difference to the mean of all midpoints (the reference time of the
+// capture) is the skew, which downstream code can compensate with the gyro rate. Sensors
+// on slower buses take longer per transfer; the measured durations are averaged and the
+// two slowest sensors are read first and last, where their length counts only half
+// towards the spread of the midpoints. Bus access and the clock are passed in as
+// functions, so the capture runs against a simulated bus on the host. No Arduino
+// dependency.
+class BNO055SyncCapture {
+  public:
+      BNO055SyncCapture(syncClockFunction clock);
+      int8_t addSensor(syncReadFunction read, void* context, uint8_t unitSel = 0x80);
+      bool setBlocks(uint8_t criticalStart, uint8_t criticalSize, bool bulk = true);
+      void trigger();
+      bool poll();
+      bool capture();
+      bool capture(uint32_t triggerTime);
+      uint8_t getCount();
+      const imuSnapshot& getSnapshot(uint8_t sensor);
+      int32_t getSkew(uint8_t sensor);
+      bool isValid(uint8_t sensor);
+      uint32_t getReference();
+      uint32_t getSpread();
+      void getStats(syncStats *stats);
+      void resetStats();
+  private:
+      struct syncSensor {
+          syncReadFunction read;
+          void* context;
+          uint8_t unitSel;
+          uint8_t raw[RAW_SNAPSHOT_SIZE];
+          imuSnapshot snapshot;
+          uint32_t midpoint;
+          int32_t skew;
+          uint32_t duration;   // averaged critical transfer time, us * 8
+          bool valid;
+      };
+
+      bool readBlock(syncSensor& sensor, uint8_t start, uint8_t size);
+      void order(uint8_t* sequence);
+
+      syncClockFunction clock;
+      syncSensor sensors[SYNC_MAX_SENSORS];
+      uint8_t count;
+      uint8_t criticalStart;
+      uint8_t criticalSize;
+      bool bulk;
+      uint32_t reference;
+      uint32_t spread;
+      volatile uint32_t triggerAt;
+      volatile bool triggered;
+      syncStats stats;
+};
+#endif
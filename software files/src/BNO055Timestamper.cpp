@@ -0,0 +1,167 @@
+#include "BNO055Timestamper.h"
+#include <math.h>
+#include <stddef.h>
+
+#define CLOCK_LOCK_SAMPLES 16   // samples before the regression replaces the nominal period
+#define CLOCK_DEFAULT_WINDOW 256
+
+/**
+ * @brief Constructor for BNO055Timestamper class.
+ *
+ * @param nominalPeriod The nominal output period of the sensor in us, e.g. 10000 for the 100 Hz fusion output.
+ */
+BNO055Timestamper::BNO055Timestamper(uint32_t nominalPeriod) {
+    this->nominalPeriod = nominalPeriod;
+    setWindow(CLOCK_DEFAULT_WINDOW);
+    reset();
+}
+
+/**
+ * @brief Discards the clock estimate and the statistics.
+ */
+void BNO055Timestamper::reset() {
+    sumW = 0;
+    sumX = 0;
+    sumY = 0;
+    sumXX = 0;
+    sumXY = 0;
+    slope = (float)nominalPeriod;
+    intercept = 0;
+    envelope = 0;
+    jitterSq = 0;
+    lastObserved = 0;
+    lastCorrected = 0;
+    lastHash = 0;
+    samples = 0;
+    missed = 0;
+}
+
+/**
+ * @brief Sets the effective length of the regression window.
+ *
+ * Older samples are weighted down exponentially, so the estimate follows temperature drift of the oscillator. Longer windows reduce the timestamp noise, shorter windows track drift faster. With 32-bit floats windows beyond about 1000 samples lose precision.
+ *
+ * @param samples The effective number of samples in the window.
+ */
+void BNO055Timestamper::setWindow(uint16_t samples) {
+    window = (samples < 2) ? 2.0f : (float)samples;
+    forget = 1.0f - 1.0f / window;
+}
+
+/**
+ * @brief Adds the host time of a new sensor sample.
+ *
+ * The time should be taken as close to the sample as possible, e.g. micros() in the interrupt handler of a data-ready edge. Samples that were not observed are detected from the elapsed time and counted as missed.
+ *
+ * @param time The host time of the observation in us.
+ * @return The reconstructed timestamp of the sample in us.
+ */
+uint32_t BNO055Timestamper::addEdge(uint32_t time) {
+    if(samples == 0) {
+        lastObserved = time;
+        lastCorrected = time;
+        sumW = 1;
+        samples = 1;
+        return time;
+    }
+
+    float dy = (float)(uint32_t)(time - lastObserved);
+    float dx = floorf(dy / slope + 0.5f);
+    if(dx < 1) {
+        dx = 1;
+    }
+    missed += (uint32_t)dx - 1;
+
+    // residual of the new observation against the current line, before it is updated
+    float residual = dy - (intercept + slope * dx);
+    if(samples >= CLOCK_LOCK_SAMPLES) {
+        jitterSq = forget * jitterSq + (1.0f - forget) * residual * residual;
+    }
+
+    // move the origin to the new sample, then decay and add the point (0, 0)
+    sumXX += -2.0f * dx * sumX + dx * dx * sumW;
+    sumXY += -dy * sumX - dx * sumY + dx * dy * sumW;
+    sumX -= dx * sumW;
+    sumY -= dy * sumW;
+    sumW = forget * sumW + 1.0f;
+    sumX *= forget;
+    sumY *= forget;
+    sumXX *= forget;
+    sumXY *= forget;
+    samples++;
+
+    float det = sumW * sumXX - sumX * sumX;
+    if(samples >= CLOCK_LOCK_SAMPLES && det > 0) {
+        slope = (sumW * sumXY - sumX * sumY) / det;
+    }
+    intercept = (sumY - slope * sumX) / sumW;
+
+    // observation latency is never negative: follow the lower envelope of the residuals
+    envelope += sqrtf(jitterSq) / window;
+    if(residual < envelope) {
+        envelope = residual;
+    }
+
+    lastObserved = time;
+    lastCorrected = time + (int32_t)lroundf(intercept + envelope);
+    return lastCorrected;
+}
+
+/**
+ * @brief Replaces the timestamp of a snapshot with the reconstructed sample time.
+ *
+ * The snapshot timestamp is taken as the host time of the observation. This function does not rely on the data-ready interrupts (ACC_BSX_DRDY, MAG_DRDY, GYR_DRDY), which may not be wired or enabled; a new sample is detected by a change of the snapshot content. A snapshot that repeats the previous sample gets the timestamp of that sample.
+ *
+ * @param snapshot Reference to an imuSnapshot struct, its timestamp is corrected in place.
+ * @return True if the snapshot holds a new sample, false if it repeats the previous one.
+ */
+bool BNO055Timestamper::stamp(imuSnapshot& snapshot) {
+    uint32_t hash = contentHash(snapshot);
+    if(samples > 0 && hash == lastHash) {
+        snapshot.timestamp = lastCorrected;
+        return false;
+    }
+    lastHash = hash;
+    snapshot.timestamp = addEdge(snapshot.timestamp);
+    return true;
+}
+
+/**
+ * @brief Gets the reconstructed timestamp of the newest sample.
+ *
+ * @return The timestamp in us.
+ */
+uint32_t BNO055Timestamper::getTimestamp() {
+    return lastCorrected;
+}
+
+/**
+ * @brief Gets the clock statistics.
+ *
+ * This function copies the estimated output period in us, its deviation from the nominal period in ppm, the RMS jitter of the observations in us, the number of samples and missed samples, and whether the estimate has locked into the provided struct.
+ *
+ * @param stats Pointer to a clockStats struct to store the statistics.
+ */
+void BNO055Timestamper::getStats(clockStats *stats) {
+    stats->period = slope;
+    stats->driftPpm = (slope - (float)nominalPeriod) / (float)nominalPeriod * 1e6f;
+    stats->jitter = sqrtf(jitterSq);
+    stats->samples = samples;
+    stats->missed = missed;
+    stats->locked = samples >= CLOCK_LOCK_SAMPLES;
+}
+
+/**
+ * @brief Computes a FNV-1a hash over the data of a snapshot, excluding the timestamp.
+ *
+ * @param snapshot The snapshot to hash.
+ * @return The hash value.
+ */
+uint32_t BNO055Timestamper::contentHash(const imuSnapshot& snapshot) {
+    const uint8_t* bytes = (const uint8_t*)&snapshot + offsetof(imuSnapshot, acc);
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < sizeof(imuSnapshot) - offsetof(imuSnapshot, acc); i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
@@ -0,0 +1,52 @@
+#ifndef BNO055Timestamper_h
+#define BNO055Timestamper_h
+
+#include <stdint.h>
+#include "BNO055Decode.h"
+
+typedef struct {
+  float period;
+  float driftPpm;
+  float jitter;
+  uint32_t samples;
+  uint32_t missed;
+  bool locked;
+} clockStats;
+
+// Reconstructs the output clock of the sensor from host observations. Every new sample
+// (a data-ready edge captured by the application, or a snapshot whose content changed)
+// adds a point (sample index, host time) to an exponentially weighted linear regression;
+// the slope is the true output period in host time, the line gives each sample's
+// timestamp free of bus and loop latency. The sums are kept relative to the newest
+// sample so 32-bit floats are sufficient on AVR. No Arduino dependency.
+class BNO055Timestamper {
+  public:
+      BNO055Timestamper(uint32_t nominalPeriod);
+      void reset();
+      void setWindow(uint16_t samples);
+      uint32_t addEdge(uint32_t time);
+      bool stamp(imuSnapshot& snapshot);
+      uint32_t getTimestamp();
+      void getStats(clockStats *stats);
+  private:
+      uint32_t contentHash(const imuSnapshot& snapshot);
+
+      uint32_t nominalPeriod;
+      float forget;
+      float window;
+      float sumW;
+      float sumX;
+      float sumY;
+      float sumXX;
+      float sumXY;
+      float slope;
+      float intercept;
+      float envelope;
+      float jitterSq;
+      uint32_t lastObserved;
+      uint32_t lastCorrected;
+      uint32_t lastHash;
+      uint32_t samples;
+      uint32_t missed;
+};
+#endif
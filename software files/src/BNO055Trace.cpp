@@ -0,0 +1,270 @@
+#include "BNO055Trace.h"
+
+#if BNO055_ENABLE_TRACE
+#ifndef ARDUINO
+#include <time.h>
+#endif
+
+static traceEvent ring[BNO055_TRACE_SIZE];
+static uint16_t head;
+static uint16_t count;
+static uint32_t dropped;
+static bool running;
+static uint32_t counterHz;
+
+#if defined(__XTENSA__)
+static inline uint32_t readCounter() {
+    uint32_t value;
+    __asm__ __volatile__("rsr %0, ccount" : "=a"(value));
+    return value;
+}
+
+static void enableCounter() {
+}
+
+static uint32_t counterFrequency() {
+#ifdef F_CPU
+    return F_CPU;
+#else
+    return 0;
+#endif
+}
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define TRACE_DEMCR (*(volatile uint32_t*)0xE000EDFC)
+#define TRACE_DWT_CTRL (*(volatile uint32_t*)0xE0001000)
+#define TRACE_DWT_CYCCNT (*(volatile uint32_t*)0xE0001004)
+#define TRACE_DWT_LAR (*(volatile uint32_t*)0xE0001FB0)
+
+static inline uint32_t readCounter() {
+    return TRACE_DWT_CYCCNT;
+}
+
+// TRCENA in DEMCR powers the DWT; the lock access register only exists on some cores (M7)
+static void enableCounter() {
+    TRACE_DEMCR |= 0x01000000;
+    TRACE_DWT_LAR = 0xC5ACCE55;
+    TRACE_DWT_CYCCNT = 0;
+    TRACE_DWT_CTRL |= 0x00000001;
+}
+
+static uint32_t counterFrequency() {
+#ifdef F_CPU
+    return F_CPU;
+#else
+    return 0;
+#endif
+}
+#elif !defined(ARDUINO) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+
+static uint64_t startTicks;
+static uint64_t startNanos;
+
+static uint64_t monotonicNanos() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static inline uint32_t readCounter() {
+    return (uint32_t)__rdtsc();
+}
+
+static void enableCounter() {
+    startTicks = __rdtsc();
+    startNanos = monotonicNanos();
+}
+
+// TSC rate measured against CLOCK_MONOTONIC since start()
+static uint32_t counterFrequency() {
+    uint64_t nanos = monotonicNanos() - startNanos;
+    if(nanos < 1000000) {
+        return 0;
+    }
+    return (uint32_t)((__rdtsc() - startTicks) * 1000000000.0 / nanos);
+}
+#elif !defined(ARDUINO)
+static inline uint32_t readCounter() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec);
+}
+
+static void enableCounter() {
+}
+
+static uint32_t counterFrequency() {
+    return 1000000000;
+}
+#else
+static inline uint32_t readCounter() {
+    return micros();
+}
+
+static void enableCounter() {
+}
+
+static uint32_t counterFrequency() {
+    return 1000000;
+}
+#endif
+
+namespace BNO055Trace {
+
+/**
+ * @brief Enables the cycle counter and starts recording.
+ *
+ * The ring is cleared.
+ */
+void start() {
+    enableCounter();
+    clear();
+    running = true;
+}
+
+/**
+ * @brief Stops recording; the recorded events are kept.
+ */
+void stop() {
+    running = false;
+}
+
+/**
+ * @brief Checks whether events are recorded.
+ *
+ * @return True between start() and stop().
+ */
+bool isRunning() {
+    return running;
+}
+
+/**
+ * @brief Discards all recorded events and the dropped count.
+ */
+void clear() {
+    head = 0;
+    count = 0;
+    dropped = 0;
+}
+
+/**
+ * @brief Records one event.
+ *
+ * When the ring is full the oldest event is overwritten and counted as dropped.
+ *
+ * @param point The tracepoint id, a TracePoint value or TRACE_USER and above.
+ * @param phase TRACE_PHASE_BEGIN or TRACE_PHASE_END.
+ */
+void record(uint8_t point, uint8_t phase) {
+    if(!running) {
+        return;
+    }
+    uint32_t now = readCounter();
+    uint16_t slot = head + count;
+    if(slot >= BNO055_TRACE_SIZE) {
+        slot -= BNO055_TRACE_SIZE;
+    }
+    if(count == BNO055_TRACE_SIZE) {
+        head = head + 1 < BNO055_TRACE_SIZE ? head + 1 : 0;
+        dropped++;
+    }
+    else {
+        count++;
+    }
+    ring[slot].cycles = now;
+    ring[slot].point = point;
+    ring[slot].phase = phase;
+}
+
+/**
+ * @brief Reads the trace counter.
+ *
+ * @return The current counter value.
+ */
+uint32_t cycles() {
+    return readCounter();
+}
+
+/**
+ * @brief Gets the rate of the trace counter.
+ *
+ * On x86 hosts the TSC rate is measured since start(). Where the core clock is unknown (no F_CPU) set it with setFrequency().
+ *
+ * @return The counter rate in Hz, 0 if unknown.
+ */
+uint32_t frequency() {
+    return counterHz != 0 ? counterHz : counterFrequency();
+}
+
+/**
+ * @brief Overrides the rate of the trace counter, e.g. with SystemCoreClock.
+ *
+ * @param hz The counter rate in Hz, 0 to use the built-in value.
+ */
+void setFrequency(uint32_t hz) {
+    counterHz = hz;
+}
+
+/**
+ * @brief Gets the number of recorded events.
+ *
+ * @return The number of events in the ring.
+ */
+uint16_t available() {
+    return count;
+}
+
+/**
+ * @brief Removes the oldest events from the ring.
+ *
+ * @param events Array to store the events, oldest first.
+ * @param max The size of the array.
+ * @return The number of events stored.
+ */
+uint16_t drain(traceEvent* events, uint16_t max) {
+    uint16_t n = 0;
+    while (n < max && count > 0) {
+        events[n++] = ring[head];
+        head = head + 1 < BNO055_TRACE_SIZE ? head + 1 : 0;
+        count--;
+    }
+    return n;
+}
+
+/**
+ * @brief Gets the number of events overwritten since the last clear().
+ *
+ * @return The number of dropped events.
+ */
+uint32_t getDropped() {
+    return dropped;
+}
+
+#ifdef ARDUINO
+/**
+ * @brief Prints and removes all recorded events.
+ *
+ * The first line is "# BNO055 trace <counter Hz> <dropped>", followed by one "<counter> <B|E> <tracepoint id>" line per event, oldest first. Recording is paused while printing.
+ *
+ * @param out The stream to print to, e.g. Serial.
+ */
+void dump(Print& out) {
+    bool wasRunning = running;
+    running = false;
+    out.print("# BNO055 trace ");
+    out.print((unsigned long)frequency());
+    out.print(" ");
+    out.println((unsigned long)dropped);
+    traceEvent event;
+    while (drain(&event, 1) == 1) {
+        out.print((unsigned long)event.cycles);
+        out.print(event.phase == TRACE_PHASE_BEGIN ? " B " : " E ");
+        out.println((unsigned int)event.point);
+    }
+    dropped = 0;
+    running = wasRunning;
+}
+#endif
+
+}
+#endif
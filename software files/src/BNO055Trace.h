@@ -0,0 +1,170 @@
+#ifndef BNO055Trace_h
+#define BNO055Trace_h
+
+#include <stdint.h>
+#include "BNO055Config.h"
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+// Tracepoints of the driver: every transport operation and public API function records
+// an entry and an exit event. Ids are the position in the lists, transport first, and
+// are stable within a release; ids from TRACE_USER up are free for application code.
+#define BNO055_TRACE_TRANSPORT(X) \
+  X(WRITE_BYTE, "writeByte") \
+  X(WRITE_BYTES, "writeBytes") \
+  X(READ_BYTE, "readByte") \
+  X(READ_BYTES, "readBytes") \
+  X(WRITE_BYTE_UART, "writeByteUART") \
+  X(READ_BYTE_UART, "readByteUART") \
+  X(SELECT_PAGE, "selectPage") \
+  X(FAST_READ, "fastRead") \
+  X(READ_FIELD, "readField") \
+  X(WRITE_FIELDS, "writeFields")
+
+#define BNO055_TRACE_API(X) \
+  X(BEGIN, "begin") \
+  X(WARM_START, "warmStart") \
+  X(RESET, "reset") \
+  X(IS_READY, "isReady") \
+  X(SET_POWER_MODE, "setPowerMode") \
+  X(SET_OPERATION_MODE, "setOperationMode") \
+  X(GET_MODE, "getMode") \
+  X(IS_MODE_READY, "isModeReady") \
+  X(WAIT_MODE_READY, "waitModeReady") \
+  X(GET_POWER_MODE, "getPowerMode") \
+  X(SET_PAGE, "setPage") \
+  X(GET_PAGE, "getPage") \
+  X(INTERRUPT_RESET, "interruptReset") \
+  X(INTERRUPT_MASK, "interruptMask") \
+  X(INTERRUPT_ENABLE, "interruptEnable") \
+  X(INTERRUPT_DISABLE, "interruptDisable") \
+  X(ACC_AM_THRESH, "accAMThresh") \
+  X(ACC_INT_SETTINGS, "accIntSettings") \
+  X(ACC_HG_SETTINGS, "accHGSettings") \
+  X(ACC_HG_THRESH, "accHGThresh") \
+  X(ACC_NM_THRESH, "accNMThresh") \
+  X(ACC_NM_SET, "accNMSet") \
+  X(GYR_INT_SETTINGS, "gyrIntSettings") \
+  X(GYR_HR_X_SET, "gyrHrXSet") \
+  X(GYR_DURATION_X, "gyrDurationX") \
+  X(GYR_HR_Y_SET, "gyrHrYSet") \
+  X(GYR_DURATION_Y, "gyrDurationY") \
+  X(GYR_HR_Z_SET, "gyrHrZSet") \
+  X(GYR_DURATION_Z, "gyrDurationZ") \
+  X(GYR_AM_THRESH, "gyrAmThresh") \
+  X(GYR_AM_SET, "gyrAmSet") \
+  X(SET_UNIT, "setUnit") \
+  X(SET_ACC_CONFIG, "setAccConfig") \
+  X(SET_GYRO_CONFIG, "setGyroConfig") \
+  X(SET_MAG_CONFIG, "setMagConfig") \
+  X(SET_ACC_SLEEP_CONFIG, "setAccSleepConfig") \
+  X(SET_GYR_SLEEP_CONFIG, "setGyrSleepConfig") \
+  X(ACC_OFFSET_X, "accOffsetX") \
+  X(ACC_OFFSET_Y, "accOffsetY") \
+  X(ACC_OFFSET_Z, "accOffsetZ") \
+  X(MAG_OFFSET_X, "magOffsetX") \
+  X(MAG_OFFSET_Y, "magOffsetY") \
+  X(MAG_OFFSET_Z, "magOffsetZ") \
+  X(GYR_OFFSET_X, "gyrOffsetX") \
+  X(GYR_OFFSET_Y, "gyrOffsetY") \
+  X(GYR_OFFSET_Z, "gyrOffsetZ") \
+  X(SET_CALIBRATION_OFFSETS, "setCalibrationOffsets") \
+  X(GET_CALIBRATION_OFFSETS, "getCalibrationOffsets") \
+  X(SET_INTERRUPT_CONFIG, "setInterruptConfig") \
+  X(GET_INTERRUPT_CONFIG, "getInterruptConfig") \
+  X(SET_AXIS_REMAP, "setAxisRemap") \
+  X(SET_AXIS_SIGN, "setAxisSign") \
+  X(SET_AXIS_PLACEMENT, "setAxisPlacement") \
+  X(GET_REV_INFO, "getrevInfo") \
+  X(READ_CONFIG_IMAGE, "readConfigImage") \
+  X(GET_CONFIG_HASH, "getConfigHash") \
+  X(GET_ACCELERATION, "getAcceleration") \
+  X(GET_GRAVITY, "getGravity") \
+  X(GET_LINEAR_ACCELERATION, "getLinearAcceleration") \
+  X(GET_EULER_ANGLES, "getEulerAngles") \
+  X(GET_QUATERNIONS, "getQuaternions") \
+  X(GET_MAGNETOMETER, "getMagnetometer") \
+  X(GET_GYROSCOPE, "getGyroscope") \
+  X(GET_TEMPERATURE, "getTemperature") \
+  X(GET_QUATERNION_ACCURACY, "getQuaternionAccuracy") \
+  X(GET_ANGULAR_VELOCITY, "getAngularVelocity") \
+  X(READ_SNAPSHOT, "readSnapshot") \
+  X(READ_RAW_VECTOR, "readRawVector") \
+  X(READ_RAW_SNAPSHOT, "readRawSnapshot") \
+  X(GET_CALIBRATION_STATUS, "getCalibrationStatus") \
+  X(IS_FULLY_CALIBRATED, "isFullyCalibrated") \
+  X(READ_HEALTH, "readHealth") \
+  X(GET_SYSTEM_STATUS, "getSystemStatus") \
+  X(DUMP_REGISTERS, "dumpRegisters") \
+  X(RESTORE_REGISTERS, "restoreRegisters")
+
+enum TracePoint {
+#define BNO055_TRACE_ENUM(id, name) TRACE_##id,
+  BNO055_TRACE_TRANSPORT(BNO055_TRACE_ENUM)
+  BNO055_TRACE_API(BNO055_TRACE_ENUM)
+#undef BNO055_TRACE_ENUM
+  TRACE_POINT_COUNT,
+  TRACE_USER = 0xC0
+};
+
+enum TracePhase {
+  TRACE_PHASE_BEGIN = 0x00,
+  TRACE_PHASE_END = 0x01
+};
+
+typedef struct {
+  uint32_t cycles;
+  uint8_t point;
+  uint8_t phase;
+} traceEvent;
+
+// Compile-time tracepoints with cycle-count timestamps. With BNO055_ENABLE_TRACE=0 (the
+// default) BNO055_TRACE_SCOPE and the BEGIN/END macros expand to nothing and
+// BNO055Trace.cpp is empty. Enabled, each event stores the 32-bit cycle counter, the
+// tracepoint id and the phase in a ring of BNO055_TRACE_SIZE events that overwrites the
+// oldest; the counter is DWT CYCCNT on Cortex-M3/M4/M7/M33, CCOUNT on Xtensa, rdtsc on
+// x86, CLOCK_MONOTONIC ns on other Linux hosts and micros() elsewhere (AVR, Cortex-M0).
+// The counter wraps (e.g. after 17 s at 240 MHz); the converter assumes consecutive
+// events are less than one wrap apart. dump() prints the ring as text, which
+// extras/tools/trace_to_chrome turns into a Chrome trace (chrome://tracing, Perfetto).
+// Recording is not interrupt-safe: tracepoints hit from an ISR may lose an event.
+namespace BNO055Trace {
+
+void start();
+void stop();
+bool isRunning();
+void clear();
+void record(uint8_t point, uint8_t phase);
+uint32_t cycles();
+uint32_t frequency();
+void setFrequency(uint32_t hz);
+uint16_t available();
+uint16_t drain(traceEvent* events, uint16_t max);
+uint32_t getDropped();
+#ifdef ARDUINO
+void dump(Print& out);
+#endif
+
+}
+
+#if BNO055_ENABLE_TRACE
+struct BNO055TraceScope {
+    uint8_t point;
+    BNO055TraceScope(uint8_t point) : point(point) {
+        BNO055Trace::record(point, TRACE_PHASE_BEGIN);
+    }
+    ~BNO055TraceScope() {
+        BNO055Trace::record(point, TRACE_PHASE_END);
+    }
+};
+#define BNO055_TRACE_SCOPE(point) BNO055TraceScope traceScope(point)
+#define BNO055_TRACE_BEGIN(point) BNO055Trace::record(point, TRACE_PHASE_BEGIN)
+#define BNO055_TRACE_END(point) BNO055Trace::record(point, TRACE_PHASE_END)
+#else
+#define BNO055_TRACE_SCOPE(point) do {} while(0)
+#define BNO055_TRACE_BEGIN(point) do {} while(0)
+#define BNO055_TRACE_END(point) do {} while(0)
+#endif
+
+#endif
@@ -0,0 +1,348 @@
+#ifndef BNO055WindowStats_h
+#define BNO055WindowStats_h
+
+#include <stdint.h>
+#include <math.h>
+#include "BNO055Decode.h"
+
+#define WINDOW_STATS_RESYNC 16   // full windows between exact recomputations of mean and variance
+#define WINDOW_STATS_DROP 1024.0f // fall of M2 below its peak that forces an early recomputation
+
+typedef struct {
+  float mean;
+  float variance;
+  float rms;
+  float min;
+  float max;
+} windowStats;
+
+// Sliding-window statistics over the last Window samples of a fixed set of snapshot
+// channels, e.g. { CHANNEL_ACC_X, CHANNEL_ACC_Y, CHANNEL_ACC_Z }. Every sample costs O(1)
+// per channel regardless of the window length:
+//  - mean and variance are updated with the sliding form of Welford's method, which adds
+//    the new sample and removes the one leaving the window in one step. Rounding errors
+//    would accumulate over a long stream, and after a burst leaves the window the
+//    remaining M2 is a small difference of large sums, so both are recomputed from the
+//    window every WINDOW_STATS_RESYNC windows or as soon as M2 has fallen
+//    WINDOW_STATS_DROP times below its peak, at most once per window (amortised O(1)). They
+//    run on the samples minus a per-channel reference (the first sample, then the mean at
+//    each recomputation), so a small variance on a large offset such as gravity keeps its
+//    float precision;
+//  - RMS follows from them as sqrt(variance + mean²);
+//  - min and max come from monotonic deques of window slots, in which every sample is
+//    pushed and popped at most once.
+// State is laid out as structure of arrays: the window holds one row of all channels per
+// sample and mean/M2 are arrays over the channels, so the per-sample loops run over
+// contiguous floats and vectorise on the host. Memory is
+// Window * Channels * (4 + 2 * 2) bytes plus a few per channel, all fixed at compile time.
+// Euler angles are treated linearly, across the heading wrap too. No Arduino dependency.
+template<uint8_t Channels, uint16_t Window>
+class BNO055WindowStats {
+  static_assert(Channels > 0 && Window > 1 && Window <= 32768, "at least one channel and a window of 2..32768 samples");
+
+  public:
+      BNO055WindowStats(const uint8_t* channels);
+      void reset();
+      void update(const imuSnapshot& snapshot);
+      void push(const float* values);
+      uint16_t getCount();
+      bool isFull();
+      float getMean(uint8_t index);
+      float getVariance(uint8_t index);
+      float getRms(uint8_t index);
+      float getMin(uint8_t index);
+      float getMax(uint8_t index);
+      float getTotalVariance();
+      void getWindow(uint8_t index, windowStats *stats);
+  private:
+      void resync();
+      uint16_t wrap(uint16_t position);
+
+      uint8_t channels[Channels];
+      float window[Window][Channels];
+      float shift[Channels];
+      float mean[Channels];
+      float m2[Channels];
+      float peak[Channels];
+      uint16_t minQueue[Channels][Window];
+      uint16_t maxQueue[Channels][Window];
+      uint16_t minHead[Channels];
+      uint16_t minSize[Channels];
+      uint16_t maxHead[Channels];
+      uint16_t maxSize[Channels];
+      uint16_t slot;
+      uint16_t count;
+      uint32_t since;
+};
+
+/**
+ * @brief Constructor for BNO055WindowStats class.
+ *
+ * @param channels Array of Channels SnapshotChannel values; statistics are queried by their index in this array.
+ */
+template<uint8_t Channels, uint16_t Window>
+BNO055WindowStats<Channels, Window>::BNO055WindowStats(const uint8_t* channels) {
+    for (uint8_t c = 0; c < Channels; c++) {
+        this->channels[c] = channels[c] < CHANNEL_COUNT ? channels[c] : (uint8_t)CHANNEL_TEMP;
+    }
+    reset();
+}
+
+/**
+ * @brief Empties the window.
+ */
+template<uint8_t Channels, uint16_t Window>
+void BNO055WindowStats<Channels, Window>::reset() {
+    slot = 0;
+    count = 0;
+    since = 0;
+    for (uint8_t c = 0; c < Channels; c++) {
+        shift[c] = 0;
+        mean[c] = 0;
+        m2[c] = 0;
+        peak[c] = 0;
+        minHead[c] = 0;
+        minSize[c] = 0;
+        maxHead[c] = 0;
+        maxSize[c] = 0;
+    }
+}
+
+/**
+ * @brief Adds the configured channels of a snapshot to the window.
+ *
+ * @param snapshot The decoded snapshot.
+ */
+template<uint8_t Channels, uint16_t Window>
+void BNO055WindowStats<Channels, Window>::update(const imuSnapshot& snapshot) {
+    float values[Channels];
+    for (uint8_t c = 0; c < Channels; c++) {
+        values[c] = BNO055Decode::channelValue(snapshot, channels[c]);
+    }
+    push(values);
+}
+
+/**
+ * @brief Adds one sample of every channel to the window, dropping the oldest once it is full.
+ *
+ * @param values Array of Channels values in the order of the configured channels.
+ */
+template<uint8_t Channels, uint16_t Window>
+void BNO055WindowStats<Channels, Window>::push(const float* values) {
+    float* row = window[slot];
+    if(count < Window) {
+        if(count == 0) {
+            for (uint8_t c = 0; c < Channels; c++) {
+                shift[c] = values[c];
+            }
+        }
+        count++;
+        const float inverse = 1.0f / count;
+        for (uint8_t c = 0; c < Channels; c++) {
+            float x = values[c] - shift[c];
+            float delta = x - mean[c];
+            mean[c] += delta * inverse;
+            m2[c] += delta * (x - mean[c]);
+        }
+    }
+    else {
+        const float inverse = 1.0f / Window;
+        for (uint8_t c = 0; c < Channels; c++) {
+            float x = values[c] - shift[c];
+            float old = row[c] - shift[c];
+            float updated = mean[c] + (x - old) * inverse;
+            m2[c] += (x - old) * (x - updated + old - mean[c]);
+            mean[c] = updated;
+        }
+        // the sample in this slot leaves the window; it can only be at the front of a deque
+        for (uint8_t c = 0; c < Channels; c++) {
+            if(minSize[c] > 0 && minQueue[c][minHead[c]] == slot) {
+                minHead[c] = wrap(minHead[c] + 1);
+                minSize[c]--;
+            }
+            if(maxSize[c] > 0 && maxQueue[c][maxHead[c]] == slot) {
+                maxHead[c] = wrap(maxHead[c] + 1);
+                maxSize[c]--;
+            }
+        }
+    }
+
+    for (uint8_t c = 0; c < Channels; c++) {
+        float x = values[c];
+        row[c] = x;
+        while (minSize[c] > 0 && window[minQueue[c][wrap(minHead[c] + minSize[c] - 1)]][c] >= x) {
+            minSize[c]--;
+        }
+        minQueue[c][wrap(minHead[c] + minSize[c])] = slot;
+        minSize[c]++;
+        while (maxSize[c] > 0 && window[maxQueue[c][wrap(maxHead[c] + maxSize[c] - 1)]][c] <= x) {
+            maxSize[c]--;
+        }
+        maxQueue[c][wrap(maxHead[c] + maxSize[c])] = slot;
+        maxSize[c]++;
+    }
+
+    slot = wrap(slot + 1);
+    if(count == Window) {
+        since++;
+        bool dropped = false;
+        for (uint8_t c = 0; c < Channels; c++) {
+            peak[c] = m2[c] > peak[c] ? m2[c] : peak[c];
+            dropped = dropped || m2[c] * WINDOW_STATS_DROP < peak[c];
+        }
+        if(since >= Window && (dropped || since >= (uint32_t)Window * WINDOW_STATS_RESYNC)) {
+            resync();
+        }
+    }
+}
+
+/**
+ * @brief Gets the number of samples in the window.
+ *
+ * @return The number of samples, at most Window.
+ */
+template<uint8_t Channels, uint16_t Window>
+uint16_t BNO055WindowStats<Channels, Window>::getCount() {
+    return count;
+}
+
+/**
+ * @brief Checks whether the window holds Window samples.
+ *
+ * @return True if the window is full.
+ */
+template<uint8_t Channels, uint16_t Window>
+bool BNO055WindowStats<Channels, Window>::isFull() {
+    return count == Window;
+}
+
+/**
+ * @brief Gets the mean of a channel over the window.
+ *
+ * @param index The index of the channel in the configured channels.
+ * @return The mean, 0 if the window is empty.
+ */
+template<uint8_t Channels, uint16_t Window>
+float BNO055WindowStats<Channels, Window>::getMean(uint8_t index) {
+    return count > 0 ? shift[index] + mean[index] : 0;
+}
+
+/**
+ * @brief Gets the variance of a channel over the window.
+ *
+ * @param index The index of the channel in the configured channels.
+ * @return The population variance (divided by the number of samples), 0 if the window is empty.
+ */
+template<uint8_t Channels, uint16_t Window>
+float BNO055WindowStats<Channels, Window>::getVariance(uint8_t index) {
+    return (count > 0 && m2[index] > 0) ? m2[index] / count : 0;
+}
+
+/**
+ * @brief Gets the root mean square of a channel over the window.
+ *
+ * @param index The index of the channel in the configured channels.
+ * @return The RMS value, 0 if the window is empty.
+ */
+template<uint8_t Channels, uint16_t Window>
+float BNO055WindowStats<Channels, Window>::getRms(uint8_t index) {
+    float average = getMean(index);
+    return sqrtf(getVariance(index) + average * average);
+}
+
+/**
+ * @brief Gets the minimum of a channel over the window.
+ *
+ * @param index The index of the channel in the configured channels.
+ * @return The minimum, 0 if the window is empty.
+ */
+template<uint8_t Channels, uint16_t Window>
+float BNO055WindowStats<Channels, Window>::getMin(uint8_t index) {
+    return minSize[index] > 0 ? window[minQueue[index][minHead[index]]][index] : 0;
+}
+
+/**
+ * @brief Gets the maximum of a channel over the window.
+ *
+ * @param index The index of the channel in the configured channels.
+ * @return The maximum, 0 if the window is empty.
+ */
+template<uint8_t Channels, uint16_t Window>
+float BNO055WindowStats<Channels, Window>::getMax(uint8_t index) {
+    return maxSize[index] > 0 ? window[maxQueue[index][maxHead[index]]][index] : 0;
+}
+
+/**
+ * @brief Gets the sum of the variances of all channels.
+ *
+ * For the three axes of a vector this is the variance of the vector, the usual stillness measure.
+ *
+ * @return The total variance.
+ */
+template<uint8_t Channels, uint16_t Window>
+float BNO055WindowStats<Channels, Window>::getTotalVariance() {
+    float total = 0;
+    for (uint8_t c = 0; c < Channels; c++) {
+        total += getVariance(c);
+    }
+    return total;
+}
+
+/**
+ * @brief Gets all statistics of a channel.
+ *
+ * @param index The index of the channel in the configured channels.
+ * @param stats Pointer to a windowStats struct to store the statistics.
+ */
+template<uint8_t Channels, uint16_t Window>
+void BNO055WindowStats<Channels, Window>::getWindow(uint8_t index, windowStats *stats) {
+    stats->mean = getMean(index);
+    stats->variance = getVariance(index);
+    stats->rms = getRms(index);
+    stats->min = getMin(index);
+    stats->max = getMax(index);
+}
+
+/**
+ * @brief Recomputes mean and M2 of every channel from the full window and moves the reference to the mean.
+ */
+template<uint8_t Channels, uint16_t Window>
+void BNO055WindowStats<Channels, Window>::resync() {
+    since = 0;
+    float sum[Channels] = { 0 };
+    for (uint16_t i = 0; i < Window; i++) {
+        for (uint8_t c = 0; c < Channels; c++) {
+            sum[c] += window[i][c] - shift[c];
+        }
+    }
+    for (uint8_t c = 0; c < Channels; c++) {
+        shift[c] += sum[c] / Window;
+        mean[c] = 0;
+        m2[c] = 0;
+    }
+    for (uint16_t i = 0; i < Window; i++) {
+        for (uint8_t c = 0; c < Channels; c++) {
+            float delta = window[i][c] - shift[c];
+            mean[c] += delta;
+            m2[c] += delta * delta;
+        }
+    }
+    // the float rounding of the new reference leaves a small remainder in the mean
+    for (uint8_t c = 0; c < Channels; c++) {
+        mean[c] /= Window;
+        m2[c] -= Window * mean[c] * mean[c];
+        peak[c] = m2[c];
+    }
+}
+
+/**
+ * @brief Wraps a window position.
+ *
+ * @param position A position below 2 * Window.
+ * @return The position modulo Window.
+ */
+template<uint8_t Channels, uint16_t Window>
+uint16_t BNO055WindowStats<Channels, Window>::wrap(uint16_t position) {
+    return position >= Window ? position - Window : position;
+}
+#endif
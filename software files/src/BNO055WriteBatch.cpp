@@ -0,0 +1,108 @@
+#include "BNO055WriteBatch.h"
+
+/**
+ * @brief Constructor for BNO055WriteBatch class.
+ * 
+ * Creates an empty batch covering WRITE_BATCH_SIZE consecutive registers starting at base on the given page.
+ * 
+ * @param sensor Reference to the BNO055 sensor the batch is written to.
+ * @param page The register page of the batch.
+ * @param base The first register address covered by the batch.
+ */
+BNO055WriteBatch::BNO055WriteBatch(BNO055& sensor, uint8_t page, uint8_t base) : sensor(sensor) {
+    this->page = page;
+    this->base = base;
+    dirty = 0;
+}
+
+/**
+ * @brief Stages a register value for the next flush.
+ * 
+ * This function records the value and marks the register dirty. Staging the same register again overwrites the previous value.
+ * 
+ * @param reg The register address to write.
+ * @param value The value to write.
+ * @return True if the register is covered by the batch, false otherwise.
+ */
+bool BNO055WriteBatch::stage(uint8_t reg, uint8_t value) {
+    if(reg < base || reg - base >= WRITE_BATCH_SIZE) {
+        return false;
+    }
+    values[reg - base] = value;
+    dirty |= (uint32_t)1 << (reg - base);
+    return true;
+}
+
+/**
+ * @brief Stages a 16-bit register pair for the next flush.
+ * 
+ * @param reg The address of the LSB register, the MSB is written to reg + 1.
+ * @param value The value to write.
+ * @return True if both registers are covered by the batch, false otherwise.
+ */
+bool BNO055WriteBatch::stage16(uint8_t reg, uint16_t value) {
+    if(reg < base || reg - base + 1 >= WRITE_BATCH_SIZE) {
+        return false;
+    }
+    stage(reg, (uint8_t)(value & 0x00FF));
+    return stage(reg + 1, (uint8_t)(value >> 8));
+}
+
+/**
+ * @brief Checks if a register is staged for the next flush.
+ * 
+ * @param reg The register address to check.
+ * @return True if the register is dirty, false otherwise.
+ */
+bool BNO055WriteBatch::isDirty(uint8_t reg) {
+    if(reg < base || reg - base >= WRITE_BATCH_SIZE) {
+        return false;
+    }
+    return (dirty >> (reg - base)) & 0x01;
+}
+
+/**
+ * @brief Writes all staged registers to the sensor.
+ * 
+ * This function groups runs of consecutive dirty registers and writes each run with a single writeBytes call, after selecting the batch page once. Registers of runs that were written are cleared; those of failed runs stay dirty, so the next flush retries them.
+ * 
+ * @param bursts Optional pointer to store the number of burst writes issued.
+ * @return True if all staged registers were written, false otherwise.
+ */
+bool BNO055WriteBatch::flush(uint8_t* bursts) {
+    if(bursts != NULL) {
+        *bursts = 0;
+    }
+    if(dirty == 0) {
+        return true;
+    }
+
+    sensor.setPage(page);
+    uint8_t i = 0;
+    while(i < WRITE_BATCH_SIZE) {
+        if(!((dirty >> i) & 0x01)) {
+            i++;
+            continue;
+        }
+        uint8_t start = i;
+        while(i < WRITE_BATCH_SIZE && ((dirty >> i) & 0x01)) {
+            i++;
+        }
+        if(sensor.writeBytes(base + start, &values[start], i - start)) {
+            for (uint8_t j = start; j < i; j++) {
+                dirty &= ~((uint32_t)1 << j);
+            }
+        }
+        if(bursts != NULL) {
+            (*bursts)++;
+        }
+    }
+    return dirty == 0;
+}
+
+/**
+ * @brief Discards all staged registers.
+ */
+void BNO055WriteBatch::clear() {
+    dirty = 0;
+}
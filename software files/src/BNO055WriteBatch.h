@@ -0,0 +1,24 @@
+#ifndef BNO055WriteBatch_h
+#define BNO055WriteBatch_h
+
+#include <Arduino.h>
+#include "BNO055.h"
+
+#define WRITE_BATCH_SIZE 32
+
+class BNO055WriteBatch {
+  public:
+      BNO055WriteBatch(BNO055& sensor, uint8_t page, uint8_t base);
+      bool stage(uint8_t reg, uint8_t value);
+      bool stage16(uint8_t reg, uint16_t value);
+      bool isDirty(uint8_t reg);
+      bool flush(uint8_t* bursts = NULL);
+      void clear();
+  private:
+      BNO055& sensor;
+      uint8_t page;
+      uint8_t base;
+      uint32_t dirty;
+      uint8_t values[WRITE_BATCH_SIZE];
+};
+#endif